@@ -17,9 +17,11 @@
 #ifndef CACHE_H
 #define CACHE_H
 
+#include <deque>
 #include <functional>
 #include <list>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "champsim.h"
@@ -33,6 +35,97 @@
 // virtual address space prefetching
 #define VA_PREFETCH_TRANSLATION_LATENCY 2
 
+/** @brief
+ *  Miss status holding registers kept in a fixed pool of slots.
+ *  The index maps the block address of each entry to its slot, thus merging a miss into an inflight one
+ *  and matching returned data don't scan the MSHR. The entries whose data returned are filled in the
+ *  order they returned, which is recorded in fill_order.
+ */
+class MSHR_POOL
+{
+public:
+  MSHR_POOL(std::size_t size, std::size_t offset_bits) : entries(size), in_use(size, false), shamt(offset_bits)
+  {
+    free_slots.reserve(size);
+    for (std::size_t slot = size; slot > 0; slot--)
+      free_slots.push_back(slot - 1);
+
+    index.reserve(size);
+  }
+
+  std::size_t size() const { return entries.size() - free_slots.size(); }
+  bool empty() const { return free_slots.size() == entries.size(); }
+  bool full() const { return free_slots.empty(); }
+
+  // number of entries holding a valid address
+  std::size_t occupancy() const { return index.size(); }
+
+  // return the entry of the cache line of this address, nullptr if the line is not inflight.
+  PACKET* find(uint64_t address)
+  {
+    auto found = index.find(address >> shamt);
+    return (found == index.end()) ? nullptr : &entries[found->second];
+  }
+
+  // copy the packet into a free slot, the caller makes sure the MSHR is not full.
+  PACKET* allocate(const PACKET& packet)
+  {
+    assert(!full());
+    std::size_t slot = free_slots.back();
+    free_slots.pop_back();
+
+    entries[slot] = packet;
+    in_use[slot] = true;
+    if (is_valid<PACKET>()(packet))
+      index[packet.address >> shamt] = slot;
+
+    return &entries[slot];
+  }
+
+  // free an entry whose data hasn't returned yet.
+  void release(PACKET* entry) { release_slot(std::distance(entries.data(), entry)); }
+
+  // the data of this entry returned, it is filled after the entries returned before it.
+  void mark_returned(PACKET* entry) { fill_order.push_back(std::distance(entries.data(), entry)); }
+
+  // the next entry to fill, nullptr if no data has returned.
+  PACKET* next_fill() { return fill_order.empty() ? nullptr : &entries[fill_order.front()]; }
+
+  void pop_fill()
+  {
+    release_slot(fill_order.front());
+    fill_order.pop_front();
+  }
+
+  template <typename F>
+  void for_each(F&& func)
+  {
+    for (std::size_t slot = 0; slot < entries.size(); slot++)
+      if (in_use[slot])
+        func(slot, entries[slot]);
+  }
+
+private:
+  void release_slot(std::size_t slot)
+  {
+    assert(in_use[slot]);
+    auto found = index.find(entries[slot].address >> shamt);
+    if (found != index.end() && found->second == slot)
+      index.erase(found);
+
+    entries[slot] = PACKET();
+    in_use[slot] = false;
+    free_slots.push_back(slot);
+  }
+
+  std::vector<PACKET> entries;
+  std::vector<bool> in_use;
+  std::vector<std::size_t> free_slots;
+  std::deque<std::size_t> fill_order;
+  std::unordered_map<uint64_t, std::size_t> index; // block address -> slot
+  const std::size_t shamt;
+};
+
 #if (USER_CODES == ENABLE)
 #include <array>
 #include "ooo_cpu.h"
@@ -74,7 +167,10 @@ public:
   // Each MSHR refers to one missing cache line and contains a valid bit, the tag of the cache line and
   // one or more subentries to handle multiple misses to the same cache line. (from google by "cache mshr is")
 #endif
-  std::list<PACKET> MSHR; // MSHR
+  MSHR_POOL MSHR{MSHR_SIZE, OFFSET_BITS}; // MSHR
+
+  // address-keyed indexes of the packets in RQ, PQ and WQ, thus looking for a duplicate doesn't scan the queues.
+  std::unordered_map<uint64_t, PACKET*> RQ_index, PQ_index, WQ_index;
 
   uint64_t sim_access[NUM_CPUS][NUM_TYPES] = {}, sim_hit[NUM_CPUS][NUM_TYPES] = {}, sim_miss[NUM_CPUS][NUM_TYPES] = {}, roi_access[NUM_CPUS][NUM_TYPES] = {},
     roi_hit[NUM_CPUS][NUM_TYPES] = {}, roi_miss[NUM_CPUS][NUM_TYPES] = {};
@@ -107,6 +203,10 @@ public:
   void add_mshr(PACKET* packet);
   void va_translate_prefetches();
 
+  // push a packet into RQ, PQ or WQ and its index, or pop the oldest one from them.
+  void queue_push_back(champsim::delay_queue<PACKET>& queue, std::unordered_map<uint64_t, PACKET*>& queue_index, std::size_t shamt, const PACKET& packet);
+  void queue_pop_front(champsim::delay_queue<PACKET>& queue, std::unordered_map<uint64_t, PACKET*>& queue_index, std::size_t shamt);
+
 #if (USER_CODES == ENABLE)
   // handle_fill() handles MSHR.
   // handle_writeback() handles WQ.
@@ -131,6 +231,18 @@ public:
 
   void print_deadlock() override;
 
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+  /** @brief
+   *  The cache is idle when its queues have no packet to handle, or their oldest packet misses and waits for a free MSHR.
+   *  The return of a fill and a delayed packet becoming ready are the events that end the idle cycles.
+   */
+  uint64_t idle_cycles(uint64_t limit) override;
+  void skip_cycles(uint64_t cycles) override;
+
+  // whether add_rq() rejects a packet with this address, i.e., it is neither forwarded from the WQ nor merged, and the RQ is full.
+  bool rq_rejects(uint64_t address);
+#endif // SIMULATION_USE_CLOCK_SKIPPING
+
 #if (USER_CODES == ENABLE)
   /* Definition and declaration for replacement policy */
   // Replacement policy type selection, i.e., lru, ship, srrip, drrip.
@@ -311,6 +423,49 @@ public:
     }
   }
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  // Checkpoint for replacement policy
+  void repl_rreplacementDlru_checkpoint(CHECKPOINT&);
+  void repl_rreplacementDship_checkpoint(CHECKPOINT&);
+  void repl_rreplacementDsrrip_checkpoint(CHECKPOINT&);
+  void repl_rreplacementDdrrip_checkpoint(CHECKPOINT&);
+
+  void impl_replacement_checkpoint(CHECKPOINT& checkpoint)
+  {
+    if (repl_type == repl_t::rreplacementDlru) repl_rreplacementDlru_checkpoint(checkpoint);
+    else if (repl_type == repl_t::rreplacementDship) repl_rreplacementDship_checkpoint(checkpoint);
+    else if (repl_type == repl_t::rreplacementDsrrip) repl_rreplacementDsrrip_checkpoint(checkpoint);
+    else if (repl_type == repl_t::rreplacementDdrrip) repl_rreplacementDdrrip_checkpoint(checkpoint);
+    else
+    {
+      std::cout << __func__ << ": Replacement policy module not found." << std::endl;
+      throw std::invalid_argument("Replacement policy module not found");
+    }
+  }
+
+  // Checkpoint for data prefetcher
+  void pref_pprefetcherDno_checkpoint(CHECKPOINT&);
+  void pref_pprefetcherDnext_line_checkpoint(CHECKPOINT&);
+  void pref_pprefetcherDip_stride_checkpoint(CHECKPOINT&);
+
+  void impl_prefetcher_checkpoint(CHECKPOINT& checkpoint)
+  {
+    if (pref_type == pref_t::pprefetcherDno) pref_pprefetcherDno_checkpoint(checkpoint);
+    else if (pref_type == pref_t::pprefetcherDnext_line) pref_pprefetcherDnext_line_checkpoint(checkpoint);
+    else if (pref_type == pref_t::pprefetcherDip_stride) pref_pprefetcherDip_stride_checkpoint(checkpoint);
+    else if (pref_type == pref_t::CPU_REDIRECT_pprefetcherDno_instr_) ooo_cpu[cpu]->pref_pprefetcherDno_instr_checkpoint(checkpoint);
+    else if (pref_type == pref_t::CPU_REDIRECT_pprefetcherDnext_line_instr_) ooo_cpu[cpu]->pref_pprefetcherDnext_line_instr_checkpoint(checkpoint);
+    else
+    {
+      std::cout << __func__ << ": Data prefetcher module not found." << std::endl;
+      throw std::invalid_argument("Data prefetcher module not found");
+    }
+  }
+
+  // save or restore the blocks and the state of the replacement policy and the prefetcher.
+  void checkpoint(CHECKPOINT& checkpoint);
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 #include "cache_modules.inc"
 #endif  // USER_CODES
@@ -369,7 +524,10 @@ public:
   // Each MSHR refers to one missing cache line and contains a valid bit, the tag of the cache line and
   // one or more subentries to handle multiple misses to the same cache line. (from google by "cache mshr is")
 #endif
-  std::list<PACKET> MSHR; // MSHR
+  MSHR_POOL MSHR{MSHR_SIZE, OFFSET_BITS}; // MSHR
+
+  // address-keyed indexes of the packets in RQ, PQ and WQ, thus looking for a duplicate doesn't scan the queues.
+  std::unordered_map<uint64_t, PACKET*> RQ_index, PQ_index, WQ_index;
 
   uint64_t sim_access[NUM_CPUS][NUM_TYPES] = {}, sim_hit[NUM_CPUS][NUM_TYPES] = {}, sim_miss[NUM_CPUS][NUM_TYPES] = {}, roi_access[NUM_CPUS][NUM_TYPES] = {},
     roi_hit[NUM_CPUS][NUM_TYPES] = {}, roi_miss[NUM_CPUS][NUM_TYPES] = {};
@@ -402,6 +560,10 @@ public:
   void add_mshr(PACKET* packet);
   void va_translate_prefetches();
 
+  // push a packet into RQ, PQ or WQ and its index, or pop the oldest one from them.
+  void queue_push_back(champsim::delay_queue<PACKET>& queue, std::unordered_map<uint64_t, PACKET*>& queue_index, std::size_t shamt, const PACKET& packet);
+  void queue_pop_front(champsim::delay_queue<PACKET>& queue, std::unordered_map<uint64_t, PACKET*>& queue_index, std::size_t shamt);
+
 #if (USER_CODES == ENABLE)
   // handle_fill() handles MSHR.
   // handle_writeback() handles WQ.
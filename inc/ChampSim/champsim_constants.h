@@ -10,17 +10,11 @@
 #define LOG2_PAGE_SIZE        (lg2(PAGE_SIZE))
 #define STAT_PRINTING_PERIOD  (10000000ul)
 #define NUM_CPUS              (1u)
-#define NUM_CACHES            (7u)
-#define NUM_OPERABLES         (10u)
 
 #if (CPU_USE_MULTIPLE_CORES == ENABLE)
 #undef NUM_CPUS
-#undef NUM_CACHES
-#undef NUM_OPERABLES
 
-#define NUM_CPUS              (2u)
-#define NUM_CACHES            (NUM_CPUS * 6u + 1u)
-#define NUM_OPERABLES         (NUM_CACHES + NUM_CPUS * 2u + 1u)
+#define NUM_CPUS              (2u)  // any number of cores (e.g., 4, 8, 16), each core has its private caches, TLBs and page table walker, and all cores share the LLC
 #endif  // CPU_USE_MULTIPLE_CORES
 
 /** @note
@@ -189,7 +183,6 @@
 #define L1D_PREF_ACTIVATE_MASK      (5) // "LOAD,PREFETCH" = (1 << static_cast<int>(LOAD)) | (1 << static_cast<int>(PREFETCH))
 
 /* PTW */
-#define PTW_CPU                     (CPU_0)
 #define PTW_PSCL5_SET               (1)
 #define PTW_PSCL5_WAY               (2)
 #define PTW_PSCL4_SET               (1)
@@ -270,7 +263,6 @@
 #define DTLB_PREF_ACTIVATE_MASK      (5) // "LOAD,PREFETCH" = (1 << static_cast<int>(LOAD)) | (1 << static_cast<int>(PREFETCH))
 
 /* CPU */
-#define CPU_0                       (0)      // CPU number
 #define CPU_FREQUENCY               (4000.0) // MHz
 #define CPU_DIB_SET                 (32)     // DIB sets
 #define CPU_DIB_WAY                 (8)      // DIB ways
@@ -295,10 +287,6 @@
 #define CPU_SCHEDULE_LATENCY        (0)
 #define CPU_EXECUTE_LATENCY         (0)
 
-#if (CPU_USE_MULTIPLE_CORES == ENABLE)
-#define CPU_1                       (1)      // CPU number
-#endif  // CPU_USE_MULTIPLE_CORES
-
 // Clock scale
 #if (RAMULATOR == ENABLE)
 #define MEMORY_CONTROLLER_CLOCK_SCALE (1.0)
@@ -20,9 +20,11 @@
 #include <algorithm>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <utility>
 
 #include "circular_buffer.hpp"
+#include "ProjectConfiguration.h" // user file
 #include <type_traits>
 
 namespace champsim
@@ -172,6 +174,34 @@ namespace champsim
       _end_ready = std::next(_buf.begin(), std::distance(_delays.begin(), delay_it));
     }
 
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+    /***
+     * The number of cycles in which the ready elements stay the same, i.e.,
+     * operate() makes another element ready after this number of cycles.
+     ***/
+    long long int cycles_to_next_ready()
+    {
+      long long int cycles = std::numeric_limits<long long int>::max();
+      auto delay_it = std::next(_delays.begin(), std::distance(begin(), end_ready()));
+      for (; delay_it != _delays.end(); ++delay_it)
+        cycles = std::min(cycles, std::max(*delay_it, 1LL));
+
+      return cycles;
+    }
+
+    /***
+     * Equal to calling operate() in each of the cycles.
+     ***/
+    void skip_cycles(long long int cycles)
+    {
+      for (auto& x : _delays)
+        x -= cycles;
+
+      auto delay_it = std::partition_point(_delays.begin(), _delays.end(), [](long long int x) { return x <= 0; });
+      _end_ready = std::next(_buf.begin(), std::distance(_delays.begin(), delay_it));
+    }
+#endif // SIMULATION_USE_CLOCK_SKIPPING
+
   private:
     const size_type sz;
     buffer_t<value_type> _buf{sz};
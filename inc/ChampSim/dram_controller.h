@@ -26,8 +26,15 @@
 #include "operable.h"
 #include "util.h"
 #include "os_transparent_management.h"
+#include "cameo.h"
+#include "variable_granularity.h"
+#include "ideal_single_mempod.h"
 #include "ProjectConfiguration.h" // user file
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif  // SIMULATION_USE_CHECKPOINT
+
 #if (RAMULATOR == ENABLE)
 #else
  // these values control when to send out a burst of writes
@@ -56,6 +63,51 @@ constexpr int32_t ceil(float num)
 using namespace ramulator;
 extern uint8_t all_warmup_complete;
 
+/** @brief
+ *  Side table of the packets whose read requests are in flight inside the memories.
+ *  A Ramulator's request only carries the index of its packet, so the requests moving among
+ *  the memories' queues stay small. Slots are recycled, thus the table stops growing once
+ *  it reaches the maximum number of in-flight reads.
+ */
+class PACKET_POOL
+{
+public:
+  // get a free slot, the caller fills it after the request is accepted by the memory.
+  uint32_t acquire()
+  {
+    if (free_slots.empty())
+    {
+      packets.emplace_back();
+      return uint32_t(packets.size() - 1);
+    }
+
+    uint32_t index = free_slots.back();
+    free_slots.pop_back();
+    return index;
+  };
+
+  void release(uint32_t index)
+  {
+    assert(index < packets.size());
+    free_slots.push_back(index);
+  };
+
+  PACKET& operator[](uint32_t index)
+  {
+    return packets[index];
+  };
+
+private:
+  std::vector<PACKET> packets;
+  std::vector<uint32_t> free_slots;
+};
+
+// queue_type 1 is read, 2 is write, and 3 is prefetch which Ramulator puts into the read queue.
+inline Request::Type get_request_type(uint8_t queue_type)
+{
+  return (queue_type == 2) ? Request::Type::WRITE : Request::Type::READ;
+}
+
 #else
 struct MEMORY_STATISTICS
 {
@@ -126,6 +178,7 @@ public:
   /* General part */
   double clock_scale = MEMORY_CONTROLLER_CLOCK_SCALE;
   double clock_scale2 = MEMORY_CONTROLLER_CLOCK_SCALE;
+  double leap_operation_memory = 0, leap_operation_memory2 = 0;  // the memories skip the processor's cycles periodically
 
   // Note here they are the references to escape memory deallocation here.
   ramulator::Memory<T, Controller>& memory;
@@ -134,8 +187,18 @@ public:
   const uint8_t memory_id = MEMORY_NUMBER_ONE;
   const uint8_t memory2_id = MEMORY_NUMBER_TWO;
 
+  // packets of the in-flight read requests, Ramulator's requests only carry their indexes.
+  PACKET_POOL packet_pool;
+
+  // a lambda capturing only this is stored inside std::function, so copying it with every request doesn't allocate.
+#if (MEMORY_USE_PARALLEL_TICKING == ENABLE)
+  const std::function<void(Request&)> return_data_callback = [this](Request& request) { if (!defer_callback(request)) return_data(request); };
+#else
+  const std::function<void(Request&)> return_data_callback = [this](Request& request) { return_data(request); };
+#endif  // MEMORY_USE_PARALLEL_TICKING
+
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-  OS_TRANSPARENT_MANAGEMENT& os_transparent_management;
+  OS_TRANSPARENT_MANAGEMENT& os_transparent_management;   // the design selected by management_policy
 #endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
@@ -152,8 +215,8 @@ public:
   };
   std::array<BUFFER_ENTRY, SWAPPING_BUFFER_ENTRY_NUMBER> buffer = {};
   uint64_t base_address[SWAPPING_SEGMENT_NUMBER];    // base_address[0] for segment 1, base_address[1] for segment 2. Address is hardware address and at cache line granularity.
-  uint8_t active_entry_number;
-  uint8_t finish_number;
+  uint8_t active_entry_number = 0;
+  uint8_t finish_number = 0;
 
   // scoped enumerations
   enum class SwappingState: uint8_t
@@ -186,6 +249,21 @@ public:
   void operate() override;
   void print_deadlock() override;
 
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+  /** @brief
+   *  The memory controller is idle when the memories' queues are empty and the research proposal has no remapping
+   *  request. A completed read, a refresh and the periodic work of the research proposal end the idle cycles.
+   *  The functional warmup isn't skipped.
+   */
+  uint64_t idle_cycles(uint64_t limit) override;
+  void skip_cycles(uint64_t cycles) override;
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  // save or restore the tables of the research proposals, the requests in the memories are not saved.
+  void checkpoint(CHECKPOINT& checkpoint);
+#endif  // SIMULATION_USE_CHECKPOINT
+
   int add_rq(PACKET* packet) override;
   int add_wq(PACKET* packet) override;
   int add_pq(PACKET* packet) override;
@@ -202,8 +280,69 @@ public:
    */
   uint32_t get_size(uint8_t queue_type, uint64_t address) override;
 
+  /** @brief
+   *  The memory and its channel which service a hardware address. add_rq() and add_wq() decode it
+   *  once per packet and reuse it for all queue queries of that packet.
+   */
+  struct QUEUE_LOCATION
+  {
+    uint8_t memory_id = NUMBER_OF_MEMORIES;
+    int channel = 0;
+  };
+
+  // The address is hardware address.
+  QUEUE_LOCATION get_queue_location(uint64_t address);
+
+  uint32_t get_occupancy(uint8_t queue_type, const QUEUE_LOCATION& location);
+  uint32_t get_size(uint8_t queue_type, const QUEUE_LOCATION& location);
+
   void return_data(Request& request);
 
+  /** @brief
+   *  Send a read request into the memory, the packet is kept in packet_pool until return_data().
+   *  The address is the memory's own address.
+   */
+  template<typename MEMORY>
+  bool send_read_request(MEMORY& target_memory, uint64_t address, const PACKET& packet, uint8_t target_memory_id);
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+  /** @brief
+   *  Call func with os_transparent_management cast to the final class of its design, so the calls of the policy
+   *  inside func are bound at compile time instead of going through the virtual table.
+   */
+  template<typename FUNCTION>
+  decltype(auto) visit_os_transparent_management(FUNCTION&& func);
+
+  // the research proposals' work in every cycle, it is called through visit_os_transparent_management().
+  template<class POLICY>
+  void operate_os_transparent_management(POLICY& policy);
+
+  // translate the packet's address and track this access, return the queue location of its hardware address.
+  template<class POLICY>
+  QUEUE_LOCATION manage_memory_request(POLICY& policy, PACKET& packet, uint8_t type);
+
+#if (MEMORY_USE_FUNCTIONAL_WARMUP == ENABLE)
+  /** @brief
+   *  Functional warmup. Before all cores finish warmup, the requests are still forwarded, but they train the research
+   *  proposal as idle memories would, and its remapping requests are finished at once (no swapping, no timing).
+   *  The memories are not ticked, so the detailed simulation starts with warm tables and idle memories.
+   */
+  template<class POLICY>
+  void operate_functional_warmup(POLICY& policy);
+
+  template<class POLICY>
+  void functional_warmup_memory_request(POLICY& policy, const PACKET& packet, uint8_t type);
+
+  template<class POLICY>
+  void finish_remapping_requests_at_once(POLICY& policy);
+#endif  // MEMORY_USE_FUNCTIONAL_WARMUP
+
+#if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
+  // the co-located line location table is a variant of CAMEO, and no other design is compiled in with it.
+  CAMEO& colocated_line_location_table() { return static_cast<CAMEO&>(os_transparent_management); };
+#endif  // COLOCATED_LINE_LOCATION_TABLE
+#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
 public:
   // input address should be hardware address and at byte granularity
@@ -220,6 +359,11 @@ private:
 
   // this function is used by memories, like Ramulator.
   void return_swapping_data(Request& request);
+#if (MEMORY_USE_PARALLEL_TICKING == ENABLE)
+  const std::function<void(Request&)> return_swapping_data_callback = [this](Request& request) { if (!defer_callback(request)) return_swapping_data(request); };
+#else
+  const std::function<void(Request&)> return_swapping_data_callback = [this](Request& request) { return_swapping_data(request); };
+#endif  // MEMORY_USE_PARALLEL_TICKING
 
   // this function is used by memory controller in add_rq() and add_wq().
   uint8_t check_request(PACKET& packet, uint8_t type);    // packet needs to prepare its hardware address.
@@ -227,6 +371,32 @@ private:
 
 #endif  // MEMORY_USE_SWAPPING_UNIT
 
+#if (MEMORY_USE_PARALLEL_TICKING == ENABLE)
+private:
+  /** @brief
+   *  While the two memories tick on their own threads, the requests they complete wait in returned_requests, and
+   *  replay_callbacks() calls their callbacks afterwards, first the ones of memory and then the ones of memory2.
+   *  This is the order of ticking the memories one after another, and the callbacks only change ChampSim's state
+   *  (e.g., the packet pool and the LLC), which the memories don't read while ticking. So the results are the same.
+   */
+  bool ticking_in_parallel = false;
+  std::array<std::vector<Request>, NUMBER_OF_MEMORIES> returned_requests;
+
+  // return true if the callback of this request is deferred.
+  bool defer_callback(Request& request)
+  {
+    if (ticking_in_parallel == false)
+    {
+      return false;
+    }
+
+    returned_requests[request.memory_id].push_back(request);
+    return true;
+  };
+
+  void tick_memories_in_parallel();
+  void replay_callbacks();
+#endif  // MEMORY_USE_PARALLEL_TICKING
 };
 
 template<class T, class T2>
@@ -234,7 +404,7 @@ MEMORY_CONTROLLER<T, T2>::MEMORY_CONTROLLER(double freq_scale, double clock_scal
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
   : champsim::operable(freq_scale), MemoryRequestConsumer(std::numeric_limits<unsigned>::max()),
   clock_scale(clock_scale), clock_scale2(clock_scale2), memory(memory), memory2(memory2),
-  os_transparent_management(*(new OS_TRANSPARENT_MANAGEMENT(memory.max_address + memory2.max_address, memory.max_address)))
+  os_transparent_management(*create_os_transparent_management(management_policy, memory.max_address + memory2.max_address, memory.max_address))
 #else
   : champsim::operable(freq_scale), MemoryRequestConsumer(std::numeric_limits<unsigned>::max()),
   clock_scale(clock_scale), clock_scale2(clock_scale2), memory(memory), memory2(memory2)
@@ -290,29 +460,298 @@ MEMORY_CONTROLLER<T, T2>::~MEMORY_CONTROLLER()
 template<class T, class T2>
 void MEMORY_CONTROLLER<T, T2>::operate()
 {
+#if (MEMORY_USE_FUNCTIONAL_WARMUP == ENABLE)
+  if (all_warmup_complete < NUM_CPUS)
+  {
+    visit_os_transparent_management([this](auto& policy) { operate_functional_warmup(policy); });
+    Stats::curTick++; // processor clock, global, for Statistics
+    return;
+  }
+#endif  // MEMORY_USE_FUNCTIONAL_WARMUP
+
   /* Operate research proposals below */
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-  os_transparent_management.cold_data_detection();
+  visit_os_transparent_management([this](auto& policy) { operate_os_transparent_management(policy); });
+#elif (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+  /* Operate swapping below */
+  if (operate_swapping() == 2)  // the swapping unit finishes a swapping request
+  {
+    initialize_swapping();
+  }
+#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT, MEMORY_USE_SWAPPING_UNIT
+
+  /* Operate memories below */
+#if (MEMORY_USE_PARALLEL_TICKING == ENABLE)
+  // the memories tick on two threads only when both tick in this cycle.
+  if ((leap_operation_memory < 1) && (leap_operation_memory2 < 1))
+  {
+    tick_memories_in_parallel();
+    leap_operation_memory += clock_scale;
+    leap_operation_memory2 += clock_scale2;
+    Stats::curTick++; // processor clock, global, for Statistics
+    return;
+  }
+#endif  // MEMORY_USE_PARALLEL_TICKING
+
+  // skip periodically
+  if (leap_operation_memory >= 1)
+  {
+    leap_operation_memory -= 1;
+  }
+  else
+  {
+    memory.tick();
+    leap_operation_memory += clock_scale;
+  }
+
+  if (leap_operation_memory2 >= 1)
+  {
+    leap_operation_memory2 -= 1;
+  }
+  else
+  {
+    memory2.tick();
+    leap_operation_memory2 += clock_scale2;
+  }
+  Stats::curTick++; // processor clock, global, for Statistics
+};
+
+#if (MEMORY_USE_PARALLEL_TICKING == ENABLE)
+template<class T, class T2>
+void MEMORY_CONTROLLER<T, T2>::tick_memories_in_parallel()
+{
+  ticking_in_parallel = true;
+
+#pragma omp parallel sections num_threads(NUMBER_OF_MEMORIES)
+  {
+#pragma omp section
+    memory.tick();
+
+#pragma omp section
+    memory2.tick();
+  }
+
+  ticking_in_parallel = false;
+  replay_callbacks();
+};
+
+template<class T, class T2>
+void MEMORY_CONTROLLER<T, T2>::replay_callbacks()
+{
+  for (auto& requests : returned_requests)
+  {
+    for (auto& request : requests)
+    {
+      request.callback(request);
+    }
+    requests.clear();
+  }
+};
+#endif  // MEMORY_USE_PARALLEL_TICKING
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+template<class T, class T2>
+uint64_t MEMORY_CONTROLLER<T, T2>::idle_cycles(uint64_t limit)
+{
+#if (MEMORY_USE_FUNCTIONAL_WARMUP == ENABLE)
+  if (all_warmup_complete < NUM_CPUS)
+  {
+    return 0;
+  }
+#endif  // MEMORY_USE_FUNCTIONAL_WARMUP
+
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+  // the swapping unit is idle when it only waits for the data of its read requests
+  if (states == SwappingState::Swapping)
+  {
+    for (auto i = 0; i < active_entry_number; i++)
+    {
+      if ((buffer[i].finish == false) && ((buffer[i].read_issue[0] == false) || (buffer[i].read_issue[1] == false) || ((buffer[i].read[0] == true) && (buffer[i].read[1] == true))))
+      {
+        return 0;
+      }
+    }
+  }
+#endif  // MEMORY_USE_SWAPPING_UNIT
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+  limit = std::min(limit, visit_os_transparent_management([this](auto& policy) -> uint64_t
+    {
+#if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
+      // the requests waiting for the fast memory are sent to the slow memory in operate()
+      for (auto& request : policy.incomplete_read_request_queue)
+      {
+        if (request.fm_access_finish)
+        {
+          return 0;
+        }
+      }
+      for (auto& request : policy.incomplete_write_request_queue)
+      {
+        if (request.fm_access_finish)
+        {
+          return 0;
+        }
+      }
+#endif  // COLOCATED_LINE_LOCATION_TABLE
+
+      OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
+      const bool issue = policy.issue_remapping_request(remapping_request);
+#if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
+      if (states == SwappingState::Swapping)
+      {
+        // the swapping request is kept, unless update_swapping_segments() adds new data of the same swapping segments
+        const bool is_updated = ((remapping_request.address_in_fm >> LOG2_BLOCK_SIZE) == base_address[0]) && ((remapping_request.address_in_sm >> LOG2_BLOCK_SIZE) == base_address[1])
+          && (remapping_request.size > active_entry_number);
+        if ((issue == false) || is_updated)
+        {
+          return 0;
+        }
+      }
+      else if (issue)  // start a new swapping request
+      {
+        return 0;
+      }
+#else
+      if (issue)  // the remapping request is finished at once
+      {
+        return 0;
+      }
+#endif  // MEMORY_USE_SWAPPING_UNIT
+      return policy.idle_cycles();
+    }));
+#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+  // count the processor's cycles until a memory ticks with work to do
+  const long idle_ticks = memory.idle_ticks(std::numeric_limits<long>::max());
+  const long idle_ticks2 = memory2.idle_ticks(std::numeric_limits<long>::max());
+  double leap_operation = leap_operation_memory, leap_operation2 = leap_operation_memory2;
+  long ticks = 0, ticks2 = 0;
+  uint64_t cycles = 0;
+  for (; cycles < limit; cycles++)
+  {
+    if (leap_operation >= 1)
+    {
+      leap_operation -= 1;
+    }
+    else if (ticks == idle_ticks)
+    {
+      break;
+    }
+    else
+    {
+      ticks++;
+      leap_operation += clock_scale;
+    }
+
+    if (leap_operation2 >= 1)
+    {
+      leap_operation2 -= 1;
+    }
+    else if (ticks2 == idle_ticks2)
+    {
+      break;
+    }
+    else
+    {
+      ticks2++;
+      leap_operation2 += clock_scale2;
+    }
+  }
+
+  return cycles;
+};
+
+template<class T, class T2>
+void MEMORY_CONTROLLER<T, T2>::skip_cycles(uint64_t cycles)
+{
+  long ticks = 0, ticks2 = 0;
+  for (uint64_t i = 0; i < cycles; i++)
+  {
+    if (leap_operation_memory >= 1)
+    {
+      leap_operation_memory -= 1;
+    }
+    else
+    {
+      ticks++;
+      leap_operation_memory += clock_scale;
+    }
+
+    if (leap_operation_memory2 >= 1)
+    {
+      leap_operation_memory2 -= 1;
+    }
+    else
+    {
+      ticks2++;
+      leap_operation_memory2 += clock_scale2;
+    }
+  }
+
+  memory.skip_ticks(ticks);
+  memory2.skip_ticks(ticks2);
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+  visit_os_transparent_management([cycles](auto& policy) { policy.skip_cycles(cycles); });
+#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+  Stats::curTick += cycles; // processor clock, global, for Statistics
+  champsim::operable::skip_cycles(cycles);
+};
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+template<class T, class T2>
+template<typename FUNCTION>
+decltype(auto) MEMORY_CONTROLLER<T, T2>::visit_os_transparent_management(FUNCTION&& func)
+{
+  switch (os_transparent_management.policy)
+  {
+#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
+  case ManagementPolicy::Cameo:
+    return func(static_cast<CAMEO&>(os_transparent_management));
+#endif  // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE
+#if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
+  case ManagementPolicy::VariableGranularity:
+    return func(static_cast<VARIABLE_GRANULARITY&>(os_transparent_management));
+#endif  // IDEAL_VARIABLE_GRANULARITY
+#if (IDEAL_SINGLE_MEMPOD == ENABLE)
+  case ManagementPolicy::MemPod:
+    return func(static_cast<MEMPOD&>(os_transparent_management));
+#endif  // IDEAL_SINGLE_MEMPOD
+  default:
+    break;
+  }
+
+  std::cout << __func__ << ": memory management policy error." << std::endl;
+  abort();
+};
+
+template<class T, class T2>
+template<class POLICY>
+void MEMORY_CONTROLLER<T, T2>::operate_os_transparent_management(POLICY& policy)
+{
+  policy.cold_data_detection();
 
 #if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-  for (size_t i = 0; i < os_transparent_management.incomplete_read_request_queue.size(); i++)
+  for (size_t i = 0; i < policy.incomplete_read_request_queue.size(); i++)
   {
-    if (os_transparent_management.incomplete_read_request_queue[i].fm_access_finish)  // this read request is ready to access slow memory
+    if (policy.incomplete_read_request_queue[i].fm_access_finish)  // this read request is ready to access slow memory
     {
-      PACKET packet = os_transparent_management.incomplete_read_request_queue[i].packet;
+      PACKET packet = policy.incomplete_read_request_queue[i].packet;
       /* Send memory request below */
       bool stall = true;
       uint64_t address = packet.h_address;
       if ((memory.max_address <= address) && (address < memory.max_address + memory2.max_address))
       {
         // the memory itself doesn't know other memories' space, so we manage the overall mapping.
-        Request request(address - memory.max_address, Request::Type::READ, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), packet, packet.cpu, memory2_id);
-        stall = !memory2.send(request);
+        stall = !send_read_request(memory2, address - memory.max_address, packet, memory2_id);
 
         if (stall == false)
         {
           read_request_in_memory2++;
-          os_transparent_management.incomplete_read_request_queue.erase(os_transparent_management.incomplete_read_request_queue.begin() + i);
+          policy.incomplete_read_request_queue.erase(policy.incomplete_read_request_queue.begin() + i);
         }
       }
       else
@@ -322,11 +761,11 @@ void MEMORY_CONTROLLER<T, T2>::operate()
     }
   }
 
-  for (size_t i = 0; i < os_transparent_management.incomplete_write_request_queue.size(); i++)
+  for (size_t i = 0; i < policy.incomplete_write_request_queue.size(); i++)
   {
-    if (os_transparent_management.incomplete_write_request_queue[i].fm_access_finish)  // this write request is ready to write memory (fast or slow)
+    if (policy.incomplete_write_request_queue[i].fm_access_finish)  // this write request is ready to write memory (fast or slow)
     {
-      PACKET packet = os_transparent_management.incomplete_write_request_queue[i].packet;
+      PACKET packet = policy.incomplete_write_request_queue[i].packet;
       /* Send memory request below */
       bool stall = true;
       uint64_t address = packet.h_address;
@@ -334,25 +773,25 @@ void MEMORY_CONTROLLER<T, T2>::operate()
       // assign the request to the right memory.
       if (address < memory.max_address)
       {
-        Request request(address, Request::Type::WRITE, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), packet, packet.cpu, memory_id);
+        Request request(address, Request::Type::WRITE, return_data_callback, Request::NO_PACKET, packet.cpu, memory_id);
         stall = !memory.send(request);
 
         if (stall == false)
         {
           write_request_in_memory++;
-          os_transparent_management.incomplete_write_request_queue.erase(os_transparent_management.incomplete_write_request_queue.begin() + i);
+          policy.incomplete_write_request_queue.erase(policy.incomplete_write_request_queue.begin() + i);
         }
       }
       else if (address < memory.max_address + memory2.max_address)
       {
         // the memory itself doesn't know other memories' space, so we manage the overall mapping.
-        Request request(address - memory.max_address, Request::Type::WRITE, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), packet, packet.cpu, memory2_id);
+        Request request(address - memory.max_address, Request::Type::WRITE, return_data_callback, Request::NO_PACKET, packet.cpu, memory2_id);
         stall = !memory2.send(request);
 
         if (stall == false)
         {
           write_request_in_memory2++;
-          os_transparent_management.incomplete_write_request_queue.erase(os_transparent_management.incomplete_write_request_queue.begin() + i);
+          policy.incomplete_write_request_queue.erase(policy.incomplete_write_request_queue.begin() + i);
         }
       }
       else
@@ -362,8 +801,6 @@ void MEMORY_CONTROLLER<T, T2>::operate()
     }
   }
 #endif  // COLOCATED_LINE_LOCATION_TABLE
-#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-
 
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
   /* Operate swapping below */
@@ -372,56 +809,39 @@ void MEMORY_CONTROLLER<T, T2>::operate()
   {
   case 0: // the swapping unit is idle
   {
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
     OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
-    bool issue = os_transparent_management.issue_remapping_request(remapping_request);
+    bool issue = policy.issue_remapping_request(remapping_request);
     if (issue == true)  // get a new remapping request.
     {
-#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE) || (IDEAL_VARIABLE_GRANULARITY == ENABLE)
       start_swapping_segments(remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
-#elif (IDEAL_SINGLE_MEMPOD == ENABLE)
-      start_swapping_segments(remapping_request.h_address_in_fm, remapping_request.h_address_in_sm, remapping_request.size);
-#endif  // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_SINGLE_MEMPOD
     }
-#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
   }
   break;
   case 1: // the swapping unit is busy
   {
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
     OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
-    bool issue = os_transparent_management.issue_remapping_request(remapping_request);
+    bool issue = policy.issue_remapping_request(remapping_request);
     if (issue == true)  // get a remapping request.
     {
       // in case the swapping segments are updated
-#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE) || (IDEAL_VARIABLE_GRANULARITY == ENABLE)
       update_swapping_segments(remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
-#elif (IDEAL_SINGLE_MEMPOD == ENABLE)
-      update_swapping_segments(remapping_request.h_address_in_fm, remapping_request.h_address_in_sm, remapping_request.size);
-#endif // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_SINGLE_MEMPOD
     }
     else
     {
       std::cout << __func__ << ": issue_remapping_request error." << std::endl;
       assert(0);
     }
-#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
   }
   break;
   case 2: // the swapping unit finishes a swapping request
   {
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
     bool is_updated = false;
     OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
-    bool issue = os_transparent_management.issue_remapping_request(remapping_request);
+    bool issue = policy.issue_remapping_request(remapping_request);
     if (issue == true)  // get a remapping request.
     {
       // in case the swapping segments are updated
-#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE) || (IDEAL_VARIABLE_GRANULARITY == ENABLE)
       is_updated = update_swapping_segments(remapping_request.address_in_fm, remapping_request.address_in_sm, remapping_request.size);
-#elif (IDEAL_SINGLE_MEMPOD == ENABLE)
-      is_updated = update_swapping_segments(remapping_request.h_address_in_fm, remapping_request.h_address_in_sm, remapping_request.size);
-#endif // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_SINGLE_MEMPOD
     }
     else
     {
@@ -431,61 +851,81 @@ void MEMORY_CONTROLLER<T, T2>::operate()
 
     if (is_updated == false)
     {
-      os_transparent_management.finish_remapping_request();
+      policy.finish_remapping_request();
       initialize_swapping();
     }
-#else
-
-    initialize_swapping();
-#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
   }
   break;
   default:
     break;
   }
 #else
-
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
   // Since we don't consider data swapping overhead here, the data swapping is finished immediately
+  const uint8_t swapping_states = 0;  // so the swapping is always idle
   OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
-  bool issue = os_transparent_management.issue_remapping_request(remapping_request);
+  bool issue = policy.issue_remapping_request(remapping_request);
   if (issue == true)  // get a new remapping request.
   {
-    os_transparent_management.finish_remapping_request();
+    policy.finish_remapping_request();
   }
-#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 #endif  // MEMORY_USE_SWAPPING_UNIT
 
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-#if (IDEAL_SINGLE_MEMPOD == ENABLE)
-  os_transparent_management.check_interval_swap(swapping_states);
-#endif // IDEAL_SINGLE_MEMPOD
-#endif // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+  policy.check_interval_swap(swapping_states);
+};
 
-  /* Operate memories below */
-  static double leap_operation = 0, leap_operation2 = 0;
-  // skip periodically
-  if (leap_operation >= 1)
-  {
-    leap_operation -= 1;
-  }
-  else
-  {
-    memory.tick();
-    leap_operation += clock_scale;
-  }
+template<class T, class T2>
+template<class POLICY>
+typename MEMORY_CONTROLLER<T, T2>::QUEUE_LOCATION MEMORY_CONTROLLER<T, T2>::manage_memory_request(POLICY& policy, PACKET& packet, uint8_t type)
+{
+  policy.physical_to_hardware_address(packet);
+  const QUEUE_LOCATION location = get_queue_location(packet.h_address);
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+  policy.memory_activity_tracking(packet.address, type, packet.type_origin, float(get_occupancy(type, location)) / get_size(type, location));
+#else
+  policy.memory_activity_tracking(packet.address, type, float(get_occupancy(type, location)) / get_size(type, location));
+#endif  // TRACKING_LOAD_STORE_STATISTICS
 
-  if (leap_operation2 >= 1)
-  {
-    leap_operation2 -= 1;
-  }
-  else
+  return location;
+};
+
+#if (MEMORY_USE_FUNCTIONAL_WARMUP == ENABLE)
+template<class T, class T2>
+template<class POLICY>
+void MEMORY_CONTROLLER<T, T2>::operate_functional_warmup(POLICY& policy)
+{
+  policy.cold_data_detection();
+
+  // the swapping unit is always idle in functional warmup.
+  policy.check_interval_swap(0);
+  finish_remapping_requests_at_once(policy);
+};
+
+template<class T, class T2>
+template<class POLICY>
+void MEMORY_CONTROLLER<T, T2>::functional_warmup_memory_request(POLICY& policy, const PACKET& packet, uint8_t type)
+{
+  // the memories' queues are empty in functional warmup.
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+  policy.memory_activity_tracking(packet.address, type, packet.type_origin, 0.0f);
+#else
+  policy.memory_activity_tracking(packet.address, type, 0.0f);
+#endif  // TRACKING_LOAD_STORE_STATISTICS
+
+  finish_remapping_requests_at_once(policy);
+};
+
+template<class T, class T2>
+template<class POLICY>
+void MEMORY_CONTROLLER<T, T2>::finish_remapping_requests_at_once(POLICY& policy)
+{
+  OS_TRANSPARENT_MANAGEMENT::RemappingRequest remapping_request;
+  while (policy.issue_remapping_request(remapping_request))
   {
-    memory2.tick();
-    leap_operation2 += clock_scale2;
+    policy.finish_remapping_request();
   }
-  Stats::curTick++; // processor clock, global, for Statistics
 };
+#endif  // MEMORY_USE_FUNCTIONAL_WARMUP
+#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 
 template<class T, class T2>
 void MEMORY_CONTROLLER<T, T2>::print_deadlock()
@@ -495,6 +935,28 @@ void MEMORY_CONTROLLER<T, T2>::print_deadlock()
 #endif  // MEMORY_USE_SWAPPING_UNIT
 };
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+template<class T, class T2>
+void MEMORY_CONTROLLER<T, T2>::checkpoint(CHECKPOINT& checkpoint)
+{
+  checkpoint.section("MEMORY_CONTROLLER");
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+  // the policy is chosen at runtime, so a checkpoint of another policy can still warm up the caches and the page tables.
+  std::string policy_name = get_management_policy_name(os_transparent_management.policy);
+  checkpoint.transfer(policy_name);
+  if (policy_name != get_management_policy_name(os_transparent_management.policy))
+  {
+    std::cout << __func__ << ": " << checkpoint.file_name << " is saved with memory policy " << policy_name << ", its tables are not restored and "
+      << get_management_policy_name(os_transparent_management.policy) << " starts cold." << std::endl;
+    return; // the memory controller is the last section in the checkpoint.
+  }
+
+  os_transparent_management.checkpoint(checkpoint);
+#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+};
+#endif  // SIMULATION_USE_CHECKPOINT
+
 template<class T, class T2>
 int MEMORY_CONTROLLER<T, T2>::add_rq(PACKET* packet)
 {
@@ -506,6 +968,10 @@ int MEMORY_CONTROLLER<T, T2>::add_rq(PACKET* packet)
 
   if (all_warmup_complete < NUM_CPUS)
   {
+#if (MEMORY_USE_FUNCTIONAL_WARMUP == ENABLE)
+    visit_os_transparent_management([this, packet](auto& policy) { functional_warmup_memory_request(policy, *packet, type); });
+#endif  // MEMORY_USE_FUNCTIONAL_WARMUP
+
     for (auto ret : packet->to_return)
       ret->return_data(packet);
 
@@ -514,12 +980,9 @@ int MEMORY_CONTROLLER<T, T2>::add_rq(PACKET* packet)
 
   /* Operate research proposals below */
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-  os_transparent_management.physical_to_hardware_address(*packet);
-#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
-  os_transparent_management.memory_activity_tracking(packet->address, type, packet->type_origin, float(get_occupancy(type, packet->address)) / get_size(type, packet->address));
+  const QUEUE_LOCATION location = visit_os_transparent_management([this, packet](auto& policy) { return manage_memory_request(policy, *packet, type); });
 #else
-  os_transparent_management.memory_activity_tracking(packet->address, type, float(get_occupancy(type, packet->address)) / get_size(type, packet->address));
-#endif  // TRACKING_LOAD_STORE_STATISTICS
+  const QUEUE_LOCATION location = get_queue_location(packet->address);
 #endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
@@ -565,7 +1028,7 @@ int MEMORY_CONTROLLER<T, T2>::add_rq(PACKET* packet)
     }
 
     // check incomplete_read_request_queue's size
-    if (os_transparent_management.incomplete_read_request_queue.size() >= INCOMPLETE_READ_REQUEST_QUEUE_LENGTH)
+    if (colocated_line_location_table().incomplete_read_request_queue.size() >= INCOMPLETE_READ_REQUEST_QUEUE_LENGTH)
     {
       return int(ReturnValue::Full);
     }
@@ -579,8 +1042,7 @@ int MEMORY_CONTROLLER<T, T2>::add_rq(PACKET* packet)
   // assign the request to the right memory.
   if (address < memory.max_address)
   {
-    Request request(address, Request::Type::READ, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), *packet, packet->cpu, memory_id);
-    stall = !memory.send(request);
+    stall = !send_read_request(memory, address, *packet, memory_id);
 
     if (stall == false)
     {
@@ -605,12 +1067,12 @@ int MEMORY_CONTROLLER<T, T2>::add_rq(PACKET* packet)
       {
         read_request_in_memory--;
 
-        OS_TRANSPARENT_MANAGEMENT::ReadRequest read_request;
+        CAMEO::ReadRequest read_request;
         // create new read_request
         read_request.packet = *packet;
         read_request.fm_access_finish = false;
 
-        os_transparent_management.incomplete_read_request_queue.push_back(read_request);
+        colocated_line_location_table().incomplete_read_request_queue.push_back(read_request);
       }
 #endif  // COLOCATED_LINE_LOCATION_TABLE
     }
@@ -618,8 +1080,7 @@ int MEMORY_CONTROLLER<T, T2>::add_rq(PACKET* packet)
   else if (address < memory.max_address + memory2.max_address)
   {
     // the memory itself doesn't know other memories' space, so we manage the overall mapping.
-    Request request(address - memory.max_address, Request::Type::READ, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), *packet, packet->cpu, memory2_id);
-    stall = !memory2.send(request);
+    stall = !send_read_request(memory2, address - memory.max_address, *packet, memory2_id);
 
     if (stall == false)
     {
@@ -648,8 +1109,11 @@ int MEMORY_CONTROLLER<T, T2>::add_rq(PACKET* packet)
   }
 
 #if (PRINT_MEMORY_TRACE == ENABLE)
-  // output memory trace.
-  output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'R');
+  // output memory trace, a request rejected by a full queue is written when it is sent again.
+  if (stall == false)
+  {
+    output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'R', current_cycle);
+  }
 #endif  // PRINT_MEMORY_TRACE
 
   if (stall == true)
@@ -658,7 +1122,7 @@ int MEMORY_CONTROLLER<T, T2>::add_rq(PACKET* packet)
   }
   else
   {
-    return get_occupancy(type, packet->address);
+    return get_occupancy(type, location);
   }
 };
 
@@ -668,16 +1132,19 @@ int MEMORY_CONTROLLER<T, T2>::add_wq(PACKET* packet)
   const static uint8_t type = 2;  // it means the input request is write request.
 
   if (all_warmup_complete < NUM_CPUS)
+  {
+#if (MEMORY_USE_FUNCTIONAL_WARMUP == ENABLE)
+    visit_os_transparent_management([this, packet](auto& policy) { functional_warmup_memory_request(policy, *packet, type); });
+#endif  // MEMORY_USE_FUNCTIONAL_WARMUP
+
     return int(ReturnValue::Forward); // Fast-forward
+  }
 
   /* Operate research proposals below */
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-  os_transparent_management.physical_to_hardware_address(*packet);
-#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
-  os_transparent_management.memory_activity_tracking(packet->address, type, packet->type_origin, float(get_occupancy(type, packet->address)) / get_size(type, packet->address));
+  const QUEUE_LOCATION location = visit_os_transparent_management([this, packet](auto& policy) { return manage_memory_request(policy, *packet, type); });
 #else
-  os_transparent_management.memory_activity_tracking(packet->address, type, float(get_occupancy(type, packet->address)) / get_size(type, packet->address));
-#endif  // TRACKING_LOAD_STORE_STATISTICS
+  const QUEUE_LOCATION location = get_queue_location(packet->address);
 #endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
@@ -708,25 +1175,24 @@ int MEMORY_CONTROLLER<T, T2>::add_wq(PACKET* packet)
   address = packet->h_address;
 #if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
   // check incomplete_write_request_queue's size
-  if (os_transparent_management.incomplete_write_request_queue.size() >= INCOMPLETE_WRITE_REQUEST_QUEUE_LENGTH)
+  if (colocated_line_location_table().incomplete_write_request_queue.size() >= INCOMPLETE_WRITE_REQUEST_QUEUE_LENGTH)
   {
     return int(ReturnValue::Full);
   }
 
   address = packet->h_address_fm; // pretend to access the Location Entry and Data (LEAD) in fast memory
-  Request request(address, Request::Type::READ, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), *packet, packet->cpu, memory_id);
-  stall = !memory.send(request);
+  stall = !send_read_request(memory, address, *packet, memory_id);
 
   if (stall == false)
   {
-    OS_TRANSPARENT_MANAGEMENT::WriteRequest write_request;
+    CAMEO::WriteRequest write_request;
     // create new write_request
     write_request.packet = *packet;
     write_request.fm_access_finish = false;
 
-    os_transparent_management.incomplete_write_request_queue.push_back(write_request);
+    colocated_line_location_table().incomplete_write_request_queue.push_back(write_request);
 
-    return get_occupancy(type, packet->address);
+    return get_occupancy(type, location);
   }
   else
   {
@@ -741,7 +1207,7 @@ int MEMORY_CONTROLLER<T, T2>::add_wq(PACKET* packet)
   // assign the request to the right memory.
   if (address < memory.max_address)
   {
-    Request request(address, Request::Type::WRITE, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), *packet, packet->cpu, memory_id);
+    Request request(address, Request::Type::WRITE, return_data_callback, Request::NO_PACKET, packet->cpu, memory_id);
     stall = !memory.send(request);
 
     if (stall == false)
@@ -752,7 +1218,7 @@ int MEMORY_CONTROLLER<T, T2>::add_wq(PACKET* packet)
   else if (address < memory.max_address + memory2.max_address)
   {
     // the memory itself doesn't know other memories' space, so we manage the overall mapping.
-    Request request(address - memory.max_address, Request::Type::WRITE, std::bind(&MEMORY_CONTROLLER<T, T2>::return_data, this, placeholders::_1), *packet, packet->cpu, memory2_id);
+    Request request(address - memory.max_address, Request::Type::WRITE, return_data_callback, Request::NO_PACKET, packet->cpu, memory2_id);
     stall = !memory2.send(request);
 
     if (stall == false)
@@ -766,8 +1232,11 @@ int MEMORY_CONTROLLER<T, T2>::add_wq(PACKET* packet)
   }
 
 #if (PRINT_MEMORY_TRACE == ENABLE)
-  // output memory trace.
-  output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'W');
+  // output memory trace, a request rejected by a full queue is written when it is sent again.
+  if (stall == false)
+  {
+    output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'W', current_cycle);
+  }
 #endif  // PRINT_MEMORY_TRACE
 
   if (stall == true)
@@ -776,7 +1245,7 @@ int MEMORY_CONTROLLER<T, T2>::add_wq(PACKET* packet)
   }
   else
   {
-    return get_occupancy(type, packet->address);
+    return get_occupancy(type, location);
   }
 };
 
@@ -789,70 +1258,75 @@ int MEMORY_CONTROLLER<T, T2>::add_pq(PACKET* packet)
 template<class T, class T2>
 uint32_t MEMORY_CONTROLLER<T, T2>::get_occupancy(uint8_t queue_type, uint64_t address)
 {
-  Request::Type type = Request::Type::READ;
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+  visit_os_transparent_management([&address](auto& policy) { policy.physical_to_hardware_address(address); });
+#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 
-  if (queue_type == 1)
-    type = Request::Type::READ;
-  else if (queue_type == 2)
-    type = Request::Type::WRITE;
-  else if (queue_type == 3)
-    return get_occupancy(1, address);
+  return get_occupancy(queue_type, get_queue_location(address));
+};
 
+template<class T, class T2>
+uint32_t MEMORY_CONTROLLER<T, T2>::get_size(uint8_t queue_type, uint64_t address)
+{
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-  os_transparent_management.physical_to_hardware_address(address);
+  visit_os_transparent_management([&address](auto& policy) { policy.physical_to_hardware_address(address); });
 #endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 
-  // assign the request to the right memory.
+  return get_size(queue_type, get_queue_location(address));
+};
+
+template<class T, class T2>
+typename MEMORY_CONTROLLER<T, T2>::QUEUE_LOCATION MEMORY_CONTROLLER<T, T2>::get_queue_location(uint64_t address)
+{
+  QUEUE_LOCATION location;
+
+  // assign the address to the right memory.
   if (address < memory.max_address)
   {
-    Request request(address, type);
-    return memory.get_queue_occupancy(request);
+    location.memory_id = memory_id;
+    location.channel = memory.get_channel_index(address);
   }
   else if (address < memory.max_address + memory2.max_address)
   {
     // the memory itself doesn't know other memories' space, so we manage the overall mapping.
-    Request request(address - memory.max_address, type);
-    return memory2.get_queue_occupancy(request);
+    location.memory_id = memory2_id;
+    location.channel = memory2.get_channel_index(address - memory.max_address);
   }
   else
   {
     printf("%s: Error!\n", __FUNCTION__);
   }
 
-  return 0;
+  return location;
 };
 
 template<class T, class T2>
-uint32_t MEMORY_CONTROLLER<T, T2>::get_size(uint8_t queue_type, uint64_t address)
+uint32_t MEMORY_CONTROLLER<T, T2>::get_occupancy(uint8_t queue_type, const QUEUE_LOCATION& location)
 {
-  Request::Type type = Request::Type::READ;
-
-  if (queue_type == 1)
-    type = Request::Type::READ;
-  else if (queue_type == 2)
-    type = Request::Type::WRITE;
-  else if (queue_type == 3)
-    return get_size(1, address);
-
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-  os_transparent_management.physical_to_hardware_address(address);
-#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
-
-  // assign the request to the right memory.
-  if (address < memory.max_address)
+  switch (location.memory_id)
   {
-    Request request(address, type);
-    return memory.get_queue_size(request);
-  }
-  else if (address < memory.max_address + memory2.max_address)
-  {
-    // the memory itself doesn't know other memories' space, so we manage the overall mapping.
-    Request request(address - memory.max_address, type);
-    return memory2.get_queue_size(request);
+  case MEMORY_NUMBER_ONE:
+    return memory.get_queue_occupancy(location.channel, get_request_type(queue_type));
+  case MEMORY_NUMBER_TWO:
+    return memory2.get_queue_occupancy(location.channel, get_request_type(queue_type));
+  default:
+    break;
   }
-  else
+
+  return 0;
+};
+
+template<class T, class T2>
+uint32_t MEMORY_CONTROLLER<T, T2>::get_size(uint8_t queue_type, const QUEUE_LOCATION& location)
+{
+  switch (location.memory_id)
   {
-    printf("%s: Error!\n", __FUNCTION__);
+  case MEMORY_NUMBER_ONE:
+    return memory.get_queue_size(location.channel, get_request_type(queue_type));
+  case MEMORY_NUMBER_TWO:
+    return memory2.get_queue_size(location.channel, get_request_type(queue_type));
+  default:
+    break;
   }
 
   return 0;
@@ -878,44 +1352,66 @@ void MEMORY_CONTROLLER<T, T2>::return_data(Request& request)
   break;
   }
 
+  if (request.packet_index == Request::NO_PACKET)
+  {
+    return; // write requests don't return data.
+  }
+  PACKET& packet = packet_pool[request.packet_index];
+
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE) && (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
   bool finish_return_data = false;
 
   if (uint64_t(request.addr) < memory.max_address)
   {
     // this could be an uncomplete write request
-    bool finish = os_transparent_management.finish_fm_access_in_incomplete_write_request_queue(request.packet.h_address);
+    bool finish = colocated_line_location_table().finish_fm_access_in_incomplete_write_request_queue(packet.h_address);
     if (finish)
     {
       finish_return_data = true;
-      return;
     }
   }
 
-  if ((uint64_t(request.addr) < memory.max_address) && (memory.max_address <= request.packet.h_address))
+  if ((finish_return_data == false) && (uint64_t(request.addr) < memory.max_address) && (memory.max_address <= packet.h_address))
   {
     // this could be an uncomplete read request
-    bool finish = os_transparent_management.finish_fm_access_in_incomplete_read_request_queue(request.packet.h_address);
+    bool finish = colocated_line_location_table().finish_fm_access_in_incomplete_read_request_queue(packet.h_address);
 
     if (finish)
     {
       finish_return_data = true;
-      return;
     }
   }
 
   if (finish_return_data == false)
   {
     // this is a complete read request
-    for (auto ret : request.packet.to_return)
-      ret->return_data(&(request.packet));
+    for (auto ret : packet.to_return)
+      ret->return_data(&packet);
   }
 
 #else
-  for (auto ret : request.packet.to_return)
-    ret->return_data(&(request.packet));
+  for (auto ret : packet.to_return)
+    ret->return_data(&packet);
 #endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT && COLOCATED_LINE_LOCATION_TABLE
 
+  packet_pool.release(request.packet_index);
+};
+
+template<class T, class T2>
+template<typename MEMORY>
+bool MEMORY_CONTROLLER<T, T2>::send_read_request(MEMORY& target_memory, uint64_t address, const PACKET& packet, uint8_t target_memory_id)
+{
+  uint32_t packet_index = packet_pool.acquire();
+  Request request(address, Request::Type::READ, return_data_callback, packet_index, packet.cpu, target_memory_id);
+
+  if (target_memory.send(request))
+  {
+    packet_pool[packet_index] = packet;
+    return true;
+  }
+
+  packet_pool.release(packet_index);
+  return false;
 };
 
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
@@ -1029,13 +1525,13 @@ uint8_t MEMORY_CONTROLLER<T, T2>::operate_swapping()
             // assign the request to the right memory.
             if (address < memory.max_address)
             {
-              Request request(address, Request::Type::READ, std::bind(&MEMORY_CONTROLLER<T, T2>::return_swapping_data, this, placeholders::_1), coreid, memory_id);
+              Request request(address, Request::Type::READ, return_swapping_data_callback, coreid, memory_id);
               stall = !memory.send(request);
             }
             else if (address < memory.max_address + memory2.max_address)
             {
               // the memory itself doesn't know other memories' space, so we manage the overall mapping.
-              Request request(address - memory.max_address, Request::Type::READ, std::bind(&MEMORY_CONTROLLER<T, T2>::return_swapping_data, this, placeholders::_1), coreid, memory2_id);
+              Request request(address - memory.max_address, Request::Type::READ, return_swapping_data_callback, coreid, memory2_id);
               stall = !memory2.send(request);
             }
             else
@@ -1044,8 +1540,11 @@ uint8_t MEMORY_CONTROLLER<T, T2>::operate_swapping()
             }
 
 #if (PRINT_MEMORY_TRACE == ENABLE)
-            // output memory trace.
-            output_memorytrace.output_memory_trace_hexadecimal(address, 'R');
+            // output memory trace, the requests of the swapping unit are in lowercase.
+            if (stall == false)
+            {
+              output_memorytrace.output_memory_trace_hexadecimal(address, 'r', current_cycle);
+            }
 #endif  // PRINT_MEMORY_TRACE
 
             if (stall == true)
@@ -1079,16 +1578,12 @@ uint8_t MEMORY_CONTROLLER<T, T2>::operate_swapping()
               if (address < memory.max_address)
               {
                 Request request(address, Request::Type::WRITE, NULL, coreid, memory_id);
-                // get data from buffer
-                request.data = buffer[i].data[j];
                 stall = !memory.send(request);
               }
               else if (address < memory.max_address + memory2.max_address)
               {
                 // the memory itself doesn't know other memories' space, so we manage the overall mapping.
                 Request request(address - memory.max_address, Request::Type::WRITE, NULL, coreid, memory2_id);
-                // get data from buffer
-                request.data = buffer[i].data[j];
                 stall = !memory2.send(request);
               }
               else
@@ -1097,8 +1592,11 @@ uint8_t MEMORY_CONTROLLER<T, T2>::operate_swapping()
               }
 
 #if (PRINT_MEMORY_TRACE == ENABLE)
-              // output memory trace.
-              output_memorytrace.output_memory_trace_hexadecimal(address, 'W');
+              // output memory trace, the requests of the swapping unit are in lowercase.
+              if (stall == false)
+              {
+                output_memorytrace.output_memory_trace_hexadecimal(address, 'w', current_cycle);
+              }
 #endif  // PRINT_MEMORY_TRACE
 
               if (stall == true)
@@ -1182,6 +1680,7 @@ void MEMORY_CONTROLLER<T, T2>::return_swapping_data(Request& request)
   uint64_t address = request.addr >> LOG2_BLOCK_SIZE;
   uint8_t segment_index;
   uint8_t entry_index;
+  std::array<uint8_t, BLOCK_SIZE> data = {0}; // Ramulator doesn't model data, so the returned cache line is zeroed.
   // calculate entry index in the fashion of little-endian.
   if ((base_address[SWAPPING_SEGMENT_ONE] <= address) && (address < (base_address[SWAPPING_SEGMENT_ONE] + active_entry_number)))
   {
@@ -1189,7 +1688,7 @@ void MEMORY_CONTROLLER<T, T2>::return_swapping_data(Request& request)
     entry_index = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_ONE]);
 
 #if (TEST_SWAPPING_UNIT == ENABLE)
-    request.data = memory_data[entry_index];
+    data = memory_data[entry_index];
 #endif  // TEST_SWAPPING_UNIT
   }
   else if ((base_address[SWAPPING_SEGMENT_TWO] <= address) && (address < (base_address[SWAPPING_SEGMENT_TWO] + active_entry_number)))
@@ -1198,7 +1697,7 @@ void MEMORY_CONTROLLER<T, T2>::return_swapping_data(Request& request)
     entry_index = static_cast<uint8_t>(address - base_address[SWAPPING_SEGMENT_TWO]);
 
 #if (TEST_SWAPPING_UNIT == ENABLE)
-    request.data = memory_data[entry_index + MEMORY_DATA_NUMBER / 2];
+    data = memory_data[entry_index + MEMORY_DATA_NUMBER / 2];
 #endif  // TEST_SWAPPING_UNIT
   }
   else
@@ -1210,7 +1709,7 @@ void MEMORY_CONTROLLER<T, T2>::return_swapping_data(Request& request)
   // Read data
   if ((buffer[entry_index].finish == false) && (buffer[entry_index].write[segment_index] == false) && (buffer[entry_index].dirty[segment_index] == false))
   {
-    buffer[entry_index].data[segment_index] = request.data;
+    buffer[entry_index].data[segment_index] = data;
     buffer[entry_index].read[segment_index] = true;
   }
 };
@@ -1284,7 +1783,7 @@ template<class T, class T2>
 uint8_t MEMORY_CONTROLLER<T, T2>::check_address(uint64_t address, uint8_t type)
 {
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
-  os_transparent_management.physical_to_hardware_address(address);
+  visit_os_transparent_management([&address](auto& policy) { policy.physical_to_hardware_address(address); });
 #else
 #endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 
@@ -1339,12 +1838,19 @@ class MEMORY_CONTROLLER: public champsim::operable, public MemoryRequestConsumer
 public:
   /* General part */
   double clock_scale = MEMORY_CONTROLLER_CLOCK_SCALE;
+  double leap_operation_memory = 0;  // the memory skips the processor's cycles periodically
 
   // Note here they are the references to escape memory deallocation here.
   ramulator::Memory<T, Controller>& memory;
 
   const uint8_t memory_id = 0;
 
+  // packets of the in-flight read requests, Ramulator's requests only carry their indexes.
+  PACKET_POOL packet_pool;
+
+  // a lambda capturing only this is stored inside std::function, so copying it with every request doesn't allocate.
+  const std::function<void(Request&)> return_data_callback = [this](Request& request) { return_data(request); };
+
   uint64_t read_request_in_memory;
   uint64_t write_request_in_memory;
 
@@ -1355,6 +1861,17 @@ public:
   void operate() override;
   void print_deadlock() override;
 
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+  // the memory controller is idle when the memory's queues are empty, until a read completes or a refresh is due.
+  uint64_t idle_cycles(uint64_t limit) override;
+  void skip_cycles(uint64_t cycles) override;
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  // save or restore the tables of the research proposals, the requests in the memories are not saved.
+  void checkpoint(CHECKPOINT& checkpoint);
+#endif  // SIMULATION_USE_CHECKPOINT
+
   int add_rq(PACKET* packet) override;
   int add_wq(PACKET* packet) override;
   int add_pq(PACKET* packet) override;
@@ -1372,6 +1889,11 @@ public:
   uint32_t get_size(uint8_t queue_type, uint64_t address) override;
 
   void return_data(Request& request);
+
+  /** @brief
+   *  Send a read request into the memory, the packet is kept in packet_pool until return_data().
+   */
+  bool send_read_request(Memory<T, Controller>& target_memory, uint64_t address, const PACKET& packet, uint8_t target_memory_id);
 };
 
 template<class T>
@@ -1395,27 +1917,87 @@ template<class T>
 void MEMORY_CONTROLLER<T>::operate()
 {
   /* Operate memories below */
-  static double leap_operation = 0;
   // skip periodically
-  if (leap_operation >= 1)
+  if (leap_operation_memory >= 1)
   {
-    leap_operation -= 1;
+    leap_operation_memory -= 1;
   }
   else
   {
     memory.tick();
-    leap_operation += clock_scale;
+    leap_operation_memory += clock_scale;
   }
 
   Stats::curTick++; // processor clock, global, for Statistics
 };
 
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+template<class T>
+uint64_t MEMORY_CONTROLLER<T>::idle_cycles(uint64_t limit)
+{
+  // count the processor's cycles until the memory ticks with work to do
+  const long idle_ticks = memory.idle_ticks(std::numeric_limits<long>::max());
+  double leap_operation = leap_operation_memory;
+  long ticks = 0;
+  uint64_t cycles = 0;
+  for (; cycles < limit; cycles++)
+  {
+    if (leap_operation >= 1)
+    {
+      leap_operation -= 1;
+    }
+    else if (ticks == idle_ticks)
+    {
+      break;
+    }
+    else
+    {
+      ticks++;
+      leap_operation += clock_scale;
+    }
+  }
+
+  return cycles;
+};
+
+template<class T>
+void MEMORY_CONTROLLER<T>::skip_cycles(uint64_t cycles)
+{
+  long ticks = 0;
+  for (uint64_t i = 0; i < cycles; i++)
+  {
+    if (leap_operation_memory >= 1)
+    {
+      leap_operation_memory -= 1;
+    }
+    else
+    {
+      ticks++;
+      leap_operation_memory += clock_scale;
+    }
+  }
+
+  memory.skip_ticks(ticks);
+
+  Stats::curTick += cycles; // processor clock, global, for Statistics
+  champsim::operable::skip_cycles(cycles);
+};
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
 template<class T>
 void MEMORY_CONTROLLER<T>::print_deadlock()
 {
   printf("MEMORY_CONTROLLER print_deadlock().\n");
 };
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+template<class T>
+void MEMORY_CONTROLLER<T>::checkpoint(CHECKPOINT& checkpoint)
+{
+  checkpoint.section("MEMORY_CONTROLLER");
+};
+#endif  // SIMULATION_USE_CHECKPOINT
+
 template<class T>
 int MEMORY_CONTROLLER<T>::add_rq(PACKET* packet)
 {
@@ -1437,8 +2019,7 @@ int MEMORY_CONTROLLER<T>::add_rq(PACKET* packet)
   // assign the request to the right memory.
   if (address < memory.max_address)
   {
-    Request request(address, Request::Type::READ, std::bind(&MEMORY_CONTROLLER<T>::return_data, this, placeholders::_1), *packet, packet->cpu, memory_id);
-    stall = !memory.send(request);
+    stall = !send_read_request(memory, address, *packet, memory_id);
 
     if (stall == false)
     {
@@ -1451,8 +2032,11 @@ int MEMORY_CONTROLLER<T>::add_rq(PACKET* packet)
   }
 
 #if (PRINT_MEMORY_TRACE == ENABLE)
-  // output memory trace.
-  output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'R');
+  // output memory trace, a request rejected by a full queue is written when it is sent again.
+  if (stall == false)
+  {
+    output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'R', current_cycle);
+  }
 #endif  // PRINT_MEMORY_TRACE
 
   if (stall == true)
@@ -1480,7 +2064,7 @@ int MEMORY_CONTROLLER<T>::add_wq(PACKET* packet)
   // assign the request to the right memory.
   if (address < memory.max_address)
   {
-    Request request(address, Request::Type::WRITE, std::bind(&MEMORY_CONTROLLER<T>::return_data, this, placeholders::_1), *packet, packet->cpu, memory_id);
+    Request request(address, Request::Type::WRITE, return_data_callback, Request::NO_PACKET, packet->cpu, memory_id);
     stall = !memory.send(request);
 
     if (stall == false)
@@ -1494,8 +2078,11 @@ int MEMORY_CONTROLLER<T>::add_wq(PACKET* packet)
   }
 
 #if (PRINT_MEMORY_TRACE == ENABLE)
-  // output memory trace.
-  output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'W');
+  // output memory trace, a request rejected by a full queue is written when it is sent again.
+  if (stall == false)
+  {
+    output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'W', current_cycle);
+  }
 #endif  // PRINT_MEMORY_TRACE
 
   if (stall == true)
@@ -1517,20 +2104,10 @@ int MEMORY_CONTROLLER<T>::add_pq(PACKET* packet)
 template<class T>
 uint32_t MEMORY_CONTROLLER<T>::get_occupancy(uint8_t queue_type, uint64_t address)
 {
-  Request::Type type = Request::Type::READ;
-
-  if (queue_type == 1)
-    type = Request::Type::READ;
-  else if (queue_type == 2)
-    type = Request::Type::WRITE;
-  else if (queue_type == 3)
-    return get_occupancy(1, address);
-
   // assign the request to the right memory.
   if (address < memory.max_address)
   {
-    Request request(address, type);
-    return memory.get_queue_occupancy(request);
+    return memory.get_queue_occupancy(memory.get_channel_index(address), get_request_type(queue_type));
   }
   else
   {
@@ -1543,20 +2120,10 @@ uint32_t MEMORY_CONTROLLER<T>::get_occupancy(uint8_t queue_type, uint64_t addres
 template<class T>
 uint32_t MEMORY_CONTROLLER<T>::get_size(uint8_t queue_type, uint64_t address)
 {
-  Request::Type type = Request::Type::READ;
-
-  if (queue_type == 1)
-    type = Request::Type::READ;
-  else if (queue_type == 2)
-    type = Request::Type::WRITE;
-  else if (queue_type == 3)
-    return get_size(1, address);
-
   // assign the request to the right memory.
   if (address < memory.max_address)
   {
-    Request request(address, type);
-    return memory.get_queue_size(request);
+    return memory.get_queue_size(memory.get_channel_index(address), get_request_type(queue_type));
   }
   else
   {
@@ -1569,8 +2136,32 @@ uint32_t MEMORY_CONTROLLER<T>::get_size(uint8_t queue_type, uint64_t address)
 template<class T>
 void MEMORY_CONTROLLER<T>::return_data(Request& request)
 {
-  for (auto ret : request.packet.to_return)
-    ret->return_data(&(request.packet));
+  if (request.packet_index == Request::NO_PACKET)
+  {
+    return; // write requests don't return data.
+  }
+  PACKET& packet = packet_pool[request.packet_index];
+
+  for (auto ret : packet.to_return)
+    ret->return_data(&packet);
+
+  packet_pool.release(request.packet_index);
+};
+
+template<class T>
+bool MEMORY_CONTROLLER<T>::send_read_request(Memory<T, Controller>& target_memory, uint64_t address, const PACKET& packet, uint8_t target_memory_id)
+{
+  uint32_t packet_index = packet_pool.acquire();
+  Request request(address, Request::Type::READ, return_data_callback, packet_index, packet.cpu, target_memory_id);
+
+  if (target_memory.send(request))
+  {
+    packet_pool[packet_index] = packet;
+    return true;
+  }
+
+  packet_pool.release(packet_index);
+  return false;
 };
 #endif  // MEMORY_USE_HYBRID
 #else
@@ -88,6 +88,23 @@ struct ooo_model_instr
     asid[1] = cpu;
   }
 
+#if (USER_CODES == ENABLE)
+  ooo_model_instr(uint8_t cpu, compact_instr instr)
+  {
+    std::copy(std::begin(instr.destination_registers), std::end(instr.destination_registers), std::begin(this->destination_registers));
+    std::copy(std::begin(instr.destination_memory), std::end(instr.destination_memory), std::begin(this->destination_memory));
+    std::copy(std::begin(instr.source_registers), std::end(instr.source_registers), std::begin(this->source_registers));
+    std::copy(std::begin(instr.source_memory), std::end(instr.source_memory), std::begin(this->source_memory));
+
+    this->ip = instr.ip;
+    this->is_branch = instr.is_branch;
+    this->branch_taken = instr.branch_taken;
+
+    asid[0] = cpu;
+    asid[1] = cpu;
+  }
+#endif // USER_CODES
+
   ooo_model_instr(uint8_t cpu, cloudsuite_instr instr)
   {
     std::copy(std::begin(instr.destination_registers), std::end(instr.destination_registers), std::begin(this->destination_registers));
@@ -103,4 +120,21 @@ struct ooo_model_instr
   }
 };
 
+#if (USER_CODES == ENABLE)
+#define TRACE_BATCH_SIZE (256u) // number of instructions decoded from the trace at once
+
+/** @brief
+ *  A batch of instructions decoded in place by tracereader::get_batch() and consumed by O3_CPU::init_instructions().
+ *  The buffer is allocated once, so the front-end moves instructions instead of copying them out of the trace reader.
+ */
+struct ooo_model_instr_batch
+{
+  std::vector<ooo_model_instr> instrs = std::vector<ooo_model_instr>(TRACE_BATCH_SIZE);
+  std::size_t position = 0; // index of the next instruction to consume
+  std::size_t size = 0;     // number of valid instructions in instrs
+
+  bool empty() const { return position == size; }
+};
+#endif // USER_CODES
+
 #endif
@@ -31,6 +31,9 @@
 using namespace std;
 
 class CACHE;
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+class CHECKPOINT;
+#endif // SIMULATION_USE_CHECKPOINT
 
 class CacheBus : public MemoryRequestProducer
 {
@@ -104,6 +107,9 @@ public:
 
   // functions
   void init_instruction(ooo_model_instr instr);
+#if (USER_CODES == ENABLE)
+  void init_instructions(ooo_model_instr_batch& batch);
+#endif // USER_CODES
   void check_dib();
   void translate_fetch();
   void fetch_instruction();
@@ -140,6 +146,15 @@ public:
 
   void print_deadlock() override;
 
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+  /** @brief
+   *  The core is idle when no stage can move an instruction, e.g., the ROB is full and its head waits for the memories.
+   *  The completion of an executing instruction and the end of a fetch stall are the events that end the idle cycles.
+   */
+  uint64_t idle_cycles(uint64_t limit) override;
+  void skip_cycles(uint64_t cycles) override;
+#endif // SIMULATION_USE_CLOCK_SKIPPING
+
   int prefetch_code_line(uint64_t pf_v_addr);
 
 #if (USER_CODES == ENABLE)
@@ -206,6 +221,27 @@ public:
     return 0;
   }
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  // Checkpoint for branch predictor
+  void bpred_bbranchDbimodal_checkpoint(CHECKPOINT&);
+  void bpred_bbranchDgshare_checkpoint(CHECKPOINT&);
+  void bpred_bbranchDhashed_perceptron_checkpoint(CHECKPOINT&);
+  void bpred_bbranchDperceptron_checkpoint(CHECKPOINT&);
+
+  void impl_branch_predictor_checkpoint(CHECKPOINT& checkpoint)
+  {
+    if (bpred_type == bpred_t::bbranchDbimodal) bpred_bbranchDbimodal_checkpoint(checkpoint);
+    else if (bpred_type == bpred_t::bbranchDgshare) bpred_bbranchDgshare_checkpoint(checkpoint);
+    else if (bpred_type == bpred_t::bbranchDhashed_perceptron) bpred_bbranchDhashed_perceptron_checkpoint(checkpoint);
+    else if (bpred_type == bpred_t::bbranchDperceptron) bpred_bbranchDperceptron_checkpoint(checkpoint);
+    else
+    {
+      std::cout << __func__ << ": Branch predictor module not found." << std::endl;
+      throw std::invalid_argument("Branch predictor module not found");
+    }
+  }
+#endif // SIMULATION_USE_CHECKPOINT
+
   /* Definition and declaration for branch target buffer */
   // Basic Branch Target Buffer (BTB) type selection, i.e., basic_btb.
   enum class btb_t { bbtbDbasic_btb };
@@ -249,6 +285,21 @@ public:
     }
   }
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  // Checkpoint for branch target buffer
+  void btb_bbtbDbasic_btb_checkpoint(CHECKPOINT&);
+
+  void impl_btb_checkpoint(CHECKPOINT& checkpoint)
+  {
+    if (btb_type == btb_t::bbtbDbasic_btb) btb_bbtbDbasic_btb_checkpoint(checkpoint);
+    else
+    {
+      std::cout << __func__ << ": Branch target buffer module not found." << std::endl;
+      throw std::invalid_argument("Branch target buffer module not found");
+    }
+  }
+#endif // SIMULATION_USE_CHECKPOINT
+
   /* Definition and declaration for instruction prefetcher */
   // Instruction prefetcher type selection, i.e., no_instr, next_line_instr.
   enum class ipref_t { pprefetcherDno_instr, pprefetcherDnext_line_instr };
@@ -299,6 +350,18 @@ public:
   void pref_pprefetcherDno_instr_final_stats();
   void pref_pprefetcherDnext_line_instr_final_stats();
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  // Checkpoint for instruction prefetcher, it is called by the L1I like cache operate and cache fill.
+  void pref_pprefetcherDno_instr_checkpoint(CHECKPOINT&);
+  void pref_pprefetcherDnext_line_instr_checkpoint(CHECKPOINT&);
+
+  /** @brief
+   *  Save or restore the state which lasts beyond warmup, i.e., the decoded instruction buffer, the branch predictor
+   *  and the branch target buffer. The number of retired instructions is saved as the position in the trace.
+   */
+  void checkpoint(CHECKPOINT& checkpoint);
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 #include "ooo_cpu_modules.inc"
 #endif  // USER_CODES
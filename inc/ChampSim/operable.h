@@ -60,6 +60,14 @@ public:
 
   virtual void operate() = 0;
   virtual void print_deadlock() {}
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+  // the number of following cycles (at most limit) in which operate() only advances the cycle, 0 if there is work in this cycle.
+  virtual uint64_t idle_cycles(uint64_t limit) { return 0; }
+
+  // advance over the idle cycles as if operate() is called in each of them.
+  virtual void skip_cycles(uint64_t cycles) { current_cycle += cycles; }
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
 };
 
 class by_next_operate
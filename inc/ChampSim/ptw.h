@@ -32,6 +32,10 @@
 #include "vmem.h"
 #endif
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+class CHECKPOINT;
+#endif // SIMULATION_USE_CHECKPOINT
+
 class PagingStructureCache
 {
   struct block_t
@@ -54,6 +58,10 @@ public:
 
   std::optional<uint64_t> check_hit(uint64_t address);
   void fill_cache(uint64_t next_level_paddr, uint64_t vaddr);
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  void checkpoint(CHECKPOINT& checkpoint);
+#endif // SIMULATION_USE_CHECKPOINT
 };
 
 class PageTableWalker : public champsim::operable, public MemoryRequestConsumer, public MemoryRequestProducer
@@ -96,6 +104,17 @@ public:
   uint64_t get_shamt(uint8_t pt_level);
 
   void print_deadlock() override;
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+  // the page table walker is idle until its next fill, or until a delayed request becomes ready.
+  uint64_t idle_cycles(uint64_t limit) override;
+  void skip_cycles(uint64_t cycles) override;
+#endif // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  // save or restore the paging structure caches.
+  void checkpoint(CHECKPOINT& checkpoint);
+#endif // SIMULATION_USE_CHECKPOINT
 };
 
 #endif
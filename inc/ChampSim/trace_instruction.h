@@ -17,8 +17,11 @@
 #ifndef TRACE_INSTRUCTION_H
 #define TRACE_INSTRUCTION_H
 
+#include <cstdint>
 #include <limits>
 
+#include "ProjectConfiguration.h" // user file
+
  // instruction format
 constexpr std::size_t NUM_INSTR_DESTINATIONS_SPARC = 4;
 constexpr std::size_t NUM_INSTR_DESTINATIONS = 2;
@@ -47,6 +50,57 @@ struct input_instr
   char function_name[256]; //256字以上の関数名は格納できません
 };
 
+#if (USER_CODES == ENABLE)
+/** @brief
+ *  Compact trace format (version 1).
+ *  The routine markers of input_instr (is_rtn_start, is_rtn_end and the 256-byte function_name) are moved out of
+ *  every instruction record. The decompressed stream is laid out as:
+ *    compact_trace_header
+ *    dictionary_size x { uint16_t length; char name[length]; }   // function-name dictionary, ids start from 0
+ *    { compact_record_type; payload } ...                          // payload is compact_instr or compact_routine_event
+ *  A routine event applies to the next instruction record, i.e., it replaces the is_rtn_start/is_rtn_end flag
+ *  of that instruction in the input_instr format.
+ */
+constexpr char COMPACT_TRACE_MAGIC[8] = {'C', 'S', 'C', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t COMPACT_TRACE_VERSION = 1;
+
+struct compact_trace_header
+{
+  char magic[8] = {};
+  uint32_t version = 0;
+  uint32_t dictionary_size = 0; // number of function names stored in the dictionary
+};
+
+enum compact_record_type : unsigned char
+{
+  COMPACT_RECORD_INSTRUCTION = 0,
+  COMPACT_RECORD_ROUTINE_START,
+  COMPACT_RECORD_ROUTINE_END
+};
+
+// the classic ChampSim instruction record without routine markers
+struct compact_instr
+{
+  // instruction pointer or PC (Program Counter)
+  unsigned long long ip = 0;
+
+  // branch info
+  unsigned char is_branch = 0;
+  unsigned char branch_taken = 0;
+
+  unsigned char destination_registers[NUM_INSTR_DESTINATIONS] = {}; // output registers
+  unsigned char source_registers[NUM_INSTR_SOURCES] = {};           // input registers
+
+  unsigned long long destination_memory[NUM_INSTR_DESTINATIONS] = {}; // output memory
+  unsigned long long source_memory[NUM_INSTR_SOURCES] = {};           // input memory
+};
+
+struct compact_routine_event
+{
+  uint32_t function_id = 0; // index into the function-name dictionary
+};
+#endif // USER_CODES
+
 struct cloudsuite_instr
 {
   // instruction pointer or PC (Program Counter)
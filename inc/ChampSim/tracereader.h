@@ -19,18 +19,60 @@
 
 #include <cstdio>
 #include <string>
+#include <vector>
 
 #include "instruction.h"
+#include "ProjectConfiguration.h" // user file
+
+#if (TRACE_USE_IN_PROCESS_DECOMPRESSION == ENABLE)
+class trace_decompressor;
+#endif // TRACE_USE_IN_PROCESS_DECOMPRESSION
 
 class tracereader
 {
 protected:
   FILE* trace_file = NULL;
+#if (TRACE_USE_IN_PROCESS_DECOMPRESSION == ENABLE)
+  trace_decompressor* decompressor = NULL; // used for local traces instead of trace_file
+#endif // TRACE_USE_IN_PROCESS_DECOMPRESSION
   uint8_t cpu;
   std::string cmd_fmtstr;
   std::string decomp_program;
   std::string trace_string;
 
+#if (USER_CODES == ENABLE)
+  std::size_t read_bytes(void* destination, std::size_t size);
+  uint64_t discard_bytes(uint64_t size);
+
+  bool is_compact_trace = false;                  // whether the trace uses the compact format (detected in open())
+  std::vector<std::string> function_dictionary;   // function names stored in the header of a compact trace
+
+  bool read_compact_header();
+
+  ooo_model_instr_batch batch; // instructions decoded ahead by get_batch()
+
+  /* Trace seeking */
+  std::size_t record_size = 0;      // size of an instruction record in a trace which is not compact
+  uint64_t stream_offset = 0;       // decompressed bytes consumed since open()
+  uint64_t next_record = 0;         // index of the next instruction record read since open()
+  uint64_t record_number = 0;       // number of instruction records in the trace, 0 if it is unknown yet
+
+  // decompressed offset of every TRACE_INDEX_INTERVAL-th instruction record of a compact trace, see load_trace_index().
+  std::vector<uint64_t> trace_index;
+
+  void load_trace_index();
+  void build_trace_index();
+
+  // move the decompressed stream forward or backward to offset, return false if the trace is shorter.
+  bool reposition(uint64_t offset);
+
+  // position the trace so that the next instruction record read is record, it wraps around like reading does.
+  void seek_record(uint64_t record);
+
+  // skip the next number instructions get_batch() would deliver after the batch is consumed.
+  virtual void skip_undecoded_instructions(uint64_t number) = 0;
+#endif // USER_CODES
+
 public:
   tracereader(const tracereader& other) = delete;
   tracereader(uint8_t cpu, std::string _ts);
@@ -41,7 +83,25 @@ public:
   template <typename T>
   ooo_model_instr read_single_instr();
 
+#if (USER_CODES == ENABLE)
+  ooo_model_instr read_compact_instr();
+#endif // USER_CODES
+
   virtual ooo_model_instr get() = 0;
+
+#if (USER_CODES == ENABLE)
+  // return the batch of decoded instructions, it is refilled in place once all instructions are consumed.
+  // Note get() and get_batch() should not be mixed, because the batch is decoded ahead of get().
+  virtual ooo_model_instr_batch& get_batch() = 0;
+
+  /** @brief
+   *  Consume the next number instructions of the trace without delivering them (e.g., --skip_instructions and the
+   *  instructions retired before a checkpoint). The skipped instructions are not decoded: a fixed-size trace jumps to
+   *  the computed offset and a compact trace jumps through its trace index. Decompression itself starts at the xz
+   *  block holding that offset if the trace has several blocks, otherwise the skipped bytes are still decompressed.
+   */
+  void skip_instructions(uint64_t number);
+#endif // USER_CODES
 };
 
 tracereader* get_tracereader(std::string fname, uint8_t cpu, bool is_cloudsuite);
@@ -17,30 +17,109 @@
 #ifndef VMEM_H
 #define VMEM_H
 
+#include <array>
 #include <cstdint>
-#include <deque>
-#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "champsim_constants.h"
 #include "ProjectConfiguration.h" // user file
 
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+#include <mutex>
+#endif // SIMULATION_USE_PARALLEL_CORES
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+class CHECKPOINT;
+#endif // SIMULATION_USE_CHECKPOINT
+
 // reserve 1MB of space
 #define VMEM_RESERVE_CAPACITY 1048576
 
 #define PTE_BYTES 8
 
+#define PPAGE_FEISTEL_ROUNDS 4
+
+// every core takes its pages from its own stream, so the pages of a core don't depend on the timing of the other cores.
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE) && (PARALLEL_CORES_DETERMINISTIC == ENABLE)
+#define PPAGE_STREAM_NUMBER NUM_CPUS
+#else
+#define PPAGE_STREAM_NUMBER 1
+#endif // SIMULATION_USE_PARALLEL_CORES, PARALLEL_CORES_DETERMINISTIC
+
+/** @brief
+ *  Free physical pages handed out in a random order without materialising a shuffled list.
+ *  The n-th page popped is first_ppage + permute(n) * PAGE_SIZE, where permute() is a bijection over the page
+ *  index range. It is built from a Feistel network over the smallest even-width power of two covering the range,
+ *  keyed by the random seed, and walks the cycle until the result falls back into the range.
+ *  The pages can be handed out in several interleaved streams, the n-th page of stream s is the (s + n * streams)-th
+ *  page of the permutation.
+ */
+class PPAGE_FREE_LIST
+{
+public:
+  PPAGE_FREE_LIST(uint64_t first_ppage, uint64_t ppage_number, uint64_t random_seed, uint32_t stream_number = 1);
+
+  uint64_t front(uint32_t stream = 0) const { return current_ppages[stream]; }
+  void pop_front(uint32_t stream = 0);
+  std::size_t size() const { return ppage_number - popped_number; }
+  bool empty(uint32_t stream = 0) const { return next_indexes[stream] >= ppage_number; }
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  // the permutation is rebuilt from the seed, so only the position in it is saved.
+  void checkpoint(CHECKPOINT& checkpoint);
+#endif // SIMULATION_USE_CHECKPOINT
+
+private:
+  uint64_t permute(uint64_t index) const;
+
+  const uint64_t first_ppage, ppage_number;
+  const uint32_t stream_number;
+  uint64_t popped_number = 0;
+  std::vector<uint64_t> next_indexes, current_ppages;
+  uint32_t half_bits = 1;
+  std::array<uint64_t, PPAGE_FEISTEL_ROUNDS> round_keys;
+};
+
+// hash for the keys of the page tables, the keys are small tuples of integers.
+struct vmem_key_hash
+{
+  static uint64_t mix(uint64_t x)
+  {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    return x;
+  }
+
+  std::size_t operator()(const std::pair<uint32_t, uint64_t>& key) const { return mix(key.second ^ (uint64_t(key.first) << 52)); }
+  std::size_t operator()(const std::tuple<uint32_t, uint64_t, uint32_t>& key) const
+  {
+    return mix(std::get<1>(key) ^ (uint64_t(std::get<0>(key)) << 52) ^ (uint64_t(std::get<2>(key)) << 44));
+  }
+};
+
 class VirtualMemory
 {
 private:
-  std::map<std::pair<uint32_t, uint64_t>, uint64_t> vpage_to_ppage_map;
-  std::map<std::tuple<uint32_t, uint64_t, uint32_t>, uint64_t> page_table;
+  std::unordered_map<std::pair<uint32_t, uint64_t>, uint64_t, vmem_key_hash> vpage_to_ppage_map;
+  std::unordered_map<std::tuple<uint32_t, uint64_t, uint32_t>, uint64_t, vmem_key_hash> page_table;
+
+  std::vector<uint64_t> next_pte_pages;  // one for each page stream
 
-  uint64_t next_pte_page;
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+  std::mutex mutex;  // the page table walkers of the cores translate addresses on their own threads
+#endif // SIMULATION_USE_PARALLEL_CORES
+
+  uint32_t ppage_stream(uint32_t cpu_num) const { return cpu_num % PPAGE_STREAM_NUMBER; }
 
 public:
   const uint64_t minor_fault_penalty;
   const uint32_t pt_levels;
   const uint32_t page_size; // Size of a PTE page
-  std::deque<uint64_t> ppage_free_list;
+  PPAGE_FREE_LIST ppage_free_list;
 
   // capacity and pg_size are measured in bytes, and capacity must be a multiple
   // of pg_size
@@ -49,6 +128,10 @@ public:
   uint64_t get_offset(uint64_t vaddr, uint32_t level) const;
   std::pair<uint64_t, bool> va_to_pa(uint32_t cpu_num, uint64_t vaddr);
   std::pair<uint64_t, bool> get_pte_pa(uint32_t cpu_num, uint64_t vaddr, uint32_t level);
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  void checkpoint(CHECKPOINT& checkpoint);
+#endif // SIMULATION_USE_CHECKPOINT
 };
 
 #endif
@@ -18,6 +18,17 @@
 #define MEMORY_USE_SWAPPING_UNIT                   (ENABLE) // whether memory controller uses swapping unit to swap data (data swapping overhead is considered)
 #define MEMORY_USE_OS_TRANSPARENT_MANAGEMENT       (ENABLE) // whether memory controller uses OS-transparent management designs to simulate the memory system instead of static (no-migration) methods
 #define CPU_USE_MULTIPLE_CORES                     (DISABLE) // whether CPU uses multiple cores to run simulation (go to ./inc/ChampSim/champsim_constants.h to check related parameters)
+#define TRACE_USE_IN_PROCESS_DECOMPRESSION         (ENABLE) // whether decompress local traces in-process (liblzma/zlib) on a background thread instead of a popen pipe (link with -llzma -lz)
+#define SIMULATION_USE_CHECKPOINT                  (ENABLE) // whether the simulator can save its state after warmup into a checkpoint file (--save_checkpoint) and start from it later (--load_checkpoint), only for ChampSim + Ramulator
+#define SIMULATION_USE_CLOCK_SKIPPING              (ENABLE) // whether the simulator jumps over the cycles in which every component only waits (e.g., all cores wait for the memories), the results are not changed, only for ChampSim + Ramulator
+#define SIMULATION_USE_PARALLEL_CORES              (DISABLE) // whether the private hierarchy of each core runs on its own OpenMP thread and meets the shared LLC at the end of each quantum, only for ChampSim + Ramulator with multiple cores
+#define MEMORY_USE_PARALLEL_TICKING                (DISABLE) // whether the memory controller ticks the two memories of the hybrid memory system on two OpenMP threads, the results are not changed, only for ChampSim + Ramulator
+#define MEMORY_USE_PARALLEL_CHANNELS               (DISABLE) // whether each Ramulator memory ticks the controllers of its channels on OpenMP threads, the results are not changed, only for ChampSim + Ramulator
+#define MEMORY_USE_BANK_INDEXED_SCHEDULER          (ENABLE) // whether Ramulator's scheduler keeps the requests of each queue by bank and evaluates each row once per issued command instead of scanning the whole queue every cycle, the results are not changed, only for ChampSim + Ramulator
+#define MEMORY_USE_FLAT_DRAM_TIMING                (ENABLE) // whether Ramulator's DRAM nodes update their timing from flattened per-level tables and keep the opened rows in small arrays, the results are not changed, only for ChampSim + Ramulator
+#define MEMORY_USE_POOLED_REQUEST_QUEUES           (ENABLE) // whether Ramulator's controllers keep their requests in preallocated slabs with index links instead of std::list and std::deque, the results are not changed, only for ChampSim + Ramulator
+#define MEMORY_USE_SCHEDULED_REFRESH               (ENABLE) // whether Ramulator's controllers only call the refresh scheduler when its next refresh is due instead of in every tick, the results are not changed, only for ChampSim + Ramulator
+#define MEMORY_USE_IDLE_CHANNEL_FAST_PATH          (ENABLE) // whether an idle channel of Ramulator only counts the cycles until its next refresh, precharge, or request instead of running the scheduler in every tick, the results are not changed, only for ChampSim + Ramulator
 
 // Configuration for hybrid memory systems
 #if (MEMORY_USE_HYBRID == ENABLE)
@@ -29,6 +40,56 @@
 #define NUMBER_OF_MEMORIES   (1u)
 #endif  // MEMORY_USE_HYBRID
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE) && (RAMULATOR == DISABLE)
+#error The checkpoint only supports ChampSim + Ramulator.
+#endif  // SIMULATION_USE_CHECKPOINT, RAMULATOR
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE) && (RAMULATOR == DISABLE)
+#error The clock skipping only supports ChampSim + Ramulator.
+#endif  // SIMULATION_USE_CLOCK_SKIPPING, RAMULATOR
+
+// Configuration for the parallel simulation of cores
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+#define PARALLEL_CORES_QUANTUM          (32)      // cycles that the cores run in parallel before the LLC and the memory controller catch up, the LLC returns data to a core up to this many cycles late
+#define PARALLEL_CORES_DETERMINISTIC    (ENABLE)  // whether each core allocates physical pages from its own part of the free list, so the results don't depend on the timing of the threads
+
+#if (RAMULATOR == DISABLE) || (CPU_USE_MULTIPLE_CORES == DISABLE) || (USE_OPENMP == DISABLE)
+#error The parallel simulation of cores only supports ChampSim + Ramulator with multiple cores and OpenMP.
+#endif  // RAMULATOR, CPU_USE_MULTIPLE_CORES, USE_OPENMP
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+#error The parallel simulation of cores cannot skip clock cycles, disable SIMULATION_USE_CLOCK_SKIPPING.
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+#endif  // SIMULATION_USE_PARALLEL_CORES
+
+#if (MEMORY_USE_PARALLEL_TICKING == ENABLE) && ((RAMULATOR == DISABLE) || (MEMORY_USE_HYBRID == DISABLE) || (USE_OPENMP == DISABLE))
+#error The parallel ticking of memories only supports ChampSim + Ramulator with hybrid memory systems and OpenMP.
+#endif  // MEMORY_USE_PARALLEL_TICKING, RAMULATOR, MEMORY_USE_HYBRID, USE_OPENMP
+
+#if (MEMORY_USE_PARALLEL_CHANNELS == ENABLE) && ((RAMULATOR == DISABLE) || (USE_OPENMP == DISABLE))
+#error The parallel ticking of channels only supports ChampSim + Ramulator with OpenMP.
+#endif  // MEMORY_USE_PARALLEL_CHANNELS, RAMULATOR, USE_OPENMP
+
+#if (MEMORY_USE_BANK_INDEXED_SCHEDULER == ENABLE) && (RAMULATOR == DISABLE)
+#error The bank-indexed scheduler only supports ChampSim + Ramulator.
+#endif  // MEMORY_USE_BANK_INDEXED_SCHEDULER, RAMULATOR
+
+#if (MEMORY_USE_FLAT_DRAM_TIMING == ENABLE) && (RAMULATOR == DISABLE)
+#error The flattened DRAM timing only supports ChampSim + Ramulator.
+#endif  // MEMORY_USE_FLAT_DRAM_TIMING, RAMULATOR
+
+#if (MEMORY_USE_POOLED_REQUEST_QUEUES == ENABLE) && (RAMULATOR == DISABLE)
+#error The pooled request queues only support ChampSim + Ramulator.
+#endif  // MEMORY_USE_POOLED_REQUEST_QUEUES, RAMULATOR
+
+#if (MEMORY_USE_SCHEDULED_REFRESH == ENABLE) && (RAMULATOR == DISABLE)
+#error The scheduled refresh only supports ChampSim + Ramulator.
+#endif  // MEMORY_USE_SCHEDULED_REFRESH, RAMULATOR
+
+#if (MEMORY_USE_IDLE_CHANNEL_FAST_PATH == ENABLE) && (RAMULATOR == DISABLE)
+#error The idle channel fast path only supports ChampSim + Ramulator.
+#endif  // MEMORY_USE_IDLE_CHANNEL_FAST_PATH, RAMULATOR
+
 // Configuration for swapping unit in the memory controller
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE)
 #define SWAPPING_BUFFER_ENTRY_NUMBER    (64)
@@ -40,12 +101,15 @@
 
 /* Research proposal selection */
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+// every enabled research proposal is compiled in, and the command line option --memory_policy <name> selects one of them
+// (cameo, variable_granularity, mempod). The first enabled one in this list is used by default.
 #define IDEAL_LINE_LOCATION_TABLE             (ENABLE)
 #define COLOCATED_LINE_LOCATION_TABLE         (DISABLE)
-#define IDEAL_VARIABLE_GRANULARITY            (DISABLE)
-#define IDEAL_SINGLE_MEMPOD                   (DISABLE)
+#define IDEAL_VARIABLE_GRANULARITY            (ENABLE)
+#define IDEAL_SINGLE_MEMPOD                   (ENABLE)
 
 #define TRACKING_LOAD_STORE_STATISTICS        (ENABLE)
+#define MEMORY_USE_FUNCTIONAL_WARMUP          (ENABLE)  // whether the research proposal is trained during warmup, and its remapping requests are finished at once without ticking the memories
 
 #if (IDEAL_LINE_LOCATION_TABLE == DISABLE) && (COLOCATED_LINE_LOCATION_TABLE == DISABLE) && (IDEAL_VARIABLE_GRANULARITY == DISABLE) && (IDEAL_SINGLE_MEMPOD == DISABLE)
 #define NO_METHOD_FOR_RUN_HYBRID_MEMORY       (ENABLE)
@@ -59,27 +123,37 @@
 
 // Configuration for each research proposal
 #if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-#define HOTNESS_THRESHOLD                     (1u)
+#define CAMEO_HOTNESS_THRESHOLD               (1u)
 #define BITS_MANIPULATION                     (DISABLE)
-#elif (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-#define HOTNESS_THRESHOLD                     (1u)      // default: 1/4
+#endif  // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE
+
+#if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
+#define VG_HOTNESS_THRESHOLD                  (1u)      // default: 1/4
 #define DATA_EVICTION                         (ENABLE)
 #define FLEXIBLE_DATA_PLACEMENT               (ENABLE)
 #define STATISTICS_INFORMATION                (ENABLE)
 #define FLEXIBLE_GRANULARITY                  (ENABLE)
 #define IMMEDIATE_EVICTION                    (DISABLE)
 #define COLD_DATA_DETECTION_IN_GROUP          (DISABLE)
-#elif (IDEAL_SINGLE_MEMPOD == ENABLE)
+#endif  // IDEAL_VARIABLE_GRANULARITY
+
+#if (IDEAL_SINGLE_MEMPOD == ENABLE)
 #define PRINT_SWAPS_PER_EPOCH_MEMPOD          (DISABLE)
-#else
-#define HOTNESS_THRESHOLD                     (1u)
-#endif  // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_VARIABLE_GRANULARITY, IDEAL_SINGLE_MEMPOD
+#endif  // IDEAL_SINGLE_MEMPOD
 
 // Check
 #if (NO_METHOD_FOR_RUN_HYBRID_MEMORY == ENABLE)
 #error OS-transparent management designs need to be enabled.
 #endif  // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE
 
+#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) && (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
+#error The ideal and co-located line location tables are two variants of CAMEO, only one of them can be enabled.
+#endif  // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE
+
+#if (COLOCATED_LINE_LOCATION_TABLE == ENABLE) && ((IDEAL_VARIABLE_GRANULARITY == ENABLE) || (IDEAL_SINGLE_MEMPOD == ENABLE))
+#error The co-located line location table changes how the memory controller accesses memories, so other designs cannot be compiled with it.
+#endif  // COLOCATED_LINE_LOCATION_TABLE, IDEAL_VARIABLE_GRANULARITY, IDEAL_SINGLE_MEMPOD
+
 #endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 
 #if (PRINT_MEMORY_TRACE == ENABLE)
@@ -95,19 +169,18 @@
 #define DATA_GRANULARITY_2048B              (2048u)
 #define DATA_GRANULARITY_4096B              (4096u)
 
-#if (IDEAL_SINGLE_MEMPOD == DISABLE)
+// data management granularity means how the hardware cluster the data, MemPod defines its own in ideal_single_mempod.h
 #if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-#define DATA_MANAGEMENT_GRANULARITY         (DATA_GRANULARITY_64B)  // default: DATA_GRANULARITY_64B
-#elif (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-#define DATA_MANAGEMENT_GRANULARITY         (DATA_GRANULARITY_4096B)
-#define DATA_LINE_OFFSET_BITS               (lg2(DATA_GRANULARITY_64B))
-#else
-#define DATA_MANAGEMENT_GRANULARITY         (DATA_GRANULARITY_64B)
-#endif  // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE, IDEAL_VARIABLE_GRANULARITY
+#define CAMEO_DATA_MANAGEMENT_GRANULARITY       (DATA_GRANULARITY_64B)  // default: DATA_GRANULARITY_64B
+#define CAMEO_DATA_MANAGEMENT_OFFSET_BITS       (lg2(CAMEO_DATA_MANAGEMENT_GRANULARITY))
+#define CAMEO_DATA_GRANULARITY_IN_CACHE_LINE    (CAMEO_DATA_MANAGEMENT_GRANULARITY / DATA_GRANULARITY_64B)
+#endif  // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE
 
-#define DATA_MANAGEMENT_OFFSET_BITS         (lg2(DATA_MANAGEMENT_GRANULARITY))  // data management granularity means how the hardware cluster the data
-#define DATA_GRANULARITY_IN_CACHE_LINE      (DATA_MANAGEMENT_GRANULARITY / DATA_GRANULARITY_64B)
-#endif // IDEAL_SINGLE_MEMPOD
+#if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
+#define VG_DATA_MANAGEMENT_GRANULARITY          (DATA_GRANULARITY_4096B)
+#define VG_DATA_MANAGEMENT_OFFSET_BITS          (lg2(VG_DATA_MANAGEMENT_GRANULARITY))
+#define DATA_LINE_OFFSET_BITS                   (lg2(DATA_GRANULARITY_64B))
+#endif  // IDEAL_VARIABLE_GRANULARITY
 
 // CPU setting for branch_predictor (bimodal, gshare, hashed_perceptron, perceptron)
 #define BRANCH_USE_BIMODAL             (O3_CPU::bpred_t::bbranchDbimodal)
@@ -211,7 +284,8 @@ public:
     MEMORY_TRACE(std::string v1, std::string v2, char** string_array, uint32_t number);
     ~MEMORY_TRACE();
 
-    void output_memory_trace_hexadecimal(uint64_t address, char type);
+    // the cycle is the cycle of the memory controller in which it accepts the request.
+    void output_memory_trace_hexadecimal(uint64_t address, char type, uint64_t cycle);
 };
 
 // simulator statistics output class
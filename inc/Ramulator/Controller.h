@@ -1,12 +1,15 @@
 #ifndef __CONTROLLER_H
 #define __CONTROLLER_H
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <deque>
 #include <fstream>
+#include <limits>
 #include <list>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "Config.h"
@@ -82,9 +85,21 @@ public:
 
     struct Queue
     {
-        list<Request> q;
+        RequestList q;
         unsigned int max = 32;
         unsigned int size() { return q.size(); }
+
+#if (MEMORY_USE_BANK_INDEXED_SCHEDULER == ENABLE)
+        BankQueues<T> banks; // the requests of q sorted by bank for the scheduler
+
+        void push_back(const Request& req) { q.push_back(req); banks.insert(prev(q.end())); }
+        void pop_back() { banks.erase(prev(q.end())); q.pop_back(); }
+        void erase(RequestList::iterator req) { banks.erase(req); q.erase(req); }
+#else
+        void push_back(const Request& req) { q.push_back(req); }
+        void pop_back() { q.pop_back(); }
+        void erase(RequestList::iterator req) { q.erase(req); }
+#endif  // MEMORY_USE_BANK_INDEXED_SCHEDULER
     };
 
     Queue readq;  // queue for read requests
@@ -96,12 +111,20 @@ public:
     // after ACTIVATE w/o READ of WRITE command)
     Queue otherq;  // queue for all "other" requests (e.g., refresh)
 
-    deque<Request> pending;  // read requests that are about to receive data from DRAM
+    RequestFifo pending;  // read requests that are about to receive data from DRAM
     bool write_mode = false;  // whether write requests should be prioritized over reads
     float wr_high_watermark = 0.8f; // threshold for switching to write mode
     float wr_low_watermark = 0.2f; // threshold for switching back to read mode
     //long refreshed = 0;  // last time refresh requests were generated
 
+#if (MEMORY_USE_BANK_INDEXED_SCHEDULER == ENABLE)
+    long issued_commands = 0; // the scheduler's states of the banks are valid until this number changes
+#endif  // MEMORY_USE_BANK_INDEXED_SCHEDULER
+
+#if (MEMORY_USE_IDLE_CHANNEL_FAST_PATH == ENABLE)
+    long idle_until = 0; // the channel is idle and tick() only counts the cycle until clk reaches it
+#endif  // MEMORY_USE_IDLE_CHANNEL_FAST_PATH
+
     /* Command trace for DRAMPower 3.1 */
     string cmd_trace_prefix = "cmd-trace-";
     vector<ofstream> cmd_trace_files;
@@ -118,6 +141,16 @@ public:
         refresh(new Refresh<T>(this)),
         cmd_trace_files(channel->children.size())
     {
+#if (MEMORY_USE_BANK_INDEXED_SCHEDULER == ENABLE)
+        for (Queue* queue : {&actq, &readq, &writeq, &otherq})
+            queue->banks.init(channel->spec);
+#endif  // MEMORY_USE_BANK_INDEXED_SCHEDULER
+#if (MEMORY_USE_POOLED_REQUEST_QUEUES == ENABLE)
+        for (Queue* queue : {&actq, &readq, &writeq, &otherq})
+            queue->q.reserve(queue->max);
+        pending.reserve(readq.max);
+#endif  // MEMORY_USE_POOLED_REQUEST_QUEUES
+
         record_cmd_trace = configs.record_cmd_trace();
         print_cmd_trace = configs.print_cmd_trace();
         if (record_cmd_trace)
@@ -332,7 +365,10 @@ public:
             return false;
 
         req.arrive = clk;
-        queue.q.push_back(req);
+        queue.push_back(req);
+#if (MEMORY_USE_IDLE_CHANNEL_FAST_PATH == ENABLE)
+        idle_until = clk;   // the next tick schedules the request
+#endif  // MEMORY_USE_IDLE_CHANNEL_FAST_PATH
         // shortcut for read requests, if a write to same addr exists
         // necessary for coherence
         if (req.type == Request::Type::READ && find_if(writeq.q.begin(), writeq.q.end(),
@@ -340,26 +376,131 @@ public:
         {
             req.depart = clk + 1;
             pending.push_back(req);
-            readq.q.pop_back();
+            readq.pop_back();
         }
         return true;
     }
 
 #if (USER_CODES == ENABLE)
-    unsigned int queue_size(Request& req)
+    unsigned int queue_size(Request::Type type)
     {
-        Queue& queue = get_queue(req.type);
+        Queue& queue = get_queue(type);
         return queue.size();
     }
-    unsigned int queue_maxsize(Request& req)
+    unsigned int queue_maxsize(Request::Type type)
     {
-        Queue& queue = get_queue(req.type);
+        Queue& queue = get_queue(type);
         return queue.max;
     }
+
+    // the queue lengths counted in every tick, Memory adds them up for all channels in finish().
+    double get_req_queue_length_sum() { return req_queue_length_sum.value(); }
+    double get_read_req_queue_length_sum() { return read_req_queue_length_sum.value(); }
+    double get_write_req_queue_length_sum() { return write_req_queue_length_sum.value(); }
 #endif  // USER_CODES
 
+#if (MEMORY_USE_PARALLEL_CHANNELS == ENABLE)
+    // the controllers of a memory tick on several threads, so the reads completed in a tick wait here until
+    // Memory::tick() returns them in the order of the channels.
+    vector<Request> completed_requests;
+
+    void return_completed_requests()
+    {
+        for (auto& req : completed_requests)
+            req.callback(req);
+        completed_requests.clear();
+    }
+#endif  // MEMORY_USE_PARALLEL_CHANNELS
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE) || (MEMORY_USE_IDLE_CHANNEL_FAST_PATH == ENABLE)
+    // the number of following ticks (at most limit) in which tick() only counts the cycle, i.e., no queued request is ready
+    // to issue its first command, no open row is precharged by the row policy, and neither a pending read completes nor
+    // a refresh is due.
+    long idle_ticks(long limit)
+    {
+        // their tick() and refresh are specialized
+        if (std::is_same<T, TLDRAM>::value || std::is_same<T, DSARP>::value)
+            return 0;
+
+        // the closed and timeout row policies precharge an open row once the precharge is ready (and the row timed out)
+        if (rowpolicy->type != RowPolicy<T>::Type::Opened)
+        {
+            for (auto& kv : rowtable->table)
+            {
+                long precharge_clk = channel->get_next(T::Command::PRE, kv.first.data());
+                if (rowpolicy->type == RowPolicy<T>::Type::Timeout)
+                    precharge_clk = std::max(precharge_clk, kv.second.timestamp + rowpolicy->timeout);
+
+                limit = std::min(limit, precharge_clk - 1 - clk);
+                if (limit <= 0)
+                    return 0;
+            }
+        }
+
+        // no command is issued before the first command of a queued request meets its timing constraints
+        for (Queue* queue : {&actq, &readq, &writeq, &otherq})
+        {
+            for (auto req = queue->q.begin(); req != queue->q.end(); req++)
+            {
+                limit = std::min(limit, channel->get_next(get_first_cmd(req), req->addr_vec.data()) - 1 - clk);
+                if (limit <= 0)
+                    return 0;
+            }
+        }
+
+        if (pending.size())
+            limit = std::min(limit, pending[0].depart - 1 - clk);
+
+#if (MEMORY_USE_SCHEDULED_REFRESH == ENABLE)
+        limit = std::min(limit, refresh->wakeup_clk - 1 - clk);
+#else
+        limit = std::min(limit, refresh->refreshed + channel->spec->speed_entry.nREFI - 1 - refresh->clk);
+#endif  // MEMORY_USE_SCHEDULED_REFRESH
+        return std::max(limit, 0L);
+    }
+#endif  // SIMULATION_USE_CLOCK_SKIPPING, MEMORY_USE_IDLE_CHANNEL_FAST_PATH
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+    // advance over the idle ticks as if tick() is called in each of them.
+    void skip_ticks(long ticks)
+    {
+        clk += ticks;
+        req_queue_length_sum += ticks * (readq.size() + writeq.size() + pending.size());
+        read_req_queue_length_sum += ticks * (readq.size() + pending.size());
+        write_req_queue_length_sum += ticks * writeq.size();
+
+#if (MEMORY_USE_SCHEDULED_REFRESH == DISABLE)
+        refresh->clk += ticks;
+#endif  // MEMORY_USE_SCHEDULED_REFRESH
+
+        // the queues don't change, so the write mode is settled in the first tick
+        if (!write_mode)
+        {
+            if (writeq.size() > (unsigned int)(wr_high_watermark * writeq.max) || readq.size() == 0)
+                write_mode = true;
+        }
+        else
+        {
+            if (writeq.size() < (unsigned int)(wr_low_watermark * writeq.max) && readq.size() != 0)
+                write_mode = false;
+        }
+    }
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
     void tick()
     {
+#if (MEMORY_USE_IDLE_CHANNEL_FAST_PATH == ENABLE)
+        // the queues are empty, so the queue lengths add nothing
+        if (clk < idle_until)
+        {
+            clk++;
+#if (MEMORY_USE_SCHEDULED_REFRESH == DISABLE)
+            refresh->clk++;
+#endif  // MEMORY_USE_SCHEDULED_REFRESH
+            return;
+        }
+#endif  // MEMORY_USE_IDLE_CHANNEL_FAST_PATH
+
         clk++;
         req_queue_length_sum += readq.size() + writeq.size() + pending.size();
         read_req_queue_length_sum += readq.size() + pending.size();
@@ -377,13 +518,23 @@ public:
                     channel->update_serving_requests(
                         req.addr_vec.data(), -1, clk);
                 }
+#if (MEMORY_USE_PARALLEL_CHANNELS == ENABLE)
+                completed_requests.push_back(req);
+#else
                 req.callback(req);
+#endif  // MEMORY_USE_PARALLEL_CHANNELS
                 pending.pop_front();
             }
         }
 
         /*** 2. Refresh scheduler ***/
+#if (MEMORY_USE_SCHEDULED_REFRESH == ENABLE)
+        // the refresh scheduler only has work to do when its next refresh is due
+        if (clk >= refresh->wakeup_clk)
+            refresh->tick_ref();
+#else
         refresh->tick_ref();
+#endif  // MEMORY_USE_SCHEDULED_REFRESH
 
         /*** 3. Should we schedule writes? ***/
         if (!write_mode)
@@ -405,7 +556,7 @@ public:
         // are requests available to service in this cycle
         Queue* queue = &actq;
         typename T::Command cmd;
-        auto req = scheduler->get_head(queue->q);
+        auto req = scheduler->get_head(*queue);
 
         bool is_valid_req = (req != queue->q.end());
 
@@ -422,7 +573,7 @@ public:
             if (otherq.size())
                 queue = &otherq;  // "other" requests are rare, so we give them precedence over reads/writes
 
-            req = scheduler->get_head(queue->q);
+            req = scheduler->get_head(*queue);
 
             is_valid_req = (req != queue->q.end());
 
@@ -442,6 +593,13 @@ public:
             {
                 issue_cmd(cmd, victim);
             }
+#if (MEMORY_USE_IDLE_CHANNEL_FAST_PATH == ENABLE)
+            else if (readq.size() + writeq.size() + actq.size() + otherq.size() + pending.size() == 0)
+            {
+                // an idle channel doesn't change until its next refresh, precharge, or request
+                idle_until = clk + idle_ticks(std::numeric_limits<long>::max());
+            }
+#endif  // MEMORY_USE_IDLE_CHANNEL_FAST_PATH
             return;  // nothing more to be done this cycle
         }
 
@@ -504,8 +662,8 @@ public:
             if (channel->spec->is_opening(cmd))
             {
                 // promote the request that caused issuing activation to actq
-                actq.q.push_back(*req);
-                queue->q.erase(req);
+                actq.push_back(*req);
+                queue->erase(req);
             }
 
             return;
@@ -525,40 +683,43 @@ public:
         }
 
         // remove request from queue
-        queue->q.erase(req);
+        queue->erase(req);
     }
 
-    bool is_ready(list<Request>::iterator req)
+    bool is_ready(RequestList::iterator req)
     {
         typename T::Command cmd = get_first_cmd(req);
         return channel->check(cmd, req->addr_vec.data(), clk);
     }
 
-    bool is_ready(typename T::Command cmd, const vector<int>& addr_vec)
+    template <typename AddrVecType> // AddrVec of a request or vector<int> of the row policy's victim
+    bool is_ready(typename T::Command cmd, const AddrVecType& addr_vec)
     {
         return channel->check(cmd, addr_vec.data(), clk);
     }
 
-    bool is_row_hit(list<Request>::iterator req)
+    bool is_row_hit(RequestList::iterator req)
     {
         // cmd must be decided by the request type, not the first cmd
         typename T::Command cmd = channel->spec->translate[int(req->type)];
         return channel->check_row_hit(cmd, req->addr_vec.data());
     }
 
-    bool is_row_hit(typename T::Command cmd, const vector<int>& addr_vec)
+    template <typename AddrVecType>
+    bool is_row_hit(typename T::Command cmd, const AddrVecType& addr_vec)
     {
         return channel->check_row_hit(cmd, addr_vec.data());
     }
 
-    bool is_row_open(list<Request>::iterator req)
+    bool is_row_open(RequestList::iterator req)
     {
         // cmd must be decided by the request type, not the first cmd
         typename T::Command cmd = channel->spec->translate[int(req->type)];
         return channel->check_row_open(cmd, req->addr_vec.data());
     }
 
-    bool is_row_open(typename T::Command cmd, const vector<int>& addr_vec)
+    template <typename AddrVecType>
+    bool is_row_open(typename T::Command cmd, const AddrVecType& addr_vec)
     {
         return channel->check_row_open(cmd, addr_vec.data());
     }
@@ -602,7 +763,7 @@ public:
     }
 
 private:
-    typename T::Command get_first_cmd(list<Request>::iterator req)
+    typename T::Command get_first_cmd(RequestList::iterator req)
     {
         typename T::Command cmd = channel->spec->translate[int(req->type)];
         return channel->decode(cmd, req->addr_vec.data());
@@ -610,7 +771,7 @@ private:
 
     // upgrade to an autoprecharge command
     void cmd_issue_autoprecharge(typename T::Command& cmd,
-                                 const vector<int>& addr_vec)
+                                 const AddrVec& addr_vec)
     {
 
         // currently, autoprecharge is only used with closed row policy
@@ -666,11 +827,14 @@ private:
 
     }
 
-    void issue_cmd(typename T::Command cmd, const vector<int>& addr_vec)
+    void issue_cmd(typename T::Command cmd, const AddrVec& addr_vec)
     {
         cmd_issue_autoprecharge(cmd, addr_vec);
         assert(is_ready(cmd, addr_vec));
         channel->update(cmd, addr_vec.data(), clk);
+#if (MEMORY_USE_BANK_INDEXED_SCHEDULER == ENABLE)
+        issued_commands++;
+#endif  // MEMORY_USE_BANK_INDEXED_SCHEDULER
 
         if (cmd == T::Command::PRE)
         {
@@ -706,18 +870,18 @@ private:
             printf("\n");
         }
     }
-    vector<int> get_addr_vec(typename T::Command cmd, list<Request>::iterator req)
+    AddrVec get_addr_vec(typename T::Command cmd, RequestList::iterator req)
     {
         return req->addr_vec;
     }
 };
 
 template <>
-vector<int> Controller<SALP>::get_addr_vec(
-    SALP::Command cmd, list<Request>::iterator req);
+AddrVec Controller<SALP>::get_addr_vec(
+    SALP::Command cmd, RequestList::iterator req);
 
 template <>
-bool Controller<SALP>::is_ready(list<Request>::iterator req);
+bool Controller<SALP>::is_ready(RequestList::iterator req);
 
 template <>
 void Controller<ALDRAM>::update_temp(ALDRAM::Temp current_temperature);
@@ -727,7 +891,7 @@ void Controller<TLDRAM>::tick();
 
 template <>
 void Controller<TLDRAM>::cmd_issue_autoprecharge(typename TLDRAM::Command& cmd,
-                                                 const vector<int>& addr_vec);
+                                                 const AddrVec& addr_vec);
 
 } /*namespace ramulator*/
 
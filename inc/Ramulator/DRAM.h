@@ -10,12 +10,47 @@
 #include <algorithm>
 #include <cassert>
 #include <type_traits>
+#include <limits>
+#include <memory>
+
+#include "ProjectConfiguration.h" // user file
 
 using namespace std;
 
 namespace ramulator
 {
 
+#if (MEMORY_USE_FLAT_DRAM_TIMING == ENABLE)
+// The opened rows of a bank (or a subarray) in a small contiguous array instead of a map, since a bank opens only one
+// or a few rows at the same time. It provides the part of map's interface which the standards use.
+template <typename State>
+class RowStates
+{
+public:
+    typedef typename vector<pair<int, State>>::iterator iterator;
+
+    iterator find(int row)
+    {
+        return find_if(rows.begin(), rows.end(), [row](const pair<int, State>& r) { return r.first == row; });
+    }
+    iterator end() { return rows.end(); }
+    size_t size() const { return rows.size(); }
+    void clear() { rows.clear(); } // the capacity is kept, so opening rows doesn't allocate again
+
+    State& operator[](int row)
+    {
+        auto r = find(row);
+        if (r != rows.end())
+            return r->second;
+        rows.push_back({row, State()});
+        return rows.back().second;
+    }
+
+private:
+    vector<pair<int, State>> rows;
+};
+#endif  // MEMORY_USE_FLAT_DRAM_TIMING
+
 template <typename T>
 class DRAM
 {
@@ -48,7 +83,11 @@ public:
     // State of Rows:
     // There are too many rows for them to be instantiated individually
     // Instead, their bank (or an equivalent entity) tracks their state for them
+#if (MEMORY_USE_FLAT_DRAM_TIMING == ENABLE)
+    RowStates<typename T::State> row_state;
+#else
     map<int, typename T::State> row_state;
+#endif  // MEMORY_USE_FLAT_DRAM_TIMING
 
     // Insert a node as one of my child nodes
     void insert(DRAM<T>* child);
@@ -89,6 +128,12 @@ public:
 
     void finish(long dram_cycles);
 
+#if (MEMORY_USE_FLAT_DRAM_TIMING == ENABLE)
+    // build the flattened timing tables of all levels from spec->timing again, e.g., after ALDRAM changes its timing.
+    // it is called on the channel, whose nodes share the tables.
+    void flatten_timing();
+#endif  // MEMORY_USE_FLAT_DRAM_TIMING
+
 private:
     // Constructor
     DRAM() {}
@@ -96,7 +141,32 @@ private:
     // Timing
     long cur_clk = 0;
     long next[int(T::Command::MAX)]; // the earliest time in the future when a command could be ready
+#if (MEMORY_USE_FLAT_DRAM_TIMING == ENABLE)
+    // The timing parameters of a command at a level, flattened from spec->timing. The parameters to the next command
+    // (dist is 1) are dense arrays over the commands, so issuing a command updates next with a max over the arrays,
+    // and only the parameters over several commands (e.g., tFAW) read the history.
+    struct FlatTiming
+    {
+        static constexpr long NO_TIMING = numeric_limits<long>::min() / 2; // never raises next
+
+        long self[int(T::Command::MAX)]; // to the commands at the target node
+        long sibling[int(T::Command::MAX)]; // to the commands at the siblings of the target node
+        bool has_self;
+        bool has_sibling;
+        vector<typename T::TimingEntry> history_entries; // to the commands at the target node, dist > 1
+    };
+
+    shared_ptr<vector<FlatTiming>> flat_timing; // [level][command] of the channel, shared by all of its nodes
+
+    // the most recent history of when commands were issued, the history of cmd is
+    // prev[prev_offset[cmd]] ... prev[prev_offset[cmd + 1] - 1] with the latest one first.
+    vector<long> prev;
+    int prev_offset[int(T::Command::MAX) + 1];
+
+    DRAM(T* spec, typename T::Level level, shared_ptr<vector<FlatTiming>> flat_timing);
+#else
     deque<long> prev[int(T::Command::MAX)]; // the most recent history of when commands were issued
+#endif  // MEMORY_USE_FLAT_DRAM_TIMING
 
     // Lookup table for which commands must be preceded by which other commands (i.e., "prerequisite")
     // E.g., a read command to a closed bank must be preceded by an activate command
@@ -191,6 +261,92 @@ void DRAM<T>::finish(long dram_cycles)
     }
 }
 
+// Constructor
+#if (MEMORY_USE_FLAT_DRAM_TIMING == ENABLE)
+template <typename T>
+DRAM<T>::DRAM(T* spec, typename T::Level level) :
+    DRAM(spec, level, make_shared<vector<FlatTiming>>(int(T::Level::MAX) * int(T::Command::MAX)))
+{
+    flatten_timing();
+}
+
+template <typename T>
+DRAM<T>::DRAM(T* spec, typename T::Level level, shared_ptr<vector<FlatTiming>> flat_timing) :
+    spec(spec), level(level), id(0), parent(NULL), flat_timing(flat_timing)
+{
+
+    state = spec->start[(int)level];
+    prereq = spec->prereq[int(level)];
+    rowhit = spec->rowhit[int(level)];
+    rowopen = spec->rowopen[int(level)];
+    lambda = spec->lambda[int(level)];
+    timing = spec->timing[int(level)];
+
+    fill_n(next, int(T::Command::MAX), -1); // initialize future
+    prev_offset[0] = 0;
+    for (int cmd = 0; cmd < int(T::Command::MAX); cmd++)
+    {
+        int dist = 0;
+        for (auto& t : timing[cmd])
+            dist = max(dist, t.dist);
+
+        prev_offset[cmd + 1] = prev_offset[cmd] + dist;
+    }
+    prev.resize(prev_offset[int(T::Command::MAX)], -1); // initialize history
+
+    // try to recursively construct my children
+    int child_level = int(level) + 1;
+    if (child_level == int(T::Level::Row))
+        return; // stop recursion: rows are not instantiated as nodes
+
+    int child_max = spec->org_entry.count[child_level];
+    if (!child_max)
+        return; // stop recursion: the number of children is unspecified
+
+    // recursively construct my children
+    for (int i = 0; i < child_max; i++)
+    {
+        DRAM<T>* child = new DRAM<T>(spec, typename T::Level(child_level), flat_timing);
+        child->parent = this;
+        child->id = i;
+        children.push_back(child);
+    }
+
+}
+
+template <typename T>
+void DRAM<T>::flatten_timing()
+{
+    for (int lev = 0; lev < int(T::Level::MAX); lev++)
+    {
+        for (int cmd = 0; cmd < int(T::Command::MAX); cmd++)
+        {
+            FlatTiming& flat = (*flat_timing)[lev * int(T::Command::MAX) + cmd];
+            fill_n(flat.self, int(T::Command::MAX), FlatTiming::NO_TIMING);
+            fill_n(flat.sibling, int(T::Command::MAX), FlatTiming::NO_TIMING);
+            flat.has_self = flat.has_sibling = false;
+            flat.history_entries.clear();
+
+            for (auto& t : spec->timing[lev][cmd])
+            {
+                if (t.sibling)
+                {
+                    assert(t.dist == 1);
+                    flat.sibling[int(t.cmd)] = max(flat.sibling[int(t.cmd)], long(t.val));
+                    flat.has_sibling = true;
+                }
+                else if (t.dist == 1)
+                {
+                    flat.self[int(t.cmd)] = max(flat.self[int(t.cmd)], long(t.val));
+                    flat.has_self = true;
+                }
+                else
+                    flat.history_entries.push_back(t);
+            }
+        }
+    }
+}
+#else
 // Constructor
 template <typename T>
 DRAM<T>::DRAM(T* spec, typename T::Level level) :
@@ -235,6 +391,8 @@ DRAM<T>::DRAM(T* spec, typename T::Level level) :
 
 }
 
+#endif  // MEMORY_USE_FLAT_DRAM_TIMING
+
 template <typename T>
 DRAM<T>::~DRAM()
 {
@@ -252,6 +410,45 @@ void DRAM<T>::insert(DRAM<T>* child)
 }
 
 // Decode
+#if (MEMORY_USE_FLAT_DRAM_TIMING == ENABLE)
+// the same as the recursion below, walking down the levels in a loop
+template <typename T>
+typename T::Command DRAM<T>::decode(typename T::Command cmd, const int* addr)
+{
+    for (DRAM<T>* node = this; ; )
+    {
+        int child_id = addr[int(node->level) + 1];
+        if (node->prereq[int(cmd)])
+        {
+            typename T::Command prereq_cmd = node->prereq[int(cmd)](node, cmd, child_id);
+            if (prereq_cmd != T::Command::MAX)
+                return prereq_cmd; // stop: there is a prerequisite at this level
+        }
+
+        if (child_id < 0 || !node->children.size())
+            return cmd; // stop: there were no prequisites at any level
+
+        node = node->children[child_id];
+    }
+}
+
+// Check
+template <typename T>
+bool DRAM<T>::check(typename T::Command cmd, const int* addr, long clk)
+{
+    for (DRAM<T>* node = this; ; )
+    {
+        if (node->next[int(cmd)] != -1 && clk < node->next[int(cmd)])
+            return false; // stop: the check failed at this level
+
+        int child_id = addr[int(node->level) + 1];
+        if (child_id < 0 || node->level == spec->scope[int(cmd)] || !node->children.size())
+            return true; // stop: the check passed at all levels
+
+        node = node->children[child_id];
+    }
+}
+#else
 template <typename T>
 typename T::Command DRAM<T>::decode(typename T::Command cmd, const int* addr)
 {
@@ -285,6 +482,7 @@ bool DRAM<T>::check(typename T::Command cmd, const int* addr, long clk)
     // recursively check my child
     return children[child_id]->check(cmd, addr, clk);
 }
+#endif  // MEMORY_USE_FLAT_DRAM_TIMING
 
 // SAUGATA: added function to check whether a command is a row hit
 // Check row hits
@@ -363,6 +561,76 @@ void DRAM<T>::update_state(typename T::Command cmd, const int* addr)
 template <typename T>
 void DRAM<T>::update_timing(typename T::Command cmd, const int* addr, long clk)
 {
+#if (MEMORY_USE_FLAT_DRAM_TIMING == ENABLE)
+    const FlatTiming& flat = (*flat_timing)[int(level) * int(T::Command::MAX) + int(cmd)];
+
+    // I am not a target node: I am merely one of its siblings
+    if (id != addr[int(level)])
+    {
+        if (flat.has_sibling)
+        {
+            for (int c = 0; c < int(T::Command::MAX); c++)
+                next[c] = max(next[c], clk + flat.sibling[c]); // update future
+        }
+
+        return; // stop recursion: only target nodes should be recursed
+    }
+
+    // I am a target node
+    long* history = prev.data() + prev_offset[int(cmd)];
+    int history_size = prev_offset[int(cmd) + 1] - prev_offset[int(cmd)];
+    if (history_size)
+    {
+        copy_backward(history, history + history_size - 1, history + history_size);
+        history[0] = clk; // update history
+    }
+
+    if (spec->is_refreshing(cmd))
+    {
+        // refreshing is rare, so it keeps the original loop for the refresh statistics below
+        for (auto& t : timing[int(cmd)])
+        {
+            if (t.sibling)
+                continue; // not an applicable timing parameter
+
+            long past = history[t.dist - 1];
+            if (past < 0)
+                continue; // not enough history
+
+            long future = past + t.val;
+            next[int(t.cmd)] = max(next[int(t.cmd)], future); // update future
+            // TIANSHI: for refresh statistics
+            if (spec->is_opening(t.cmd))
+            {
+                assert(past == clk);
+                begin_of_refreshing = clk;
+                end_of_refreshing = max(end_of_refreshing, next[int(t.cmd)]);
+                refresh_cycles += end_of_refreshing - clk;
+                if (cur_serving_requests > 0)
+                {
+                    refresh_intervals.push_back(make_pair(begin_of_refreshing, end_of_refreshing));
+                }
+            }
+        }
+    }
+    else
+    {
+        if (flat.has_self)
+        {
+            for (int c = 0; c < int(T::Command::MAX); c++)
+                next[c] = max(next[c], clk + flat.self[c]); // update future
+        }
+
+        for (auto& t : flat.history_entries)
+        {
+            long past = history[t.dist - 1];
+            if (past < 0)
+                continue; // not enough history
+
+            next[int(t.cmd)] = max(next[int(t.cmd)], past + t.val); // update future
+        }
+    }
+#else
     // I am not a target node: I am merely one of its siblings
     if (id != addr[int(level)])
     {
@@ -411,6 +679,7 @@ void DRAM<T>::update_timing(typename T::Command cmd, const int* addr, long clk)
             }
         }
     }
+#endif  // MEMORY_USE_FLAT_DRAM_TIMING
 
     // Some commands have timings that are higher that their scope levels, thus
     // we do not stop at the cmd's scope level
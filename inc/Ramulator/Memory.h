@@ -302,31 +302,98 @@ public:
     void tick()
     {
         ++num_dram_cycles;
-        int cur_que_req_num = 0;
-        int cur_que_readreq_num = 0;
-        int cur_que_writereq_num = 0;
+#if (USER_CODES == ENABLE)
+        // the controllers count the same queue lengths in their ticks, so finish() adds them up instead of counting
+        // them here in every tick. The controller of TLDRAM doesn't count the pending requests.
+        if (std::is_same<T, TLDRAM>::value)
+#endif  // USER_CODES
+        {
+            int cur_que_req_num = 0;
+            int cur_que_readreq_num = 0;
+            int cur_que_writereq_num = 0;
+            for (auto ctrl : ctrls)
+            {
+                cur_que_req_num += ctrl->readq.size() + ctrl->writeq.size() + ctrl->pending.size();
+                cur_que_readreq_num += ctrl->readq.size() + ctrl->pending.size();
+                cur_que_writereq_num += ctrl->writeq.size();
+            }
+            in_queue_req_num_sum += cur_que_req_num;
+            in_queue_read_req_num_sum += cur_que_readreq_num;
+            in_queue_write_req_num_sum += cur_que_writereq_num;
+        }
+
+#if (MEMORY_USE_PARALLEL_CHANNELS == ENABLE)
+        bool is_active = false;
         for (auto ctrl : ctrls)
         {
-            cur_que_req_num += ctrl->readq.size() + ctrl->writeq.size() + ctrl->pending.size();
-            cur_que_readreq_num += ctrl->readq.size() + ctrl->pending.size();
-            cur_que_writereq_num += ctrl->writeq.size();
+            is_active = is_active || ctrl->is_active();
+        }
+
+        // the channels don't share any state in a tick, and the completed reads are returned after all controllers
+        // tick, in the order of the channels. So the results are the same as ticking them one after another.
+#pragma omp parallel for num_threads(SET_THREADS_NUMBER) schedule(static) if (ctrls.size() > 1)
+        for (size_t i = 0; i < ctrls.size(); i++)
+        {
+            ctrls[i]->tick();
         }
-        in_queue_req_num_sum += cur_que_req_num;
-        in_queue_read_req_num_sum += cur_que_readreq_num;
-        in_queue_write_req_num_sum += cur_que_writereq_num;
 
+        for (auto ctrl : ctrls)
+        {
+            ctrl->return_completed_requests();
+        }
+#else
         bool is_active = false;
         for (auto ctrl : ctrls)
         {
             is_active = is_active || ctrl->is_active();
             ctrl->tick();
         }
+#endif  // MEMORY_USE_PARALLEL_CHANNELS
         if (is_active)
         {
             ramulator_active_cycles++;
         }
     }
 
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+    // the number of following ticks (at most limit) in which no controller has work to do.
+    long idle_ticks(long limit)
+    {
+        for (auto ctrl : ctrls)
+        {
+            limit = ctrl->idle_ticks(limit);
+            if (limit == 0)
+            {
+                break;
+            }
+        }
+        return limit;
+    }
+
+    // advance over the idle ticks as if tick() is called in each of them.
+    void skip_ticks(long ticks)
+    {
+        if (ticks == 0)
+        {
+            return;
+        }
+
+        // the queue lengths are counted by the controllers' skip_ticks(), TLDRAM doesn't skip ticks.
+        num_dram_cycles += ticks;
+
+        bool is_active = false;
+        for (auto ctrl : ctrls)
+        {
+            is_active = is_active || ctrl->is_active();
+            ctrl->skip_ticks(ticks);
+        }
+        if (is_active)
+        {
+            ramulator_active_cycles += ticks;
+        }
+    }
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
     bool send(Request req)
     {
         req.addr_vec.resize(addr_bits.size());
@@ -384,82 +451,47 @@ public:
     }
 
 #if (USER_CODES == ENABLE)
-    // get the number of queue's current members.
-    uint32_t get_queue_occupancy(Request& req)
+    // decode only the channel index of an address, so queue queries don't need to build a request.
+    int get_channel_index(long addr)
     {
-        req.addr_vec.resize(addr_bits.size());
-        long addr = req.addr;
-
         // Each transaction size is 2^tx_bits, so first clear the lowest tx_bits bits
         clear_lower_bits(addr, tx_bits);
 
         if (use_mapping_file)
         {
-            apply_mapping(addr, req.addr_vec);
+            AddrVec addr_vec(addr_bits.size(), 0);
+            apply_mapping(addr, addr_vec);
+            return addr_vec[int(T::Level::Channel)];
         }
-        else
+
+        switch (int(type))
         {
-            switch (int(type))
-            {
-                case int(Type::ChRaBaRoCo) :
-                    for (int i = addr_bits.size() - 1; i >= 0; i--)
-                    {
-                        req.addr_vec[i] = slice_lower_bits(addr, addr_bits[i]);
-                    }
-                break;
-                case int(Type::RoBaRaCoCh) :
-                    req.addr_vec[0] = slice_lower_bits(addr, addr_bits[0]);
-                    req.addr_vec[addr_bits.size() - 1] = slice_lower_bits(addr, addr_bits[addr_bits.size() - 1]);
-                    for (int i = 1; i <= int(T::Level::Row); i++)
-                    {
-                        req.addr_vec[i] = slice_lower_bits(addr, addr_bits[i]);
-                    }
-                    break;
-                default:
-                    assert(false);
-            }
+            case int(Type::ChRaBaRoCo) :
+                // the channel bits are above all other levels' bits
+                for (int i = addr_bits.size() - 1; i > int(T::Level::Channel); i--)
+                {
+                    clear_lower_bits(addr, addr_bits[i]);
+                }
+                return slice_lower_bits(addr, addr_bits[int(T::Level::Channel)]);
+            case int(Type::RoBaRaCoCh) :
+                return slice_lower_bits(addr, addr_bits[int(T::Level::Channel)]);
+            default:
+                assert(false);
         }
 
-        return ctrls[req.addr_vec[0]]->queue_size(req);
+        return 0;
     };
 
-    // get the capacity of this queue.
-    uint32_t get_queue_size(Request& req)
+    // get the number of queue's current members.
+    uint32_t get_queue_occupancy(int channel, Request::Type type)
     {
-        req.addr_vec.resize(addr_bits.size());
-        long addr = req.addr;
-
-        // Each transaction size is 2^tx_bits, so first clear the lowest tx_bits bits
-        clear_lower_bits(addr, tx_bits);
-
-        if (use_mapping_file)
-        {
-            apply_mapping(addr, req.addr_vec);
-        }
-        else
-        {
-            switch (int(type))
-            {
-                case int(Type::ChRaBaRoCo) :
-                    for (int i = addr_bits.size() - 1; i >= 0; i--)
-                    {
-                        req.addr_vec[i] = slice_lower_bits(addr, addr_bits[i]);
-                    }
-                break;
-                case int(Type::RoBaRaCoCh) :
-                    req.addr_vec[0] = slice_lower_bits(addr, addr_bits[0]);
-                    req.addr_vec[addr_bits.size() - 1] = slice_lower_bits(addr, addr_bits[addr_bits.size() - 1]);
-                    for (int i = 1; i <= int(T::Level::Row); i++)
-                    {
-                        req.addr_vec[i] = slice_lower_bits(addr, addr_bits[i]);
-                    }
-                    break;
-                default:
-                    assert(false);
-            }
-        }
+        return ctrls[channel]->queue_size(type);
+    };
 
-        return ctrls[req.addr_vec[0]]->queue_maxsize(req);
+    // get the capacity of this queue.
+    uint32_t get_queue_size(int channel, Request::Type type)
+    {
+        return ctrls[channel]->queue_maxsize(type);
     };
 #endif  // USER_CODES
 
@@ -578,10 +610,10 @@ public:
         }
     }
 
-    void apply_mapping(long addr, std::vector<int>& addr_vec)
+    void apply_mapping(long addr, AddrVec& addr_vec)
     {
         int* sz = spec->org_entry.count;
-        int addr_total_bits = sizeof(addr_vec) * 8;
+        int addr_total_bits = sizeof(std::vector<int>) * 8; // the row width was sized by a vector<int> addr_vec, keep it
         int addr_bits[int(T::Level::MAX)];
         for (int i = 0; i < int(T::Level::MAX); i++)
         {
@@ -646,6 +678,18 @@ public:
             ctrl->finish(read_req, dram_cycles);
         }
 
+#if (USER_CODES == ENABLE)
+        if (!std::is_same<T, TLDRAM>::value)
+        {
+            for (auto ctrl : ctrls)
+            {
+                in_queue_req_num_sum += ctrl->get_req_queue_length_sum();
+                in_queue_read_req_num_sum += ctrl->get_read_req_queue_length_sum();
+                in_queue_write_req_num_sum += ctrl->get_write_req_queue_length_sum();
+            }
+        }
+#endif  // USER_CODES
+
         // finalize average queueing requests
         in_queue_req_num_avg = in_queue_req_num_sum.value() / dram_cycles;
         in_queue_read_req_num_avg = in_queue_read_req_num_sum.value() / dram_cycles;
@@ -37,6 +37,10 @@ class Refresh {
 public:
   Controller<T>* ctrl;
   long clk, refreshed;
+#if (MEMORY_USE_SCHEDULED_REFRESH == ENABLE)
+  // The clock of the controller when tick_ref() has work to do next, the controller doesn't call it before
+  long wakeup_clk = 0;
+#endif
   // Per-bank refresh counter to track the refresh progress for each rank
   vector<int> bank_ref_counters;
   int max_rank_count, max_bank_count;
@@ -69,7 +73,12 @@ public:
 
   // Basic refresh scheduling for all bank refresh that is applicable to all DRAM types
   void tick_ref() {
+#if (MEMORY_USE_SCHEDULED_REFRESH == ENABLE)
+    // Not called in every tick, so follow the clock of the controller
+    clk = ctrl->clk;
+#else
     clk++;
+#endif
 
     int refresh_interval = ctrl->channel->spec->speed_entry.nREFI;
 
@@ -80,6 +89,9 @@ public:
       ALDRAM::Temp current_temperature = ALDRAM::Temp::COLD;
       ctrl->update_temp(current_temperature);
     }
+#if (MEMORY_USE_SCHEDULED_REFRESH == ENABLE)
+    wakeup_clk = refreshed + ctrl->channel->spec->speed_entry.nREFI;
+#endif
   }
 
 private:
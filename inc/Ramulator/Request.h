@@ -3,12 +3,15 @@
 
 #include <vector>
 #include <functional>
+#include <deque>
+#include <iterator>
+#include <list>
 #include "ProjectConfiguration.h" // user file
 #if (USER_CODES == ENABLE)
-#include "memory_class.h"
-#include "block.h"
-#include "champsim_constants.h"
-#include <array>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
 #endif  // USER_CODES
 
 using namespace std;
@@ -16,14 +19,78 @@ using namespace std;
 namespace ramulator
 {
 
+#if (USER_CODES == ENABLE) && (RAMULATOR == ENABLE)
+/** @brief
+ *  Fixed-capacity replacement of vector<int> for a request's decoded address.
+ *  Every standard has at most 6 levels (Channel ... Column), so the levels are stored inline
+ *  and copying a request among the controller's queues never touches the heap.
+ */
+class AddrVec
+{
+public:
+    static const int capacity = 8;
+
+    AddrVec()
+        : length(0)
+    {
+    }
+
+    AddrVec(size_t size, int value)
+        : length(0)
+    {
+        resize(size);
+        std::fill(begin(), end(), value);
+    }
+
+    AddrVec(const vector<int>& addr_vec)
+        : length(0)
+    {
+        resize(addr_vec.size());
+        std::copy(addr_vec.begin(), addr_vec.end(), begin());
+    }
+
+    // new levels are zeroed, like vector<int>::resize()
+    void resize(size_t size)
+    {
+        assert(size <= size_t(capacity));
+        for (size_t i = length; i < size; i++)
+            levels[i] = 0;
+        length = uint8_t(size);
+    }
+
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    int* data() { return levels; }
+    const int* data() const { return levels; }
+
+    int* begin() { return levels; }
+    int* end() { return levels + length; }
+    const int* begin() const { return levels; }
+    const int* end() const { return levels + length; }
+
+    int& operator[](size_t i) { return levels[i]; }
+    const int& operator[](size_t i) const { return levels[i]; }
+
+private:
+    int levels[capacity];
+    uint8_t length;
+};
+#else
+typedef vector<int> AddrVec;
+#endif  // USER_CODES, RAMULATOR
+
 class Request
 {
 public:
 #if (USER_CODES == ENABLE) && (RAMULATOR == ENABLE)
+    // packet_index of requests which carry no ChampSim's packet
+    static constexpr uint32_t NO_PACKET = std::numeric_limits<uint32_t>::max();
+
     bool is_first_command;
     long addr;
     // long addr_row;
-    vector<int> addr_vec;
+    AddrVec addr_vec;
     // specify which core this request sent from, for virtual address translation
     int coreid;
 
@@ -40,12 +107,11 @@ public:
 
     long arrive = -1;
     long depart = -1;
-    function<void(Request&)> callback; // call back with more info
+    function<void(Request&)> callback; // call back with more info, callers should pass small functors (e.g., a lambda capturing this) to avoid heap allocation
 
-    // ChampSim's memory controller's packet
-    PACKET packet;
+    // index of ChampSim's packet in the memory controller's packet pool, the packet itself stays in the memory controller
+    uint32_t packet_index = NO_PACKET;
 
-    std::array<uint8_t, BLOCK_SIZE> data = {0}; // a cache line
     uint8_t memory_id = NUMBER_OF_MEMORIES;
 
     /* Member functions */
@@ -66,8 +132,8 @@ public:
     }
 
     // This instructor is used for ChampSim's memory controller
-    Request(long addr, Type type, function<void(Request&)> callback, PACKET packet, int coreid, uint8_t memory_id)
-        : is_first_command(true), addr(addr), coreid(coreid), type(type), callback(callback), packet(packet), memory_id(memory_id)
+    Request(long addr, Type type, const function<void(Request&)>& callback, uint32_t packet_index, int coreid, uint8_t memory_id)
+        : is_first_command(true), addr(addr), coreid(coreid), type(type), callback(callback), packet_index(packet_index), memory_id(memory_id)
     {
     }
 
@@ -126,6 +192,181 @@ public:
 #endif  // USER_CODES, RAMULATOR
 };
 
+#if (MEMORY_USE_POOLED_REQUEST_QUEUES == ENABLE)
+/** @brief
+ *  A controller's queue of requests in place of list<Request>. The requests are kept in a slab of nodes which are
+ *  linked by their indices, and the nodes of erased requests are reused. So the queue allocates only when it grows
+ *  beyond the capacity reserved for it, and an iterator stays valid until its request is erased.
+ */
+class RequestList
+{
+    struct Node
+    {
+        Request req;
+        int prev;
+        int next;
+    };
+
+public:
+    class iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Request value_type;
+        typedef ptrdiff_t difference_type;
+        typedef Request* pointer;
+        typedef Request& reference;
+
+        iterator() : list(nullptr), index(-1) {}
+        iterator(RequestList* list, int index) : list(list), index(index) {}
+
+        Request& operator*() const { return list->nodes[index].req; }
+        Request* operator->() const { return &list->nodes[index].req; }
+
+        iterator& operator++()
+        {
+            index = list->nodes[index].next;
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+        iterator& operator--()
+        {
+            index = (index < 0) ? list->tail : list->nodes[index].prev;
+            return *this;
+        }
+        iterator operator--(int)
+        {
+            iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const iterator& other) const { return index == other.index && list == other.list; }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+        RequestList* list;
+        int index; // -1 is end()
+
+        friend class RequestList;
+    };
+
+    void reserve(size_t capacity) { nodes.reserve(capacity); }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    iterator begin() { return iterator(this, head); }
+    iterator end() { return iterator(this, -1); }
+
+    void push_back(const Request& req)
+    {
+        int index;
+        if (free_head >= 0)
+        {
+            index = free_head;
+            free_head = nodes[index].next;
+            nodes[index].req = req;
+        }
+        else
+        {
+            index = nodes.size();
+            nodes.push_back({req, -1, -1});
+        }
+
+        nodes[index].prev = tail;
+        nodes[index].next = -1;
+        if (tail >= 0)
+            nodes[tail].next = index;
+        else
+            head = index;
+        tail = index;
+        length++;
+    }
+
+    void pop_back() { erase(iterator(this, tail)); }
+
+    iterator erase(iterator req)
+    {
+        Node& node = nodes[req.index];
+        if (node.prev >= 0)
+            nodes[node.prev].next = node.next;
+        else
+            head = node.next;
+        if (node.next >= 0)
+            nodes[node.next].prev = node.prev;
+        else
+            tail = node.prev;
+        length--;
+
+        int next = node.next;
+        node.next = free_head;
+        free_head = req.index;
+        return iterator(this, next);
+    }
+
+private:
+    vector<Node> nodes;
+    int head = -1;
+    int tail = -1;
+    int free_head = -1; // the erased nodes linked by next
+    size_t length = 0;
+};
+
+/** @brief
+ *  The reads waiting for their data in a ring buffer in place of deque<Request>, which only grows when it is full.
+ */
+class RequestFifo
+{
+public:
+    void reserve(size_t capacity)
+    {
+        if (capacity > slots.size())
+            grow(capacity);
+    }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    Request& operator[](size_t i) { return slots[(first + i) % slots.size()]; }
+    Request& front() { return slots[first]; }
+
+    void push_back(const Request& req)
+    {
+        if (length == slots.size())
+            grow(max(size_t(16), 2 * slots.size()));
+        slots[(first + length) % slots.size()] = req;
+        length++;
+    }
+
+    void pop_front()
+    {
+        first = (first + 1) % slots.size();
+        length--;
+    }
+
+private:
+    vector<Request> slots;
+    size_t first = 0;
+    size_t length = 0;
+
+    void grow(size_t capacity)
+    {
+        vector<Request> new_slots(capacity);
+        for (size_t i = 0; i < length; i++)
+            new_slots[i] = (*this)[i];
+        slots.swap(new_slots);
+        first = 0;
+    }
+};
+#else
+typedef list<Request> RequestList;
+typedef deque<Request> RequestFifo;
+#endif  // MEMORY_USE_POOLED_REQUEST_QUEUES
+
 } /*namespace ramulator*/
 
 #endif /*__REQUEST_H*/
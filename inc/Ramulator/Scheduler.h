@@ -55,6 +55,8 @@ Current Row Policies:
 #include <functional>
 #include <cassert>
 
+#include "ProjectConfiguration.h" // user file
+
 using namespace std;
 
 namespace ramulator
@@ -63,6 +65,268 @@ namespace ramulator
 template <typename T>
 class Controller;
 
+#if (MEMORY_USE_BANK_INDEXED_SCHEDULER == ENABLE)
+// The requests of a controller's queue sorted into sub-queues by bank (the levels above Row). The scheduler keeps
+// the first command, readiness and row state of each row in a bank, and computes them again only after the
+// controller issues a command, since only the issued commands change the timing and the states of the DRAM.
+template <typename T>
+class BankQueues
+{
+public:
+    typedef RequestList::iterator ReqIter;
+
+    struct Entry
+    {
+        ReqIter req;
+        unsigned long order; // the position in the queue, requests are only appended to the queue
+    };
+
+    // the requests of the same type to the same row of a bank share their first command and row state
+    struct Group
+    {
+        Entry oldest; // the first request of the group in FCFS order
+        long ready_clk; // the first command of the requests is ready from this clock
+        bool hit;
+        bool open;
+        bool capped; // the row has served at most cap hits
+    };
+
+    struct Bank
+    {
+        vector<Entry> entries; // in queue order
+        vector<Group> groups;
+        long issued_commands = -1; // the groups are valid while the controller has issued this number of commands
+        int active_index = -1; // the position in active_banks, -1 means the bank has no requests
+    };
+
+    vector<Bank> banks; // the last one holds the requests which don't address a bank (e.g., refreshing a rank)
+    vector<int> active_banks; // the banks with requests, the scheduler only visits them
+
+    void init(const T* spec)
+    {
+        this->spec = spec;
+        int bank_number = 1;
+        for (int lev = 1; lev < int(T::Level::Row); lev++)
+            bank_number *= spec->org_entry.count[lev];
+        banks.resize(bank_number + 1);
+    }
+
+    void insert(ReqIter req)
+    {
+        Bank& bank = banks[get_bank(req->addr_vec)];
+        bank.entries.push_back({req, next_order++});
+        bank.issued_commands = -1;
+
+        if (bank.active_index < 0)
+        {
+            bank.active_index = active_banks.size();
+            active_banks.push_back(&bank - banks.data());
+        }
+    }
+
+    void erase(ReqIter req)
+    {
+        Bank& bank = banks[get_bank(req->addr_vec)];
+        auto entry = find_if(bank.entries.begin(), bank.entries.end(), [req](const Entry& e) { return e.req == req; });
+        assert(entry != bank.entries.end());
+        bank.entries.erase(entry);
+        bank.issued_commands = -1;
+
+        if (bank.entries.empty())
+        {
+            // move the last active bank into the place of this bank
+            int last = active_banks.back();
+            active_banks[bank.active_index] = last;
+            banks[last].active_index = bank.active_index;
+            active_banks.pop_back();
+            bank.active_index = -1;
+        }
+    }
+
+    // the order of the FCFS policy, ties of arrival are broken by the position in the queue
+    static bool is_older(const Entry& entry1, const Entry& entry2)
+    {
+        if (entry1.req->arrive != entry2.req->arrive)
+            return entry1.req->arrive < entry2.req->arrive;
+        return entry1.order < entry2.order;
+    }
+
+private:
+    const T* spec = nullptr;
+    unsigned long next_order = 0;
+
+    int get_bank(const AddrVec& addr_vec) const
+    {
+        int bank = 0;
+        for (int lev = 1; lev < int(T::Level::Row); lev++)
+        {
+            if (addr_vec[lev] < 0)
+                return banks.size() - 1;
+            bank = bank * spec->org_entry.count[lev] + addr_vec[lev];
+        }
+        return bank;
+    }
+};
+
+template <typename T>
+class Scheduler
+{
+public:
+    Controller<T>* ctrl;
+
+    enum class Type {
+        FCFS, FRFCFS, FRFCFS_Cap, FRFCFS_PriorHit, MAX
+    };
+    static constexpr Type type = Type::FRFCFS_Cap; //Change this line to change scheduling policy
+
+    long cap = 16; //Change this line to change cap
+
+    Scheduler(Controller<T>* ctrl) : ctrl(ctrl) {}
+
+    // the same head as the linear scan below, but each row of a bank with requests is evaluated once per issued command
+    RequestList::iterator get_head(typename Controller<T>::Queue& queue)
+    {
+        return get_head<type>(queue);
+    }
+
+private:
+    typedef RequestList::iterator ReqIter;
+    typedef typename BankQueues<T>::Entry Entry;
+    typedef typename BankQueues<T>::Group Group;
+    typedef typename BankQueues<T>::Bank Bank;
+
+    template <Type policy>
+    ReqIter get_head(typename Controller<T>::Queue& queue)
+    {
+        BankQueues<T>& index = queue.banks;
+
+        // the group of the head and whether it is prioritized
+        const Group* head = nullptr;
+        bool head_prior = false;
+        for (int b : index.active_banks)
+        {
+            Bank& bank = index.banks[b];
+            update_groups<policy>(bank);
+            for (const Group& group : bank.groups)
+            {
+                bool prior = is_prior<policy>(group);
+                if (head == nullptr || is_better(prior, group, head_prior, *head))
+                {
+                    head = &group;
+                    head_prior = prior;
+                }
+            }
+        }
+
+        if (head == nullptr)
+            return queue.q.end();
+
+        if (policy != Type::FRFCFS_PriorHit || head_prior)
+            return head->oldest.req;
+
+        // FRFCFS_PriorHit: no ready row hit, so take the FRFCFS head among the requests which don't close a row
+        // that other requests hit.
+        // TODO Here it assumes all DRAM standards use PRE to close a row
+        int scope = int(ctrl->channel->spec->scope[int(T::Command::PRE)]) + 1;
+        vector<const int*> hit_rowgroups;
+        for (int b : index.active_banks)
+            for (const Group& group : index.banks[b].groups)
+                if (group.hit)
+                    hit_rowgroups.push_back(group.oldest.req->addr_vec.data());
+
+        head = nullptr;
+        for (int b : index.active_banks)
+        {
+            for (const Group& group : index.banks[b].groups)
+            {
+                if (!group.hit && group.open)
+                {
+                    const int* rowgroup = group.oldest.req->addr_vec.data();
+                    if (any_of(hit_rowgroups.begin(), hit_rowgroups.end(),
+                               [rowgroup, scope](const int* hit_rowgroup) { return equal(rowgroup, rowgroup + scope, hit_rowgroup); }))
+                        continue;
+                }
+
+                bool prior = is_prior<Type::FRFCFS>(group);
+                if (head == nullptr || is_better(prior, group, head_prior, *head))
+                {
+                    head = &group;
+                    head_prior = prior;
+                }
+            }
+        }
+
+        // if we can't find proper request, we need to return q.end(),
+        // so that no command will be scheduled
+        return head ? head->oldest.req : queue.q.end();
+    }
+
+    // sort the requests of a bank into groups again if a command is issued or the bank's requests are changed
+    template <Type policy>
+    void update_groups(Bank& bank)
+    {
+        if (bank.issued_commands == ctrl->issued_commands)
+            return;
+        bank.issued_commands = ctrl->issued_commands;
+        bank.groups.clear();
+
+        for (const Entry& entry : bank.entries)
+        {
+            const Request& req = *entry.req;
+            auto group = find_if(bank.groups.begin(), bank.groups.end(), [&req](const Group& g) {
+                const Request& req2 = *g.oldest.req;
+                return req.type == req2.type && equal(req.addr_vec.begin(), req.addr_vec.begin() + int(T::Level::Row) + 1, req2.addr_vec.begin());
+            });
+            if (group != bank.groups.end())
+            {
+                if (BankQueues<T>::is_older(entry, group->oldest))
+                    group->oldest = entry;
+                continue;
+            }
+
+            Group new_group = {entry, 0, false, false, false};
+            if constexpr (policy != Type::FCFS)
+            {
+                // cmd must be decided by the request type, not the first cmd
+                typename T::Command cmd = ctrl->channel->spec->translate[int(req.type)];
+                typename T::Command first_cmd = ctrl->channel->decode(cmd, req.addr_vec.data());
+                new_group.ready_clk = ctrl->channel->get_next(first_cmd, req.addr_vec.data());
+                if constexpr (policy == Type::FRFCFS_Cap)
+                    new_group.capped = ctrl->rowtable->get_hits(req.addr_vec) <= cap;
+                if constexpr (policy == Type::FRFCFS_PriorHit)
+                {
+                    new_group.hit = ctrl->channel->check_row_hit(cmd, req.addr_vec.data());
+                    new_group.open = ctrl->channel->check_row_open(cmd, req.addr_vec.data());
+                }
+            }
+            bank.groups.push_back(new_group);
+        }
+    }
+
+    // whether the policy prefers the requests of a group over the older requests
+    template <Type policy>
+    bool is_prior(const Group& group) const
+    {
+        if constexpr (policy == Type::FCFS)
+            return false;
+
+        // the same as DRAM<T>::check(), since no command is issued after ready_clk is found
+        bool ready = ctrl->clk >= group.ready_clk;
+        if constexpr (policy == Type::FRFCFS_Cap)
+            return ready && group.capped;
+        if constexpr (policy == Type::FRFCFS_PriorHit)
+            return ready && group.hit;
+        return ready;
+    }
+
+    static bool is_better(bool prior1, const Group& group1, bool prior2, const Group& group2)
+    {
+        if (prior1 != prior2)
+            return prior1;
+        return BankQueues<T>::is_older(group1.oldest, group2.oldest);
+    }
+};
+#else
 template <typename T>
 class Scheduler
 {
@@ -77,8 +341,9 @@ public:
 
     Scheduler(Controller<T>* ctrl) : ctrl(ctrl) {}
 
-    list<Request>::iterator get_head(list<Request>& q)
+    RequestList::iterator get_head(typename Controller<T>::Queue& queue)
     {
+        RequestList& q = queue.q;
         // TODO make the decision at compile time
         if (type != Type::FRFCFS_PriorHit) {
             //If queue is empty, return end of queue
@@ -156,7 +421,7 @@ public:
 
 //Compare functions for each memory schedulers
 private:
-    typedef list<Request>::iterator ReqIter;
+    typedef RequestList::iterator ReqIter;
     function<ReqIter(ReqIter, ReqIter)> compare[int(Type::MAX)] = {
         // FCFS
         [this] (ReqIter req1, ReqIter req2) {
@@ -205,6 +470,7 @@ private:
             return req2;}
     };
 };
+#endif  // MEMORY_USE_BANK_INDEXED_SCHEDULER
 
 
 // Row Precharge Policy
@@ -283,7 +549,7 @@ public:
 
     RowTable(Controller<T>* ctrl) : ctrl(ctrl) {}
 
-    void update(typename T::Command cmd, const vector<int>& addr_vec, long clk)
+    void update(typename T::Command cmd, const AddrVec& addr_vec, long clk)
     {
         auto begin = addr_vec.begin();
         auto end = begin + int(T::Level::Row);
@@ -326,7 +592,7 @@ public:
         } /* closing */
     }
 
-    int get_hits(const vector<int>& addr_vec, const bool to_opened_row = false)
+    int get_hits(const AddrVec& addr_vec, const bool to_opened_row = false)
     {
         auto begin = addr_vec.begin();
         auto end = begin + int(T::Level::Row);
@@ -344,7 +610,7 @@ public:
         return itr->second.hits;
     }
 
-    int get_open_row(const vector<int>& addr_vec) {
+    int get_open_row(const AddrVec& addr_vec) {
         auto begin = addr_vec.begin();
         auto end = begin + int(T::Level::Row);
 
@@ -5,11 +5,13 @@
 #include <iostream>
 #include <cassert>
 #include <deque>
+#include <limits>
 
 #include "champsim_constants.h"
 #include "memory_class.h"
 #include "util.h"
 #include "ProjectConfiguration.h" // user file
+#include "os_transparent_management.h"
 
 /** @note Abbreviation:
  *  FM -> Fast memory (e.g., HBM, DDR4)
@@ -28,30 +30,30 @@
 #define HOTNESS_DEFAULT_VALUE                   (false)
 
 #define REMAPPING_LOCATION_WIDTH                uint8_t
-#define REMAPPING_LOCATION_WIDTH_BITS           (3)  // default: 3
+#define CAMEO_REMAPPING_LOCATION_WIDTH_BITS     (3)  // default: 3
 #define LOCATION_TABLE_ENTRY_WIDTH              uint16_t
 
-#define NUMBER_OF_BLOCK                         (5) // default: 5
+#define CAMEO_NUMBER_OF_BLOCK                   (5) // default: 5
 
 // 0x0538 for the congruence group with 5 members (lines) at most, (000_001_010_011_100_0 = 0x0538)
 // [15:13] bit for member 0, [12:10] bit for member 1, [9:7] bit for member 2, [6:4] bit for member 3, [3:1] bit for member 4.
 #define LOCATION_TABLE_ENTRY_DEFAULT_VALUE      (0x0538)
 #define LOCATION_TABLE_ENTRY_MSB                (UINT16_WIDTH - 1)  // MSB -> most significant bit
 
-#define REMAPPING_REQUEST_QUEUE_LENGTH          (64)  // 1024/4096
+#define CAMEO_REMAPPING_REQUEST_QUEUE_LENGTH    (64)  // 1024/4096
 #define QUEUE_BUSY_DEGREE_THRESHOLD             (0.8f)
 
 #define INCOMPLETE_READ_REQUEST_QUEUE_LENGTH    (128)
 #define INCOMPLETE_WRITE_REQUEST_QUEUE_LENGTH   (128)
 
 #if (BITS_MANIPULATION == DISABLE)
-#undef REMAPPING_LOCATION_WIDTH_BITS
-#undef NUMBER_OF_BLOCK
-#define REMAPPING_LOCATION_WIDTH_BITS           (lg2(64))
-#define NUMBER_OF_BLOCK                         (35)
+#undef CAMEO_REMAPPING_LOCATION_WIDTH_BITS
+#undef CAMEO_NUMBER_OF_BLOCK
+#define CAMEO_REMAPPING_LOCATION_WIDTH_BITS     (lg2(64))
+#define CAMEO_NUMBER_OF_BLOCK                   (35)
 #endif  // BITS_MANIPULATION
 
-class OS_TRANSPARENT_MANAGEMENT
+class CAMEO final: public OS_TRANSPARENT_MANAGEMENT
 {
 public:
     uint64_t cycle = 0;
@@ -66,12 +68,6 @@ public:
     std::vector<HOTNESS_WIDTH>& hotness_table;      // A hotness bit for every data block, true -> data block is hot, false -> data block is cold.
 
     /* Remapping request */
-    struct RemappingRequest
-    {
-        uint64_t address_in_fm, address_in_sm;  // hardware address in fast and slow memories
-        REMAPPING_LOCATION_WIDTH fm_location, sm_location;
-        uint8_t size;   // number of cache lines to remap
-    };
     std::deque<RemappingRequest> remapping_request_queue;
     uint64_t remapping_request_queue_congestion;
 
@@ -79,7 +75,7 @@ public:
     enum class RemappingLocation: REMAPPING_LOCATION_WIDTH
     {
         Zero = 0, One, Two, Three, Four,
-        Max = NUMBER_OF_BLOCK
+        Max = CAMEO_NUMBER_OF_BLOCK
     };
 
     uint8_t  congruence_group_msb;      // most significant bit of congruence group, and its address format is in the byte granularity
@@ -90,7 +86,7 @@ public:
 #else
     struct LocationTableEntry
     {
-        REMAPPING_LOCATION_WIDTH location[NUMBER_OF_BLOCK]; // location field for each line, location[0] is for the line in NM
+        REMAPPING_LOCATION_WIDTH location[CAMEO_NUMBER_OF_BLOCK]; // location field for each line, location[0] is for the line in NM
 
         LocationTableEntry()
         {
@@ -129,27 +125,36 @@ public:
 #endif  // COLOCATED_LINE_LOCATION_TABLE
 
     /* Member functions */
-    OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address);
-    ~OS_TRANSPARENT_MANAGEMENT();
+    CAMEO(uint64_t max_address, uint64_t fast_memory_max_address);
+    ~CAMEO() override;
 
     // address is physical address and at byte granularity
 #if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
     // address is physical address and at byte granularity
-    bool memory_activity_tracking(uint64_t address, uint8_t type, uint8_t type_origin, float queue_busy_degree);
+    bool memory_activity_tracking(uint64_t address, uint8_t type, uint8_t type_origin, float queue_busy_degree) override;
 #else
     // address is physical address and at byte granularity
-    bool memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree);
+    bool memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree) override;
 #endif // TRACKING_LOAD_STORE_STATISTICS
 
     // translate the physical address to hardware address
-    void physical_to_hardware_address(PACKET& packet);
-    void physical_to_hardware_address(uint64_t& address);
+    void physical_to_hardware_address(PACKET& packet) override;
+    void physical_to_hardware_address(uint64_t& address) override;
 
-    bool issue_remapping_request(RemappingRequest& remapping_request);
-    bool finish_remapping_request();
+    bool issue_remapping_request(RemappingRequest& remapping_request) override;
+    bool finish_remapping_request() override;
 
     // detect cold data block
-    void cold_data_detection();
+    void cold_data_detection() override;
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+    uint64_t idle_cycles() override;
+    void skip_cycles(uint64_t cycles) override;
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+    void checkpoint(CHECKPOINT& checkpoint) override;
+#endif  // SIMULATION_USE_CHECKPOINT
 
 #if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
     bool finish_fm_access_in_incomplete_read_request_queue(uint64_t h_address);
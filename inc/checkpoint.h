@@ -0,0 +1,161 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+#include <cstdio>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ProjectConfiguration.h" // user file
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#define CHECKPOINT_MAGIC_NUMBER     (0x54504B4843524D43ull)  // "CMRCHKPT" in little endian
+#define CHECKPOINT_VERSION          (3u)
+
+/** @brief
+ *  A checkpoint file holding the simulator state after warmup, it is written by --save_checkpoint and read by --load_checkpoint.
+ *  Every component saves and restores its state in the same member function (e.g., CACHE::checkpoint()), which passes
+ *  its members to transfer(). transfer() writes a member when saving and overwrites it when restoring, thus saving and
+ *  restoring always go through the file in the same order.
+ *  Every component begins with section() and check()s the parameters its state depends on (e.g., sets and ways of a cache),
+ *  so a checkpoint of an incompatible configuration is rejected instead of being misread.
+ *
+ *  Only the long-lived state is in the checkpoint. The in-flight state (pipeline, queues, MSHRs and DRAM) is not, and
+ *  the restored simulation starts with empty queues.
+ */
+class CHECKPOINT
+{
+public:
+    enum class Mode: uint8_t
+    {
+        Save, Restore
+    };
+
+    const Mode mode;
+    const std::string file_name;
+
+    /* Member functions */
+    CHECKPOINT(const std::string& file_name, Mode mode);
+    ~CHECKPOINT();
+
+    bool is_saving() const { return mode == Mode::Save; };
+    bool is_restoring() const { return mode == Mode::Restore; };
+
+    // write the name of a component, or make sure the next component in the file has this name.
+    void section(const std::string& name);
+
+    // write a parameter, or make sure the saved parameter equals the one of this simulation.
+    template<typename T>
+    void check(const char* name, T value)
+    {
+        T saved_value = value;
+        transfer(saved_value);
+
+        if (saved_value != value)
+        {
+            std::cout << __func__ << ": " << file_name << " is saved with " << name << " " << +saved_value << ", but this simulation uses " << +value << "." << std::endl;
+            abort();
+        }
+    };
+
+    template<typename T>
+    void transfer(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable members are transferred as bytes.");
+        transfer_bytes(&value, sizeof(T));
+    };
+
+    template<typename T1, typename T2>
+    void transfer(std::pair<T1, T2>& value)
+    {
+        transfer(value.first);
+        transfer(value.second);
+    };
+
+    template<typename... TYPES>
+    void transfer(std::tuple<TYPES...>& value)
+    {
+        std::apply([this](TYPES&... element) { (transfer(element), ...); }, value);
+    };
+
+    void transfer(std::string& value);
+    void transfer(std::vector<bool>& values);
+
+    template<typename T>
+    void transfer(std::vector<T>& values)
+    {
+        values.resize(transfer_size(values.size()));
+
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            transfer_bytes(values.data(), values.size() * sizeof(T));
+        }
+        else
+        {
+            for (T& value : values)
+            {
+                transfer(value);
+            }
+        }
+    };
+
+    template<typename T>
+    void transfer(std::deque<T>& values)
+    {
+        values.resize(transfer_size(values.size()));
+
+        for (T& value : values)
+        {
+            transfer(value);
+        }
+    };
+
+    template<typename KEY, typename VALUE, typename HASH>
+    void transfer(std::unordered_map<KEY, VALUE, HASH>& values)
+    {
+        uint64_t size = transfer_size(values.size());
+
+        if (is_saving())
+        {
+            for (auto& [key, value] : values)
+            {
+                KEY saved_key = key;
+                transfer(saved_key);
+                transfer(value);
+            }
+        }
+        else
+        {
+            values.clear();
+            values.reserve(size);
+            for (uint64_t i = 0; i < size; i++)
+            {
+                KEY key;
+                VALUE value;
+                transfer(key);
+                transfer(value);
+                values.emplace(std::move(key), std::move(value));
+            }
+        }
+    };
+
+private:
+    FILE* file = NULL;
+
+    void transfer_bytes(void* data, std::size_t size);
+
+    // write the size of a container, or return the saved size.
+    uint64_t transfer_size(uint64_t size)
+    {
+        transfer(size);
+        return size;
+    };
+};
+
+#endif  // SIMULATION_USE_CHECKPOINT
+#endif  // CHECKPOINT_H
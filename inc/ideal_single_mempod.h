@@ -5,12 +5,16 @@
 #include <iostream>
 #include <cassert>
 #include <deque>
-#include <unordered_map>
+#include <array>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
 
 #include "champsim_constants.h"
 #include "memory_class.h"
 #include "util.h"
 #include "ProjectConfiguration.h" // user file
+#include "os_transparent_management.h"
 
 /** @note Abbreviation:
  *  FM -> Fast memory (e.g., HBM, DDR4)
@@ -19,7 +23,7 @@
 */
 
 /*
-    MemPod's MEA Counter tracks data segment at DATA_MANAGEMENT_GRANULARITY, 
+    MemPod's MEA Counter tracks data segment at MEMPOD_DATA_MANAGEMENT_GRANULARITY, 
     and at Physical Address, not Hardware Address.
 */
 
@@ -29,10 +33,10 @@
 
 /* MemPod Parameter Setting */
 #define TIME_INTERVAL_MEMPOD_us         (50) // [us]
-#define DATA_MANAGEMENT_GRANULARITY     (2048) // [B] default:2048
-#define DATA_MANAGEMENT_OFFSET_BITS     (lg2(DATA_MANAGEMENT_GRANULARITY)) // [bit]
+#define MEMPOD_DATA_MANAGEMENT_GRANULARITY  (2048) // [B] default:2048
+#define MEMPOD_DATA_MANAGEMENT_OFFSET_BITS  (lg2(MEMPOD_DATA_MANAGEMENT_GRANULARITY)) // [bit]
 #define CACHE_LINE_SIZE                 (64) // [B]
-#define SWAP_DATA_CACHE_LINES           (DATA_MANAGEMENT_GRANULARITY / CACHE_LINE_SIZE) //[lines]
+#define SWAP_DATA_CACHE_LINES           (MEMPOD_DATA_MANAGEMENT_GRANULARITY / CACHE_LINE_SIZE) //[lines]
 
 
 /* for mea_counter_table */
@@ -46,7 +50,7 @@
 #define REMAPPING_TABLE_ENTRY_WIDTH     uint64_t
 
 /* for swapping */
-#define REMAPPING_REQUEST_QUEUE_LENGTH          (4096)  // 1024/4096
+#define MEMPOD_REMAPPING_REQUEST_QUEUE_LENGTH   (4096)  // 1024/4096
 #define QUEUE_BUSY_DEGREE_THRESHOLD_UP          (0.9f)
 #define QUEUE_BUSY_DEGREE_THRESHOLD_DOWN        (0.8f)
 #define QUEUE_BUSY_DEGREE_THRESHOLD             (0.8f)
@@ -54,9 +58,7 @@
 #define INCOMPLETE_READ_REQUEST_QUEUE_LENGTH    (128)
 #define INCOMPLETE_WRITE_REQUEST_QUEUE_LENGTH   (128)
 
-extern uint8_t all_warmup_complete;
-
-class OS_TRANSPARENT_MANAGEMENT
+class MEMPOD final: public OS_TRANSPARENT_MANAGEMENT
 {
 public:
     uint64_t cycle = 0;
@@ -68,14 +70,6 @@ public:
     uint8_t  swap_size = SWAP_DATA_CACHE_LINES; // == 32
     REMAPPING_TABLE_ENTRY_WIDTH swap_fm_address_itr = 0;
 
-    /* Remapping request */
-    struct RemappingRequest
-    {
-        uint64_t h_address_in_fm, h_address_in_sm;  // hardware address in fast and slow memories
-        uint64_t p_address_in_fm, p_address_in_sm;  // physical address in fast and slow memories
-        uint8_t size;   // number of cache lines to remap == 32 (2048B)
-    };
-
     struct PhysicalHardwareAddressTuple
     {
         uint64_t p_address, h_address;
@@ -85,9 +79,28 @@ public:
         }
     };
 
-    std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, MEA_COUNTER_WIDTH>& mea_counter_table;
-    std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, REMAPPING_TABLE_ENTRY_WIDTH>& address_remapping_table;
-    std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, REMAPPING_TABLE_ENTRY_WIDTH>& invert_address_remapping_table;
+    /* MEA counter entry */
+    struct MEACounterEntry
+    {
+        REMAPPING_TABLE_ENTRY_WIDTH segment_address = 0;
+        uint64_t counter = COUNTER_DEFAULT_VALUE; // stored value, the real counter value is (counter - mea_counter_offset)
+    };
+
+    /** @brief
+     *  The MEA counter table has NUMBER_MEA_COUNTER fixed slots. Decrementing all counters is done by incrementing
+     *  mea_counter_offset, and a slot is valid only if its stored counter is larger than mea_counter_offset.
+     *  Thus, the counters whose real values drop to 0 are evicted implicitly.
+     */
+    std::array<MEACounterEntry, NUMBER_MEA_COUNTER> mea_counter_table;
+    uint64_t mea_counter_offset = 0;
+
+    /** @brief
+     *  Dense remapping tables indexed by the segment address, the default value of each entry is its own index.
+     *  address_remapping_table has total_capacity_at_granularity entries (physical -> hardware),
+     *  invert_address_remapping_table has fast_memory_capacity_at_granularity entries (hardware -> physical).
+     */
+    std::vector<REMAPPING_TABLE_ENTRY_WIDTH>& address_remapping_table;
+    std::vector<REMAPPING_TABLE_ENTRY_WIDTH>& invert_address_remapping_table;
 
     std::deque<RemappingRequest> remapping_request_queue;
     uint64_t remapping_request_queue_congestion;
@@ -97,28 +110,37 @@ public:
     uint32_t intervals;
 
     /* Member functions */
-    OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address);
-    ~OS_TRANSPARENT_MANAGEMENT();
+    MEMPOD(uint64_t max_address, uint64_t fast_memory_max_address);
+    ~MEMPOD() override;
 
 #if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
     // address is physical address and at byte granularity
-    bool memory_activity_tracking(uint64_t address, uint8_t type, uint8_t type_origin, float queue_busy_degree);
+    bool memory_activity_tracking(uint64_t address, uint8_t type, uint8_t type_origin, float queue_busy_degree) override;
 #else
     // address is physical address and at byte granularity
-    bool memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree);
+    bool memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree) override;
 #endif // TRACKING_LOAD_STORE_STATISTICS
 
     // translate the physical address to hardware address
-    void physical_to_hardware_address(PACKET& packet);
-    void physical_to_hardware_address(uint64_t& address);
+    void physical_to_hardware_address(PACKET& packet) override;
+    void physical_to_hardware_address(uint64_t& address) override;
 
     // detect cold data block and cycle increment
-    void cold_data_detection();
+    void cold_data_detection() override;
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+    uint64_t idle_cycles() override;
+    void skip_cycles(uint64_t cycles) override;
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+    void checkpoint(CHECKPOINT& checkpoint) override;
+#endif  // SIMULATION_USE_CHECKPOINT
 
     // MemPod interval swap
-    void check_interval_swap(uint8_t swapping_states);
-    bool issue_remapping_request(RemappingRequest& remapping_request);
-    bool finish_remapping_request();
+    void check_interval_swap(uint8_t swapping_states) override;
+    bool issue_remapping_request(RemappingRequest& remapping_request) override;
+    bool finish_remapping_request() override;
 
 private:
     void get_hot_page_from_mea_counter(std::vector<REMAPPING_TABLE_ENTRY_WIDTH>& hot_pages);
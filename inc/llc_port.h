@@ -0,0 +1,63 @@
+#ifndef LLC_PORT_H
+#define LLC_PORT_H
+#include <array>
+#include <deque>
+#include <vector>
+
+#include "cache.h"
+#include "ProjectConfiguration.h" // user file
+
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+/** @brief
+ *  The boundary between the private hierarchy of a core and the shared LLC in the parallel simulation of cores.
+ *  The L2C of the core sends its requests to this port instead of the LLC. The port queues them with the cycle they
+ *  are sent in, and forward_requests() hands them to the LLC once the LLC reaches that cycle. The LLC returns data to
+ *  this port, and deliver_responses() passes it to the L2C before the core runs its next quantum.
+ *  So the threads of the cores never touch the LLC, and the LLC only runs when the cores are stopped.
+ */
+class LLC_PORT: public MemoryRequestConsumer, public MemoryRequestProducer
+{
+public:
+    CACHE* upper_level = nullptr;   // the L2C of the core
+
+    /* Member functions */
+    explicit LLC_PORT(CACHE* llc);
+
+    // called by the L2C while the core runs, the queue types are the ones of CACHE::get_occupancy().
+    int add_rq(PACKET* packet) override { return add_request(RQ_TYPE, packet); };
+    int add_wq(PACKET* packet) override { return add_request(WQ_TYPE, packet); };
+    int add_pq(PACKET* packet) override { return add_request(PQ_TYPE, packet); };
+    uint32_t get_occupancy(uint8_t queue_type, uint64_t address) override;
+    uint32_t get_size(uint8_t queue_type, uint64_t address) override;
+
+    // pass the data returned by the LLC in the last quantum to the L2C.
+    void deliver_responses();
+
+    // called by the LLC while the cores are stopped.
+    void return_data(PACKET* packet) override;
+
+    // hand the requests sent before this cycle to the LLC, a request rejected by a full LLC queue is retried in the next cycle.
+    void forward_requests(uint64_t cycle);
+
+private:
+    enum QueueType: uint8_t
+    {
+        RQ_TYPE = 1, WQ_TYPE = 2, PQ_TYPE = 3,
+        QUEUE_TYPE_NUMBER
+    };
+
+    struct Request
+    {
+        uint64_t cycle;     // the cycle of the L2C when it sends this request
+        PACKET packet;
+    };
+
+    std::array<std::deque<Request>, QUEUE_TYPE_NUMBER> requests;
+    std::array<uint32_t, QUEUE_TYPE_NUMBER> queue_sizes {};   // the same as the queues of the LLC
+    std::vector<PACKET> responses;
+
+    int add_request(QueueType queue_type, PACKET* packet);
+};
+
+#endif  // SIMULATION_USE_PARALLEL_CORES
+#endif  // LLC_PORT_H
@@ -8,6 +8,8 @@
 #include <functional>
 #include <getopt.h>
 #include <iomanip>
+#include <limits>
+#include <memory>
 #include <signal.h>
 #include <string.h>
 #include <vector>
@@ -60,4 +62,16 @@
 #include "ptw.h"
 #endif
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif  // SIMULATION_USE_CHECKPOINT
+
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+#include "llc_port.h"
+#endif  // SIMULATION_USE_PARALLEL_CORES
+
+#if (USER_CODES == ENABLE) && (RAMULATOR == ENABLE)
+#include "memory_trace_replay.h"
+#endif  // USER_CODES, RAMULATOR
+
 #endif
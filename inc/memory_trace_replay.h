@@ -0,0 +1,68 @@
+#ifndef MEMORY_TRACE_REPLAY_H
+#define MEMORY_TRACE_REPLAY_H
+#include <cstdio>
+#include <string>
+
+#include "memory_class.h"
+#include "ProjectConfiguration.h" // user file
+
+#if (RAMULATOR == ENABLE)
+/** @brief
+ *  Drive the memory controller from a memory trace recorded with PRINT_MEMORY_TRACE, without the cores and caches.
+ *  Each line of the trace is "0x<address> <type> <cycle>", where the type is 'R' or 'W' for the requests from the LLC
+ *  and 'r' or 'w' for the requests of the swapping unit. The latter are skipped, the memory controller issues them again.
+ *  - Open loop (window is 0): a request is sent in its recorded cycle (relative to the first request), or later when
+ *    the queue of the memory controller is full.
+ *  - Closed loop (window > 0): the requests are sent in the recorded order as soon as less than window reads are in
+ *    flight, and the recorded cycles are ignored.
+ */
+class MEMORY_TRACE_REPLAY: public MemoryRequestProducer
+{
+public:
+    const uint32_t window;  // the maximum number of reads in flight, 0 means open loop
+
+    uint64_t read_number = 0, write_number = 0;  // requests accepted by the memory controller
+    uint64_t read_latency_sum = 0;               // cycles of the memory controller from sending a read to its data
+
+    /* Member functions */
+    MEMORY_TRACE_REPLAY(MemoryRequestConsumer* memory_controller, const std::string& trace_name, uint32_t window);
+    ~MEMORY_TRACE_REPLAY();
+
+    // send the next request into the memory controller during warmup, it is only used to train the research proposals.
+    // return false at the end of the trace.
+    bool warmup();
+
+    // the detailed replay starts from the next request.
+    void finish_warmup();
+
+    // send the requests which are due in this cycle, at most request_number requests are sent in total.
+    void operate(uint64_t cycle, uint64_t request_number);
+
+    // whether all requests are sent and all reads are returned.
+    bool is_finished(uint64_t request_number) const { return (has_record == false || read_number + write_number >= request_number) && inflight_read_number == 0; };
+
+    void return_data(PACKET* packet) override;
+
+private:
+    struct Record
+    {
+        uint64_t address;
+        uint64_t cycle;
+        bool is_write;
+    };
+
+    FILE* trace_file;
+    const std::string trace_name;
+    Record record = {};         // the next request to send
+    bool has_record = false;    // whether the trace has a next request
+    uint64_t first_cycle = 0, start_cycle = 0;  // the recorded cycle of the first request, and the cycle it is replayed
+    bool started = false;
+    uint64_t current_cycle = 0;
+    uint32_t inflight_read_number = 0;
+
+    void read_record();
+    int send_record(uint64_t cycle);    // return the value of add_rq() or add_wq()
+};
+
+#endif  // RAMULATOR
+#endif  // MEMORY_TRACE_REPLAY_H
@@ -5,17 +5,13 @@
 #include <iostream>
 #include <cassert>
 #include <deque>
+#include <string>
 
 #include "champsim_constants.h"
 #include "memory_class.h"
 #include "util.h"
 #include "ProjectConfiguration.h" // user file
 
-/* Includes for research */
-#include "cameo.h"
-#include "variable_granularity.h"
-#include "ideal_single_mempod.h"
-
 /** @note Abbreviation:
  *  FM -> Fast memory (e.g., HBM, DDR4)
  *  SM -> Slow memory (e.g., DDR4, PCM)
@@ -24,68 +20,88 @@
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 
-#if (NO_METHOD_FOR_RUN_HYBRID_MEMORY == ENABLE)
-#define COUNTER_WIDTH                   uint8_t
-#define COUNTER_MAX_VALUE               (UINT8_MAX)
-#define COUNTER_DEFAULT_VALUE           (0)
+extern uint8_t all_warmup_complete;  // the statistics of the designs only count after warmup
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+class CHECKPOINT;
+#endif  // SIMULATION_USE_CHECKPOINT
+
+/** @brief
+ *  The OS-transparent management designs. Every enabled design in ProjectConfiguration.h is compiled in and registered,
+ *  and the command line option --memory_policy <name> selects one of them for this simulation.
+ */
+enum class ManagementPolicy: uint8_t
+{
+    Cameo, VariableGranularity, MemPod,
+    Max
+};
 
-#define HOTNESS_WIDTH                   bool
-#define HOTNESS_DEFAULT_VALUE           (false)
+extern ManagementPolicy management_policy;  // the design used by this simulation, it is the first registered design by default.
 
-#define REMAPPING_LOCATION_WIDTH            uint8_t
-#define REMAPPING_LOCATION_WIDTH_BITS       (3)
+// find the registered design with this name, return false if no such design is compiled in.
+bool find_management_policy(const std::string& name, ManagementPolicy& policy);
+const char* get_management_policy_name(ManagementPolicy policy);
+void print_management_policies();
 
+/** @brief
+ *  The common interface of the OS-transparent management designs.
+ *  The memory controller calls these member functions through the final class of the selected design
+ *  (see MEMORY_CONTROLLER::visit_os_transparent_management()), so the virtual functions are only a fallback.
+ */
 class OS_TRANSPARENT_MANAGEMENT
 {
 public:
-    uint64_t cycle = 0;
-    COUNTER_WIDTH hotness_threshold = 0;
-    uint64_t total_capacity;        // uint is byte
-    uint64_t fast_memory_capacity;  // uint is byte
-    uint64_t total_capacity_at_data_block_granularity;
-    uint64_t fast_memory_capacity_at_data_block_granularity;
-    uint8_t  fast_memory_offset_bit;    // address format in the data management granularity
-
-    std::vector<COUNTER_WIDTH>& counter_table;      // A counter for every data block
-    std::vector<HOTNESS_WIDTH>& hotness_table;      // A hotness bit for every data block, true -> data block is hot, false -> data block is cold.
+    const ManagementPolicy policy;
 
     /* Remapping request */
     struct RemappingRequest
     {
-        uint64_t address_in_fm, address_in_sm;  // hardware address in fast and slow memories
-        REMAPPING_LOCATION_WIDTH fm_location, sm_location;
+        uint64_t address_in_fm, address_in_sm;      // hardware address in fast and slow memories
+        uint64_t p_address_in_fm, p_address_in_sm;  // physical address in fast and slow memories, only MemPod uses them
+        uint8_t fm_location, sm_location;           // locations in the congruence group (set), MemPod doesn't use them
         uint8_t size;   // number of cache lines to remap
     };
-    std::deque<RemappingRequest> remapping_request_queue;
-    uint64_t remapping_request_queue_congestion;
 
     /* Member functions */
-    OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address);
-    ~OS_TRANSPARENT_MANAGEMENT();
+    OS_TRANSPARENT_MANAGEMENT(ManagementPolicy policy): policy(policy) {};
+    virtual ~OS_TRANSPARENT_MANAGEMENT() {};
 
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+    // address is physical address and at byte granularity
+    virtual bool memory_activity_tracking(uint64_t address, uint8_t type, uint8_t type_origin, float queue_busy_degree) = 0;
+#else
     // address is physical address and at byte granularity
-    bool memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree);
+    virtual bool memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree) = 0;
+#endif // TRACKING_LOAD_STORE_STATISTICS
 
     // translate the physical address to hardware address
-    void physical_to_hardware_address(PACKET& packet);
-    void physical_to_hardware_address(uint64_t& address);
+    virtual void physical_to_hardware_address(PACKET& packet) = 0;
+    virtual void physical_to_hardware_address(uint64_t& address) = 0;
 
-    bool issue_remapping_request(RemappingRequest& remapping_request);
-    bool finish_remapping_request();
+    virtual bool issue_remapping_request(RemappingRequest& remapping_request) = 0;
+    virtual bool finish_remapping_request() = 0;
 
     // detect cold data block
-    void cold_data_detection();
-
-private:
-    // evict cold data block
-    bool cold_data_eviction(uint64_t source_address, float queue_busy_degree);
-
-    // add new remapping request into the remapping_request_queue
-    bool enqueue_remapping_request(RemappingRequest& remapping_request);
-
+    virtual void cold_data_detection() = 0;
+
+    // the designs which swap data at fixed intervals (e.g., MemPod) override it.
+    virtual void check_interval_swap(uint8_t swapping_states) {};
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+    // the number of following cycles in which cold_data_detection() and check_interval_swap() only count the cycle,
+    // provided that no memory request arrives. skip_cycles() advances the design over them.
+    virtual uint64_t idle_cycles() = 0;
+    virtual void skip_cycles(uint64_t cycles) = 0;
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+    // save or restore the tables (counters, remapping tables, etc.), the remapping requests in flight are not saved.
+    virtual void checkpoint(CHECKPOINT& checkpoint) = 0;
+#endif  // SIMULATION_USE_CHECKPOINT
 };
 
-#endif  // NO_METHOD_FOR_RUN_HYBRID_MEMORY
+// create the given design, only its tables are allocated.
+OS_TRANSPARENT_MANAGEMENT* create_os_transparent_management(ManagementPolicy policy, uint64_t max_address, uint64_t fast_memory_max_address);
 
 #endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 #endif  // OS_TRANSPARENT_MANAGEMENT_H
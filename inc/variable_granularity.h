@@ -10,6 +10,7 @@
 #include "memory_class.h"
 #include "util.h"
 #include "ProjectConfiguration.h" // user file
+#include "os_transparent_management.h"
 
 /** @note Abbreviation:
  *  FM -> Fast memory (e.g., HBM, DDR4)
@@ -29,7 +30,7 @@
 
 #define REMAPPING_LOCATION_WIDTH            uint8_t // default: uint8_t
 #define REMAPPING_LOCATION_WIDTH_SIGN       int8_t // default: int8_t
-#define REMAPPING_LOCATION_WIDTH_BITS       (lg2(64))
+#define VG_REMAPPING_LOCATION_WIDTH_BITS    (lg2(64))
 
 #define START_ADDRESS_WIDTH                 uint8_t
 #define START_ADDRESS_WIDTH_BITS            (6)
@@ -37,14 +38,14 @@
 #define MIGRATION_GRANULARITY_WIDTH         uint8_t
 #define MIGRATION_GRANULARITY_WIDTH_BITS    (3)
 
-#define NUMBER_OF_BLOCK                     (5) // default: 5
+#define VG_NUMBER_OF_BLOCK                  (5) // default: 5
 
-#define REMAPPING_REQUEST_QUEUE_LENGTH      (64)  // 1024/4096
+#define VG_REMAPPING_REQUEST_QUEUE_LENGTH   (64)  // 1024/4096
 #define QUEUE_BUSY_DEGREE_THRESHOLD         (0.8f)
 
 #define INTERVAL_FOR_DECREMENT              (1000000)   // default: 1000000
 
-class OS_TRANSPARENT_MANAGEMENT
+class VARIABLE_GRANULARITY final: public OS_TRANSPARENT_MANAGEMENT
 {
 public:
   uint64_t cycle = 0;
@@ -58,13 +59,14 @@ public:
   std::vector<COUNTER_WIDTH>& counter_table;      // A counter for every data block
   std::vector<HOTNESS_WIDTH>& hotness_table;      // A hotness bit for every data block, true -> data block is hot, false -> data block is cold.
 
+  /** @brief
+   *  The counters decay lazily. cold_data_detection() only advances decay_epoch every INTERVAL_FOR_DECREMENT cycles,
+   *  and a data block applies its pending halvings when it is touched next time (see apply_pending_decay()).
+   */
+  uint32_t decay_epoch = 0;
+  std::vector<uint32_t>& epoch_table;             // The decay_epoch when every data block was last brought up to date
+
   /* Remapping request */
-  struct RemappingRequest
-  {
-    uint64_t address_in_fm, address_in_sm;  // hardware address in fast and slow memories
-    REMAPPING_LOCATION_WIDTH fm_location, sm_location;
-    uint8_t size;   // number of cache lines to remap
-  };
   std::deque<RemappingRequest> remapping_request_queue;
   uint64_t remapping_request_queue_congestion;
 
@@ -75,7 +77,7 @@ public:
   enum class RemappingLocation: REMAPPING_LOCATION_WIDTH
   {
     Zero = 0, One, Two, Three, Four,
-    Max = NUMBER_OF_BLOCK
+    Max = VG_NUMBER_OF_BLOCK
   };
 
   uint8_t  set_msb;      // most significant bit of set, and its address format is in the byte granularity
@@ -105,6 +107,7 @@ public:
 
 #if (STATISTICS_INFORMATION == ENABLE)
     bool access_flag = false; // mark whether this page has ever been accessed.
+    bool temporal_access_flag = false; // mark whether this page is in temporal_accessed_blocks.
     bool access_stats[START_ADDRESS_WIDTH(StartAddress::Max)];            // record the accessed data line
     bool temporal_access_stats[START_ADDRESS_WIDTH(StartAddress::Max)];   // record the accessed data line for a fix intervsal (clear is possible)
     MIGRATION_GRANULARITY_WIDTH estimated_spatial_locality_stats = 0;     // store the estimated spatial locality for this page
@@ -131,18 +134,22 @@ public:
   /* Access distribution table */
   std::vector<AccessDistribution>& access_table;  // A access distribution for every data block
 
+#if (STATISTICS_INFORMATION == ENABLE)
+  std::vector<uint64_t> temporal_accessed_blocks; // data blocks whose temporal_access_stats is set in this interval
+#endif  // STATISTICS_INFORMATION
+
   struct PlacementEntry
   {
     REMAPPING_LOCATION_WIDTH cursor; // this cursor is used to track the position of next available group for migration in the placement entry.
-    REMAPPING_LOCATION_WIDTH tag[NUMBER_OF_BLOCK];
-    START_ADDRESS_WIDTH start_address[NUMBER_OF_BLOCK];
-    MIGRATION_GRANULARITY_WIDTH granularity[NUMBER_OF_BLOCK];
+    REMAPPING_LOCATION_WIDTH tag[VG_NUMBER_OF_BLOCK];
+    START_ADDRESS_WIDTH start_address[VG_NUMBER_OF_BLOCK];
+    MIGRATION_GRANULARITY_WIDTH granularity[VG_NUMBER_OF_BLOCK];
 
     PlacementEntry()
     {
       cursor = 0;
 
-      for (uint8_t i = 0; i < NUMBER_OF_BLOCK; i++)
+      for (uint8_t i = 0; i < VG_NUMBER_OF_BLOCK; i++)
       {
         tag[i] = REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero);
         start_address[i] = START_ADDRESS_WIDTH(StartAddress::Zero);
@@ -156,23 +163,40 @@ public:
   uint64_t expected_number_in_congruence_group = 0;
 
   /* Member functions */
-  OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address);
-  ~OS_TRANSPARENT_MANAGEMENT();
+  VARIABLE_GRANULARITY(uint64_t max_address, uint64_t fast_memory_max_address);
+  ~VARIABLE_GRANULARITY() override;
 
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+  // address is physical address and at byte granularity, type_origin isn't used by this design
+  bool memory_activity_tracking(uint64_t address, uint8_t type, uint8_t type_origin, float queue_busy_degree) override;
+#else
   // address is physical address and at byte granularity
-  bool memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree);
+  bool memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree) override;
+#endif // TRACKING_LOAD_STORE_STATISTICS
 
   // translate the physical address to hardware address
-  void physical_to_hardware_address(PACKET& packet);
-  void physical_to_hardware_address(uint64_t& address);
+  void physical_to_hardware_address(PACKET& packet) override;
+  void physical_to_hardware_address(uint64_t& address) override;
 
-  bool issue_remapping_request(RemappingRequest& remapping_request);
-  bool finish_remapping_request();
+  bool issue_remapping_request(RemappingRequest& remapping_request) override;
+  bool finish_remapping_request() override;
 
   // detect cold data block
-  void cold_data_detection();
+  void cold_data_detection() override;
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+  uint64_t idle_cycles() override;
+  void skip_cycles(uint64_t cycles) override;
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  void checkpoint(CHECKPOINT& checkpoint) override;
+#endif  // SIMULATION_USE_CHECKPOINT
 
 private:
+  // apply the halvings of the intervals passed since this data block was last touched
+  void apply_pending_decay(uint64_t data_block_address);
+
 #if (COLD_DATA_DETECTION_IN_GROUP == ENABLE)
   // detect cold data block in group
   void cold_data_detection_in_group(uint64_t source_address);
@@ -0,0 +1,174 @@
+#!/bin/bash
+
+# Simulate the SimPoint regions of a trace in parallel and aggregate their statistics by weight.
+#
+# Every line of the regions file is "<start-instruction> <weight>" ('#' starts a comment). A region is simulated
+# from its start instruction for <simulation-instructions> instructions, after warming up with the
+# <warmup-instructions> instructions in front of it. The simulator fast-forwards to the warmup with --skip_instructions.
+# Each region runs in its own directory <output-directory>/region_<n> and the weighted aggregate is written into
+# <output-directory>/aggregate.statistics.
+
+usage()
+{
+    echo "Usage: $0 [-j <jobs>] [-o <output-directory>] <regions-file> <warmup-instructions> <simulation-instructions> <execution> [<options>] <configs-file> [<configs-file2>] <trace-filename>"
+    echo "Example: $0 -j 8 -o lbm_simpoints lbm.regions 1000000 10000000 ./bin/champsim_plus_ramulator ramulator-configs1.cfg ramulator-configs2.cfg 619.lbm_s.champsimtrace.xz"
+    echo "Note: <options> (e.g., --memory_policy <name>) are passed to every simulation, the default of <jobs> is the number of host cores."
+}
+
+jobs_limit=$(nproc)
+output_directory=simpoints
+while getopts "j:o:h" option
+do
+    case $option in
+        j) jobs_limit=$OPTARG ;;
+        o) output_directory=$OPTARG ;;
+        *) usage; exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+if [ $# -lt 6 ]
+then
+    usage
+    exit 1
+fi
+
+regions_file=$1
+warmup_instructions=$2
+simulation_instructions=$3
+execution=$(realpath "$4")
+shift 4
+
+# every region runs in its own directory, so the files given to the simulator are passed with absolute paths.
+arguments=()
+for argument in "$@"
+do
+    if [ -e "$argument" ]
+    then
+        arguments+=("$(realpath "$argument")")
+    else
+        arguments+=("$argument")
+    fi
+done
+trace_name=$(basename "${arguments[-1]}")
+
+mkdir -p "$output_directory"
+region_number=0
+while read -r start_instruction weight others
+do
+    if [ -z "$start_instruction" ] || [[ $start_instruction == \#* ]]
+    then
+        continue
+    fi
+
+    directory=$output_directory/region_$region_number
+    mkdir -p "$directory"
+    rm -f "$directory/failed"
+    echo "$start_instruction $weight" > "$directory/region"
+
+    # a region near the beginning of the trace has a shorter warmup
+    region_warmup_instructions=$((start_instruction < warmup_instructions ? start_instruction : warmup_instructions))
+    skip_instructions=$((start_instruction - region_warmup_instructions))
+
+    # keep at most jobs_limit simulations running
+    while [ "$(jobs -rp | wc -l)" -ge "$jobs_limit" ]
+    do
+        wait -n
+    done
+
+    echo "Region $region_number: start instruction $start_instruction, weight $weight"
+    (
+        cd "$directory" || exit 1
+        "$execution" --skip_instructions $skip_instructions --warmup_instructions $region_warmup_instructions --simulation_instructions $simulation_instructions "${arguments[@]}" > simulation.log 2>&1 || touch failed
+    ) &
+
+    region_number=$((region_number + 1))
+done < "$regions_file"
+wait
+
+if [ $region_number -eq 0 ]
+then
+    echo "$regions_file has no region."
+    exit 1
+fi
+
+# aggregate the statistics of the finished regions.
+# IPC is aggregated as the weighted harmonic mean (i.e., the weighted CPI), the counters of the memory controller are
+# aggregated per instruction and scaled to <simulation-instructions>, and the hit rate of the fast memory is
+# recomputed from the aggregated requests.
+statistics_files=()
+for ((region = 0; region < region_number; region++))
+do
+    directory=$output_directory/region_$region
+    if [ -e "$directory/failed" ] || [ ! -e "$directory/$trace_name.statistics" ]
+    then
+        echo "Region $region failed, see $directory/simulation.log. It is excluded from the aggregate."
+        continue
+    fi
+    statistics_files+=("$directory/region" "$directory/$trace_name.statistics")
+done
+
+if [ ${#statistics_files[@]} -eq 0 ]
+then
+    echo "No region finished."
+    exit 1
+fi
+
+awk -v simulation_instructions="$simulation_instructions" '
+FILENAME ~ /\/region$/ {
+    weight = $2
+    total_weight += weight
+    region_count++
+    in_memory_controller = 0
+    next
+}
+/^CPU [0-9]+ cumulative IPC:/ {
+    cpu = $2
+    instructions[FILENAME] += $7
+    if (!(cpu in cpi)) cpu_order[cpu_count++] = cpu
+    cpi[cpu] += weight * $9 / $7
+    next
+}
+/^Information about memory controller/ {
+    in_memory_controller = 1
+    next
+}
+in_memory_controller && /: / {
+    # lines look like "name: value, name2: value2." or "name: value (ratio)."
+    line = $0
+    sub(/\.$/, "", line)
+    count = split(line, fields, ", ")
+    for (i = 1; i <= count; i++)
+    {
+        split(fields[i], pair, ": ")
+        name = pair[1]
+        value = pair[2]
+        sub(/ .*/, "", value)
+        if (name ~ /rate/) continue
+        if (!(name in counter)) counter_order[counter_count++] = name
+        counter[name] += weight * value / instructions[FILENAME]
+    }
+}
+END {
+    printf("Weighted aggregate of %d SimPoint regions (total weight %f)\n\n", region_count, total_weight)
+    for (i = 0; i < cpu_count; i++)
+    {
+        cpu = cpu_order[i]
+        printf("CPU %s weighted IPC: %f\n", cpu, total_weight / cpi[cpu])
+    }
+
+    printf("\nInformation about memory controller (per %d instructions)\n\n", simulation_instructions)
+    for (i = 0; i < counter_count; i++)
+    {
+        name = counter_order[i]
+        printf("%s: %.1f\n", name, counter[name] / total_weight * simulation_instructions)
+    }
+
+    memory_requests = counter["read_request_in_memory"] + counter["write_request_in_memory"]
+    total_requests = memory_requests + counter["read_request_in_memory2"] + counter["write_request_in_memory2"]
+    if (total_requests > 0)
+    {
+        printf("hit rate: %f\n", memory_requests / total_requests)
+    }
+}
+' "${statistics_files[@]}" | tee "$output_directory/aggregate.statistics"
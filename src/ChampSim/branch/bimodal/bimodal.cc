@@ -1,6 +1,9 @@
 #include <map>
 
 #include "ooo_cpu.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif // SIMULATION_USE_CHECKPOINT
 
 #if (USER_CODES == ENABLE)
 constexpr std::size_t BIMODAL_TABLE_SIZE = 16384;
@@ -37,6 +40,10 @@ void O3_CPU::bpred_bbranchDbimodal_last_result(uint64_t ip, uint64_t branch_targ
     bimodal_table[this][hash] = std::max(bimodal_table[this][hash] - 1, 0);
 }
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void O3_CPU::bpred_bbranchDbimodal_checkpoint(CHECKPOINT& checkpoint) { checkpoint.transfer(bimodal_table[this]); }
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 constexpr std::size_t BIMODAL_TABLE_SIZE = 16384;
 constexpr std::size_t BIMODAL_PRIME = 16381;
@@ -1,4 +1,7 @@
 #include "ooo_cpu.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif // SIMULATION_USE_CHECKPOINT
 
 #if (USER_CODES == ENABLE)
 #define GLOBAL_HISTORY_LENGTH 14
@@ -67,6 +70,14 @@ void O3_CPU::bpred_bbranchDgshare_last_result(uint64_t ip, uint64_t branch_targe
   branch_history_vector[cpu] |= taken;
 }
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void O3_CPU::bpred_bbranchDgshare_checkpoint(CHECKPOINT& checkpoint)
+{
+  checkpoint.transfer(branch_history_vector[cpu]);
+  checkpoint.transfer(gs_history_table[cpu]);
+}
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 #define GLOBAL_HISTORY_LENGTH 14
 #define GLOBAL_HISTORY_MASK (1 << GLOBAL_HISTORY_LENGTH) - 1
@@ -53,6 +53,9 @@ sources for you to plagiarize.
 #include <string.h>
 
 #include "ooo_cpu.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif // SIMULATION_USE_CHECKPOINT
 
 #if (USER_CODES == ENABLE)
 // this many tables
@@ -260,6 +263,17 @@ void O3_CPU::bpred_bbranchDhashed_perceptron_last_result(uint64_t pc, uint64_t b
     }
   }
 }
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void O3_CPU::bpred_bbranchDhashed_perceptron_checkpoint(CHECKPOINT& checkpoint)
+{
+  checkpoint.transfer(tables[cpu]);
+  checkpoint.transfer(ghist_words[cpu]);
+  checkpoint.transfer(theta[cpu]);
+  checkpoint.transfer(tc[cpu]);
+}
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 // this many tables
 
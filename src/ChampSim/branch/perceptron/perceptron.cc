@@ -43,6 +43,9 @@
 #include <map>
 
 #include "ooo_cpu.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif // SIMULATION_USE_CHECKPOINT
 
 #if (USER_CODES == ENABLE)
 template <typename T, std::size_t HISTLEN, std::size_t BITS>
@@ -170,6 +173,22 @@ void O3_CPU::bpred_bbranchDperceptron_last_result(uint64_t ip, uint64_t branch_t
   if ((output <= THETA && output >= -THETA) || (prediction != taken))
     perceptrons[this][index].update(taken, history);
 }
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void O3_CPU::bpred_bbranchDperceptron_checkpoint(CHECKPOINT& checkpoint)
+{
+  checkpoint.transfer(perceptrons[this]);
+  checkpoint.transfer(global_history[this]);
+
+  if (checkpoint.is_restoring())
+  {
+    // no branch is in flight after restoring, so there is no pending update and no speculative history.
+    perceptron_state_buf[this].clear();
+    spec_global_history[this] = global_history[this];
+  }
+}
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 template <typename T, std::size_t HISTLEN, std::size_t BITS>
 class perceptron
@@ -7,6 +7,9 @@
  */
 
 #include "ooo_cpu.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif // SIMULATION_USE_CHECKPOINT
 
 #if (USER_CODES == ENABLE)
 
@@ -277,6 +280,19 @@ void O3_CPU::btb_bbtbDbasic_btb_update(uint64_t ip, uint64_t branch_target, uint
   }
 }
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void O3_CPU::btb_bbtbDbasic_btb_checkpoint(CHECKPOINT& checkpoint)
+{
+  checkpoint.transfer(basic_btb[cpu]);
+  checkpoint.transfer(basic_btb_lru_counter[cpu]);
+  checkpoint.transfer(basic_btb_indirect[cpu]);
+  checkpoint.transfer(basic_btb_conditional_history[cpu]);
+  checkpoint.transfer(basic_btb_ras[cpu]);
+  checkpoint.transfer(basic_btb_ras_index[cpu]);
+  checkpoint.transfer(basic_btb_call_instr_sizes[cpu]);
+}
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 #define BASIC_BTB_SETS 1024
 #define BASIC_BTB_WAYS 8
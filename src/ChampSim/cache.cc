@@ -23,6 +23,9 @@
 #include "champsim_constants.h"
 #include "util.h"
 #include "vmem.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif // SIMULATION_USE_CHECKPOINT
 
 #ifndef SANITY_CHECK
 #define NDEBUG
@@ -35,8 +38,8 @@ void CACHE::handle_fill()
 {
   while (writes_available_this_cycle > 0)
   {
-    auto fill_mshr = MSHR.begin();
-    if (fill_mshr == std::end(MSHR) || fill_mshr->event_cycle > current_cycle)
+    PACKET* fill_mshr = MSHR.next_fill();
+    if (fill_mshr == nullptr || fill_mshr->event_cycle > current_cycle)
       return;
 
     // find victim
@@ -60,10 +63,10 @@ void CACHE::handle_fill()
       fill_mshr->data = block[set * NUM_WAY + way].data;
 
       for (auto ret : fill_mshr->to_return)
-        ret->return_data(&(*fill_mshr));
+        ret->return_data(fill_mshr);
     }
 
-    MSHR.erase(fill_mshr);
+    MSHR.pop_fill();
     writes_available_this_cycle--;
   }
 }
@@ -122,7 +125,7 @@ void CACHE::handle_writeback()
 
     // remove this entry from WQ
     writes_available_this_cycle--;
-    WQ.pop_front();
+    queue_pop_front(WQ, WQ_index, match_offset_bits ? 0 : OFFSET_BITS);
   }
 }
 
@@ -156,7 +159,7 @@ void CACHE::handle_read()
     }
 
     // remove this entry from RQ
-    RQ.pop_front();
+    queue_pop_front(RQ, RQ_index, OFFSET_BITS);
     reads_available_this_cycle--;
   }
 }
@@ -186,7 +189,7 @@ void CACHE::handle_prefetch()
     }
 
     // remove this entry from PQ
-    PQ.pop_front();
+    queue_pop_front(PQ, PQ_index, OFFSET_BITS);
     reads_available_this_cycle--;
   }
 }
@@ -246,10 +249,10 @@ bool CACHE::readlike_miss(PACKET& handle_pkt)
   });
 
   // check mshr
-  auto mshr_entry = std::find_if(MSHR.begin(), MSHR.end(), eq_addr<PACKET>(handle_pkt.address, OFFSET_BITS));
-  bool mshr_full = (MSHR.size() == MSHR_SIZE);
+  PACKET* mshr_entry = MSHR.find(handle_pkt.address);
+  bool mshr_full = MSHR.full();
 
-  if (mshr_entry != MSHR.end()) // miss already inflight
+  if (mshr_entry != nullptr) // miss already inflight
   {
     // update fill location
     mshr_entry->fill_level = std::min(mshr_entry->fill_level, handle_pkt.fill_level);
@@ -286,11 +289,12 @@ bool CACHE::readlike_miss(PACKET& handle_pkt)
     std::vector<MemoryRequestProducer*> to_return_backup = handle_pkt.to_return;
 
     // Allocate an MSHR
+    PACKET* allocated_mshr = nullptr;
     if (handle_pkt.fill_level <= fill_level)
     {
-      auto it = MSHR.insert(std::end(MSHR), handle_pkt);
-      it->cycle_enqueued = current_cycle;
-      it->event_cycle = std::numeric_limits<uint64_t>::max();
+      allocated_mshr = MSHR.allocate(handle_pkt);
+      allocated_mshr->cycle_enqueued = current_cycle;
+      allocated_mshr->event_cycle = std::numeric_limits<uint64_t>::max();
     }
 
     if (handle_pkt.fill_level <= fill_level)
@@ -310,8 +314,9 @@ bool CACHE::readlike_miss(PACKET& handle_pkt)
       handle_pkt.cycle_enqueued = cycle_enqueued_backup;
       handle_pkt.event_cycle = event_cycle_backup;
       handle_pkt.to_return = to_return_backup;
-      // delete the last element
-      MSHR.pop_back();
+      // delete the MSHR allocated above
+      if (allocated_mshr != nullptr)
+        MSHR.release(allocated_mshr);
       return false;
     }
 
@@ -325,9 +330,9 @@ bool CACHE::readlike_miss(PACKET& handle_pkt)
     // Allocate an MSHR
     if (handle_pkt.fill_level <= fill_level)
     {
-      auto it = MSHR.insert(std::end(MSHR), handle_pkt);
-      it->cycle_enqueued = current_cycle;
-      it->event_cycle = std::numeric_limits<uint64_t>::max();
+      PACKET* allocated_mshr = MSHR.allocate(handle_pkt);
+      allocated_mshr->cycle_enqueued = current_cycle;
+      allocated_mshr->event_cycle = std::numeric_limits<uint64_t>::max();
     }
 
     if (handle_pkt.fill_level <= fill_level)
@@ -490,6 +495,27 @@ int CACHE::invalidate_entry(uint64_t inval_addr)
   return way;
 }
 
+void CACHE::queue_push_back(champsim::delay_queue<PACKET>& queue, std::unordered_map<uint64_t, PACKET*>& queue_index, std::size_t shamt, const PACKET& packet)
+{
+  if (warmup_complete[cpu])
+    queue.push_back(packet);
+  else
+    queue.push_back_ready(packet);
+
+  // the packets in the queue stay in place until they are popped, so the index can point to them.
+  if (is_valid<PACKET>()(packet))
+    queue_index[packet.address >> shamt] = &queue.back();
+}
+
+void CACHE::queue_pop_front(champsim::delay_queue<PACKET>& queue, std::unordered_map<uint64_t, PACKET*>& queue_index, std::size_t shamt)
+{
+  auto found = queue_index.find(queue.front().address >> shamt);
+  if (found != queue_index.end() && found->second == &queue.front())
+    queue_index.erase(found);
+
+  queue.pop_front();
+}
+
 int CACHE::add_rq(PACKET* packet)
 {
   assert(packet->address != 0);
@@ -503,14 +529,14 @@ int CACHE::add_rq(PACKET* packet)
   });
 
   // check for the latest writebacks in the write queue
-  champsim::delay_queue<PACKET>::iterator found_wq = std::find_if(WQ.begin(), WQ.end(), eq_addr<PACKET>(packet->address, match_offset_bits ? 0 : OFFSET_BITS));
+  auto found_wq = WQ_index.find(packet->address >> (match_offset_bits ? 0 : OFFSET_BITS));
 
-  if (found_wq != WQ.end())
+  if (found_wq != WQ_index.end())
   {
 
     DP(if (warmup_complete[packet->cpu]) std::cout << " MERGED_WQ" << std::endl;);
 
-    packet->data = found_wq->data;
+    packet->data = found_wq->second->data;
     for (auto ret : packet->to_return)
       ret->return_data(packet);
 
@@ -519,16 +545,16 @@ int CACHE::add_rq(PACKET* packet)
   }
 
   // check for duplicates in the read queue
-  auto found_rq = std::find_if(RQ.begin(), RQ.end(), eq_addr<PACKET>(packet->address, OFFSET_BITS));
-  if (found_rq != RQ.end())
+  auto found_rq = RQ_index.find(packet->address >> OFFSET_BITS);
+  if (found_rq != RQ_index.end())
   {
 
     DP(if (warmup_complete[packet->cpu]) std::cout << " MERGED_RQ" << std::endl;);
 
-    packet_dep_merge(found_rq->lq_index_depend_on_me, packet->lq_index_depend_on_me);
-    packet_dep_merge(found_rq->sq_index_depend_on_me, packet->sq_index_depend_on_me);
-    packet_dep_merge(found_rq->instr_depend_on_me, packet->instr_depend_on_me);
-    packet_dep_merge(found_rq->to_return, packet->to_return);
+    packet_dep_merge(found_rq->second->lq_index_depend_on_me, packet->lq_index_depend_on_me);
+    packet_dep_merge(found_rq->second->sq_index_depend_on_me, packet->sq_index_depend_on_me);
+    packet_dep_merge(found_rq->second->instr_depend_on_me, packet->instr_depend_on_me);
+    packet_dep_merge(found_rq->second->to_return, packet->to_return);
 
     RQ_MERGED++;
 
@@ -546,10 +572,7 @@ int CACHE::add_rq(PACKET* packet)
   }
 
   // if there is no duplicate, add it to RQ
-  if (warmup_complete[cpu])
-    RQ.push_back(*packet);
-  else
-    RQ.push_back_ready(*packet);
+  queue_push_back(RQ, RQ_index, OFFSET_BITS, *packet);
 
   DP(if (warmup_complete[packet->cpu]) std::cout << " ADDED" << std::endl;);
 
@@ -569,9 +592,9 @@ int CACHE::add_wq(PACKET* packet)
   });
 
   // check for duplicates in the write queue
-  champsim::delay_queue<PACKET>::iterator found_wq = std::find_if(WQ.begin(), WQ.end(), eq_addr<PACKET>(packet->address, match_offset_bits ? 0 : OFFSET_BITS));
+  auto found_wq = WQ_index.find(packet->address >> (match_offset_bits ? 0 : OFFSET_BITS));
 
-  if (found_wq != WQ.end())
+  if (found_wq != WQ_index.end())
   {
 
     DP(if (warmup_complete[packet->cpu]) std::cout << " MERGED" << std::endl;);
@@ -590,10 +613,7 @@ int CACHE::add_wq(PACKET* packet)
   }
 
   // if there is no duplicate, add it to the write queue
-  if (warmup_complete[cpu])
-    WQ.push_back(*packet);
-  else
-    WQ.push_back_ready(*packet);
+  queue_push_back(WQ, WQ_index, match_offset_bits ? 0 : OFFSET_BITS, *packet);
 
   DP(if (warmup_complete[packet->cpu]) std::cout << " ADDED" << std::endl;);
 
@@ -687,14 +707,14 @@ int CACHE::add_pq(PACKET* packet)
   });
 
   // check for the latest wirtebacks in the write queue
-  champsim::delay_queue<PACKET>::iterator found_wq = std::find_if(WQ.begin(), WQ.end(), eq_addr<PACKET>(packet->address, match_offset_bits ? 0 : OFFSET_BITS));
+  auto found_wq = WQ_index.find(packet->address >> (match_offset_bits ? 0 : OFFSET_BITS));
 
-  if (found_wq != WQ.end())
+  if (found_wq != WQ_index.end())
   {
 
     DP(if (warmup_complete[packet->cpu]) std::cout << " MERGED_WQ" << std::endl;);
 
-    packet->data = found_wq->data;
+    packet->data = found_wq->second->data;
     for (auto ret : packet->to_return)
       ret->return_data(packet);
 
@@ -703,13 +723,13 @@ int CACHE::add_pq(PACKET* packet)
   }
 
   // check for duplicates in the PQ
-  auto found = std::find_if(PQ.begin(), PQ.end(), eq_addr<PACKET>(packet->address, OFFSET_BITS));
-  if (found != PQ.end())
+  auto found = PQ_index.find(packet->address >> OFFSET_BITS);
+  if (found != PQ_index.end())
   {
     DP(if (warmup_complete[packet->cpu]) std::cout << " MERGED_PQ" << std::endl;);
 
-    found->fill_level = std::min(found->fill_level, packet->fill_level);
-    packet_dep_merge(found->to_return, packet->to_return);
+    found->second->fill_level = std::min(found->second->fill_level, packet->fill_level);
+    packet_dep_merge(found->second->to_return, packet->to_return);
 
     PQ_MERGED++;
     return 0;
@@ -726,10 +746,7 @@ int CACHE::add_pq(PACKET* packet)
   }
 
   // if there is no duplicate, add it to PQ
-  if (warmup_complete[cpu])
-    PQ.push_back(*packet);
-  else
-    PQ.push_back_ready(*packet);
+  queue_push_back(PQ, PQ_index, OFFSET_BITS, *packet);
 
   DP(if (warmup_complete[packet->cpu]) std::cout << " ADDED" << std::endl;);
 
@@ -740,11 +757,10 @@ int CACHE::add_pq(PACKET* packet)
 void CACHE::return_data(PACKET* packet)
 {
   // check MSHR information
-  auto mshr_entry = std::find_if(MSHR.begin(), MSHR.end(), eq_addr<PACKET>(packet->address, OFFSET_BITS));
-  auto first_unreturned = std::find_if(MSHR.begin(), MSHR.end(), [](auto x) { return x.event_cycle == std::numeric_limits<uint64_t>::max(); });
+  PACKET* mshr_entry = MSHR.find(packet->address);
 
   // sanity check
-  if (mshr_entry == MSHR.end())
+  if (mshr_entry == nullptr)
   {
     std::cerr << "[" << NAME << "_MSHR] " << __func__ << " instr_id: " << packet->instr_id << " cannot find a matching entry!";
     std::cerr << " address: " << std::hex << packet->address;
@@ -754,6 +770,8 @@ void CACHE::return_data(PACKET* packet)
     assert(0);
   }
 
+  bool returned_before = (mshr_entry->event_cycle != std::numeric_limits<uint64_t>::max());
+
   // MSHR holds the most updated information about this request
   mshr_entry->data = packet->data;
   mshr_entry->pf_metadata = packet->pf_metadata;
@@ -764,19 +782,20 @@ void CACHE::return_data(PACKET* packet)
     std::cout << "[" << NAME << "_MSHR] " << __func__ << " instr_id: " << mshr_entry->instr_id;
     std::cout << " address: " << std::hex << (mshr_entry->address >> OFFSET_BITS) << " full_addr: " << mshr_entry->address;
     std::cout << " data: " << mshr_entry->data << std::dec;
-    std::cout << " index: " << std::distance(MSHR.begin(), mshr_entry) << " occupancy: " << get_occupancy(0, 0);
+    std::cout << " occupancy: " << get_occupancy(0, 0);
     std::cout << " event: " << mshr_entry->event_cycle << " current: " << current_cycle << std::endl;
   });
 
   // Order this entry after previously-returned entries, but before non-returned
   // entries
-  std::iter_swap(mshr_entry, first_unreturned);
+  if (!returned_before)
+    MSHR.mark_returned(mshr_entry);
 }
 
 uint32_t CACHE::get_occupancy(uint8_t queue_type, uint64_t address)
 {
   if (queue_type == 0)
-    return std::count_if(MSHR.begin(), MSHR.end(), is_valid<PACKET>());
+    return MSHR.occupancy();
   else if (queue_type == 1)
     return RQ.occupancy();
   else if (queue_type == 2)
@@ -805,19 +824,88 @@ bool CACHE::should_activate_prefetcher(int type) { return (1 << static_cast<int>
 
 void CACHE::print_deadlock()
 {
-  if (!std::empty(MSHR))
+  if (!MSHR.empty())
   {
     std::cout << NAME << " MSHR Entry" << std::endl;
-    std::size_t j = 0;
-    for (PACKET entry : MSHR)
+    MSHR.for_each([this](std::size_t slot, const PACKET& entry)
     {
-      std::cout << "[" << NAME << " MSHR] entry: " << j++ << " instr_id: " << entry.instr_id;
+      std::cout << "[" << NAME << " MSHR] entry: " << slot << " instr_id: " << entry.instr_id;
       std::cout << " address: " << std::hex << (entry.address >> LOG2_BLOCK_SIZE) << " full_addr: " << entry.address << std::dec << " type: " << +entry.type;
       std::cout << " fill_level: " << +entry.fill_level << " event_cycle: " << entry.event_cycle << std::endl;
-    }
+    });
   }
   else
   {
     std::cout << NAME << " MSHR empty" << std::endl;
   }
 }
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void CACHE::checkpoint(CHECKPOINT& checkpoint)
+{
+  checkpoint.section(NAME);
+  checkpoint.check("sets", NUM_SET);
+  checkpoint.check("ways", NUM_WAY);
+  checkpoint.check("replacement policy", static_cast<uint8_t>(repl_type));
+  checkpoint.check("prefetcher", static_cast<uint8_t>(pref_type));
+
+  checkpoint.transfer(block);
+  impl_replacement_checkpoint(checkpoint);
+  impl_prefetcher_checkpoint(checkpoint);
+}
+#endif // SIMULATION_USE_CHECKPOINT
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+uint64_t CACHE::idle_cycles(uint64_t limit)
+{
+  // the lookahead of the IP-based stride prefetcher issues prefetches in its cycle operate
+  if (pref_type == pref_t::pprefetcherDip_stride)
+    return 0;
+
+  // handle_fill()
+  PACKET* fill_mshr = MSHR.next_fill();
+  if (fill_mshr != nullptr)
+  {
+    if (fill_mshr->event_cycle <= current_cycle)
+      return 0;
+    limit = std::min(limit, fill_mshr->event_cycle - current_cycle);
+  }
+
+  // handle_writeback() and va_translate_prefetches()
+  if (WQ.has_ready() || VAPQ.has_ready())
+    return 0;
+
+  // handle_read() and handle_prefetch() stop at a miss which can't allocate an MSHR
+  auto is_blocked = [this](const PACKET& packet) {
+    return get_way(packet.address, get_set(packet.address)) == NUM_WAY && MSHR.find(packet.address) == nullptr && MSHR.full();
+  };
+  if (RQ.has_ready() && !is_blocked(RQ.front()))
+    return 0;
+  if (PQ.has_ready() && !is_blocked(PQ.front()))
+    return 0;
+
+  for (auto queue : {&RQ, &PQ, &VAPQ, &WQ})
+    limit = std::min(limit, (uint64_t)queue->cycles_to_next_ready());
+
+  return limit;
+}
+
+void CACHE::skip_cycles(uint64_t cycles)
+{
+  current_cycle += cycles;
+
+  for (auto queue : {&RQ, &PQ, &VAPQ, &WQ})
+    queue->skip_cycles(cycles);
+}
+
+bool CACHE::rq_rejects(uint64_t address)
+{
+  // the same checks as add_rq()
+  if (WQ_index.find(address >> (match_offset_bits ? 0 : OFFSET_BITS)) != WQ_index.end())
+    return false;
+  if (RQ_index.find(address >> OFFSET_BITS) != RQ_index.end())
+    return false;
+
+  return RQ.full();
+}
+#endif // SIMULATION_USE_CLOCK_SKIPPING
@@ -122,7 +122,7 @@ int MEMORY_CONTROLLER::add_rq(PACKET* packet)
 
 #if (PRINT_MEMORY_TRACE == ENABLE)
     // output memory trace.
-    output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'R');
+    output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'R', current_cycle);
 #endif
   }
   break;
@@ -169,7 +169,7 @@ int MEMORY_CONTROLLER::add_rq(PACKET* packet)
 
 #if (PRINT_MEMORY_TRACE == ENABLE)
     // output memory trace.
-    output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'R');
+    output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'R', current_cycle);
 #endif
   }
   break;
@@ -210,7 +210,7 @@ int MEMORY_CONTROLLER::add_wq(PACKET* packet)
 
 #if (PRINT_MEMORY_TRACE == ENABLE)
     // output memory trace.
-    output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'W');
+    output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'W', current_cycle);
 #endif  // PRINT_MEMORY_TRACE
   }
   break;
@@ -237,7 +237,7 @@ int MEMORY_CONTROLLER::add_wq(PACKET* packet)
 
 #if (PRINT_MEMORY_TRACE == ENABLE)
     // output memory trace.
-    output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'W');
+    output_memorytrace.output_memory_trace_hexadecimal(packet->address, 'W', current_cycle);
 #endif  // PRINT_MEMORY_TRACE
   }
   break;
@@ -22,6 +22,9 @@
 #include "cache.h"
 #include "champsim.h"
 #include "instruction.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif // SIMULATION_USE_CHECKPOINT
 
 #define DEADLOCK_CYCLE 1000000
 
@@ -309,6 +312,44 @@ void O3_CPU::init_instruction(ooo_model_instr arch_instr)
   instr_unique_id++;
 }
 
+#if (USER_CODES == ENABLE)
+void O3_CPU::init_instructions(ooo_model_instr_batch& batch)
+{
+  // consume the batch until the front-end stops reading for this cycle
+  while (fetch_stall == 0 && instrs_to_read_this_cycle > 0 && !batch.empty())
+  {
+    init_instruction(std::move(batch.instrs[batch.position]));
+    batch.position++;
+  }
+}
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void O3_CPU::checkpoint(CHECKPOINT& checkpoint)
+{
+  checkpoint.section("CPU " + std::to_string(cpu));
+  checkpoint.check("DIB sets", dib_set);
+  checkpoint.check("DIB ways", dib_way);
+  checkpoint.check("DIB window", dib_window);
+  checkpoint.check("branch predictor", static_cast<uint8_t>(bpred_type));
+  checkpoint.check("branch target buffer", static_cast<uint8_t>(btb_type));
+
+  checkpoint.transfer(num_retired);
+  checkpoint.transfer(DIB);
+
+  impl_branch_predictor_checkpoint(checkpoint);
+  impl_btb_checkpoint(checkpoint);
+
+  if (checkpoint.is_restoring())
+  {
+    // the pipeline is empty, thus the instructions after the retired ones are fetched from the trace again.
+    instr_unique_id = num_retired;
+    last_sim_instr = num_retired;
+    next_print_instruction = (num_retired / STAT_PRINTING_PERIOD + 1) * STAT_PRINTING_PERIOD;
+  }
+}
+#endif // SIMULATION_USE_CHECKPOINT
+#endif // USER_CODES
+
 void O3_CPU::check_dib()
 {
   // scan through IFETCH_BUFFER to find instructions that hit in the decoded
@@ -1351,3 +1392,135 @@ void O3_CPU::print_deadlock()
       << sq_it->physical_address << std::dec << " translated: " << +sq_it->translated << " fetched: " << +sq_it->fetched << std::endl;
   }
 }
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+uint64_t O3_CPU::idle_cycles(uint64_t limit)
+{
+  // the trace is read in every cycle unless the IFETCH_BUFFER is full or fetch is stalled
+  if (fetch_stall == 0 && !IFETCH_BUFFER.full())
+    return 0;
+
+  // fetch_instruction() resumes fetching after the branch mispredict penalty
+  if ((fetch_stall == 1) && (fetch_resume_cycle != 0))
+  {
+    if (fetch_resume_cycle <= current_cycle)
+      return 0;
+    limit = std::min(limit, fetch_resume_cycle - current_cycle);
+  }
+
+  // translate_fetch() and fetch_instruction()
+  if (std::any_of(IFETCH_BUFFER.begin(), IFETCH_BUFFER.end(),
+                  [](const ooo_model_instr& x) { return !x.translated || (x.translated == COMPLETED && !x.fetched); }))
+    return 0;
+
+  // promote_to_decode(), decode_instruction() and dispatch_instruction()
+  if (!IFETCH_BUFFER.empty() && !DECODE_BUFFER.full() && IFETCH_BUFFER.front().translated == COMPLETED && IFETCH_BUFFER.front().fetched == COMPLETED)
+    return 0;
+  if (!DISPATCH_BUFFER.full())
+  {
+    if (DECODE_BUFFER.has_ready())
+      return 0;
+    limit = std::min(limit, (uint64_t)DECODE_BUFFER.cycles_to_next_ready());
+  }
+  if (!ROB.full())
+  {
+    if (DISPATCH_BUFFER.has_ready())
+      return 0;
+    limit = std::min(limit, (uint64_t)DISPATCH_BUFFER.cycles_to_next_ready());
+  }
+
+  // retire_rob(), execute_instruction(), handle_memory_return() and operate_lsq()
+  if (!ROB.empty() && ROB.front().executed == COMPLETED)
+    return 0;
+  if (!ready_to_execute.empty() || !RTS1.empty())
+    return 0;
+
+  // operate_lsq() retries the oldest loads and stores in every cycle, the retries rejected by a full RQ are replayed in skip_cycles()
+  auto is_rejected = [](CacheBus& bus, uint64_t address) {
+    CACHE* cache = dynamic_cast<CACHE*>(bus.lower_level);
+    return (cache != nullptr) && cache->rq_rejects(address);
+  };
+  if (!RTS0.empty() && !is_rejected(DTLB_bus, RTS0.front()->virtual_address))
+    return 0;
+  if (!RTL0.empty() && !is_rejected(DTLB_bus, RTL0.front()->virtual_address))
+    return 0;
+  if (!RTL1.empty() && !is_rejected(L1D_bus, RTL1.front()->physical_address))
+    return 0;
+  if (!ITLB_bus.PROCESSED.empty() || !L1I_bus.PROCESSED.empty() || !DTLB_bus.PROCESSED.empty() || !L1D_bus.PROCESSED.empty())
+    return 0;
+
+  // do_memory_scheduling() adds nothing into the full load queue or store queue
+  const bool lq_full = std::all_of(std::begin(LQ), std::end(LQ), is_valid<LSQ_ENTRY>());
+  const bool sq_full = std::all_of(std::begin(SQ), std::end(SQ), is_valid<LSQ_ENTRY>());
+  auto memory_scheduling_is_blocked = [this, lq_full, sq_full](const ooo_model_instr& instr) {
+    bool not_added = false;
+    for (uint32_t i = 0; i < NUM_INSTR_SOURCES; i++)
+    {
+      if (instr.source_memory[i] && !instr.source_added[i])
+      {
+        if (!lq_full)
+          return false;
+        not_added = true;
+      }
+    }
+    for (uint32_t i = 0; i < MAX_INSTR_DESTINATIONS; i++)
+    {
+      if (instr.destination_memory[i] && !instr.destination_added[i])
+      {
+        if (!sq_full && !STA.empty() && STA.front() == instr.instr_id)
+          return false;
+        not_added = true;
+      }
+    }
+    return not_added;
+  };
+
+  // complete_inflight_instruction(), and schedule_instruction() and schedule_memory_instruction() in their window
+  const bool has_inflight_executions = (inflight_reg_executions > 0) || (inflight_mem_executions > 0);
+  std::size_t search_bw = SCHEDULER_SIZE;
+  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB); ++rob_it)
+  {
+    if (has_inflight_executions && (rob_it->executed == INFLIGHT) && rob_it->num_mem_ops == 0)
+    {
+      if (rob_it->event_cycle <= current_cycle)
+        return 0;
+      limit = std::min(limit, rob_it->event_cycle - current_cycle);
+    }
+
+    if (search_bw > 0)
+    {
+      if (rob_it->scheduled == 0)
+        return 0;
+      if (rob_it->is_memory && rob_it->num_reg_dependent == 0 && (rob_it->scheduled == INFLIGHT) && !memory_scheduling_is_blocked(*rob_it))
+        return 0;
+
+      if (rob_it->executed == 0)
+        --search_bw;
+    }
+    else if (!has_inflight_executions)
+    {
+      break;
+    }
+  }
+
+  return limit;
+}
+
+void O3_CPU::skip_cycles(uint64_t cycles)
+{
+  // the rejected retries count the accesses of the lower levels in every cycle
+  if (!RTS0.empty() || !RTL0.empty() || !RTL1.empty())
+  {
+    for (uint64_t i = 0; i < cycles; i++)
+      operate_lsq();
+  }
+
+  // check_dib() marks the instructions hitting in the DIB with the last skipped cycle
+  current_cycle += cycles - 1;
+  check_dib();
+  current_cycle++;
+
+  DISPATCH_BUFFER.skip_cycles(cycles);
+  DECODE_BUFFER.skip_cycles(cycles);
+}
+#endif // SIMULATION_USE_CLOCK_SKIPPING
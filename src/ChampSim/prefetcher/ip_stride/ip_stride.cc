@@ -3,6 +3,9 @@
 #include <map>
 
 #include "cache.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif // SIMULATION_USE_CHECKPOINT
 
 #if (USER_CODES == ENABLE)
 constexpr int PREFETCH_DEGREE = 3;
@@ -95,6 +98,15 @@ uint32_t CACHE::pref_pprefetcherDip_stride_cache_fill(uint64_t addr, uint32_t se
 }
 
 void CACHE::pref_pprefetcherDip_stride_final_stats() {}
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void CACHE::pref_pprefetcherDip_stride_checkpoint(CHECKPOINT& checkpoint)
+{
+  checkpoint.transfer(trackers[this]);
+  checkpoint.transfer(lookahead[this]);
+}
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 constexpr int PREFETCH_DEGREE = 3;
 
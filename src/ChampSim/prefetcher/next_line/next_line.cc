@@ -23,6 +23,11 @@ uint32_t CACHE::pref_pprefetcherDnext_line_cache_fill(uint64_t addr, uint32_t se
 void CACHE::pref_pprefetcherDnext_line_cycle_operate() {}
 
 void CACHE::pref_pprefetcherDnext_line_final_stats() {}
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void CACHE::pref_pprefetcherDnext_line_checkpoint(CHECKPOINT& checkpoint) {}
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 void CACHE::prefetcher_initialize() { std::cout << NAME << " next line prefetcher" << std::endl; }
 
@@ -25,6 +25,11 @@ uint32_t O3_CPU::pref_pprefetcherDnext_line_instr_cache_fill(uint64_t v_addr, ui
 }
 
 void O3_CPU::pref_pprefetcherDnext_line_instr_final_stats() {}
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void O3_CPU::pref_pprefetcherDnext_line_instr_checkpoint(CHECKPOINT& checkpoint) {}
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 void O3_CPU::prefetcher_initialize() { std::cout << "CPU " << cpu << " next line instruction prefetcher" << endl; }
 
@@ -17,6 +17,10 @@ void CACHE::pref_pprefetcherDno_cycle_operate() {}
 
 void CACHE::pref_pprefetcherDno_final_stats() {}
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void CACHE::pref_pprefetcherDno_checkpoint(CHECKPOINT& checkpoint) {}
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 void CACHE::prefetcher_initialize() {}
 
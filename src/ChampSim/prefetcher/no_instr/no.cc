@@ -19,6 +19,10 @@ uint32_t O3_CPU::pref_pprefetcherDno_instr_cache_fill(uint64_t v_addr, uint32_t
 
 void O3_CPU::pref_pprefetcherDno_instr_final_stats() {}
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void O3_CPU::pref_pprefetcherDno_instr_checkpoint(CHECKPOINT& checkpoint) {}
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 void O3_CPU::prefetcher_initialize() {}
 
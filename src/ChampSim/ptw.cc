@@ -19,6 +19,9 @@
 #include "champsim.h"
 #include "util.h"
 #include "vmem.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif // SIMULATION_USE_CHECKPOINT
 
  //extern VirtualMemory vmem;
 extern uint8_t warmup_complete[NUM_CPUS];
@@ -316,3 +319,49 @@ void PageTableWalker::print_deadlock()
     std::cout << NAME << " MSHR empty" << std::endl;
   }
 }
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void PagingStructureCache::checkpoint(CHECKPOINT& checkpoint)
+{
+  checkpoint.section(NAME);
+  checkpoint.check("sets", NUM_SET);
+  checkpoint.check("ways", NUM_WAY);
+
+  checkpoint.transfer(block);
+}
+
+void PageTableWalker::checkpoint(CHECKPOINT& checkpoint)
+{
+  checkpoint.section(NAME);
+
+  PSCL5.checkpoint(checkpoint);
+  PSCL4.checkpoint(checkpoint);
+  PSCL3.checkpoint(checkpoint);
+  PSCL2.checkpoint(checkpoint);
+}
+#endif // SIMULATION_USE_CHECKPOINT
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+uint64_t PageTableWalker::idle_cycles(uint64_t limit)
+{
+  // handle_fill(), the MSHR is sorted by the event cycle
+  if (!std::empty(MSHR))
+  {
+    if (MSHR.front().event_cycle <= current_cycle)
+      return 0;
+    limit = std::min(limit, MSHR.front().event_cycle - current_cycle);
+  }
+
+  // handle_read()
+  if (RQ.has_ready() && std::size(MSHR) != MSHR_SIZE)
+    return 0;
+
+  return std::min(limit, (uint64_t)RQ.cycles_to_next_ready());
+}
+
+void PageTableWalker::skip_cycles(uint64_t cycles)
+{
+  current_cycle += cycles;
+  RQ.skip_cycles(cycles);
+}
+#endif // SIMULATION_USE_CLOCK_SKIPPING
@@ -3,6 +3,9 @@
 #include <utility>
 
 #include "cache.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif // SIMULATION_USE_CHECKPOINT
 
 #if (USER_CODES == ENABLE)
 #define maxRRPV 3
@@ -118,6 +121,17 @@ uint32_t CACHE::repl_rreplacementDdrrip_victim(uint32_t cpu, uint64_t instr_id,
 
 // use this function to print out your own stats at the end of simulation
 void CACHE::repl_rreplacementDdrrip_final_stats() {}
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void CACHE::repl_rreplacementDdrrip_checkpoint(CHECKPOINT& checkpoint)
+{
+  // the leader sets are chosen by a fixed seed in the initialization, so only the counters are saved.
+  checkpoint.transfer(bip_counter[this]);
+  for (std::size_t i = 0; i < NUM_CPUS; i++)
+    checkpoint.transfer(PSEL[std::make_pair(this, i)]);
+}
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 #define maxRRPV 3
 #define NUM_POLICY 2
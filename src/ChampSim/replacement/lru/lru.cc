@@ -33,6 +33,11 @@ void CACHE::repl_rreplacementDlru_update(uint32_t cpu, uint32_t set, uint32_t wa
 
 void CACHE::repl_rreplacementDlru_final_stats() {}
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+// the LRU positions are in the blocks, CACHE::checkpoint() saves them.
+void CACHE::repl_rreplacementDlru_checkpoint(CHECKPOINT& checkpoint) {}
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 void CACHE::initialize_replacement() {}
 
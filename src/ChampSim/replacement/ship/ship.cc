@@ -5,6 +5,9 @@
 #include <vector>
 
 #include "cache.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif // SIMULATION_USE_CHECKPOINT
 
 #if (USER_CODES == ENABLE)
 #define maxRRPV 3
@@ -142,6 +145,17 @@ void CACHE::repl_rreplacementDship_update(uint32_t cpu, uint32_t set, uint32_t w
 
 // use this function to print out your own stats at the end of simulation
 void CACHE::repl_rreplacementDship_final_stats() {}
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void CACHE::repl_rreplacementDship_checkpoint(CHECKPOINT& checkpoint)
+{
+  // the sampled sets are chosen by a fixed seed in the initialization, so only the sampler and the counters are saved.
+  checkpoint.transfer(sampler[this]);
+  for (std::size_t i = 0; i < NUM_CPUS; i++)
+    checkpoint.transfer(SHCT[std::make_pair(this, i)]);
+}
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 #define maxRRPV 3
 #define SHCT_SIZE 16384
@@ -39,6 +39,12 @@ void CACHE::repl_rreplacementDsrrip_update(uint32_t cpu, uint32_t set, uint32_t
 
 // use this function to print out your own stats at the end of simulation
 void CACHE::repl_rreplacementDsrrip_final_stats() {}
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+// the RRPVs are in the blocks, CACHE::checkpoint() saves them.
+void CACHE::repl_rreplacementDsrrip_checkpoint(CHECKPOINT& checkpoint) {}
+#endif // SIMULATION_USE_CHECKPOINT
+
 #else
 #define maxRRPV 3
 
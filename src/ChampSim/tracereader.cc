@@ -16,6 +16,7 @@
 
 #include "tracereader.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <fstream>
@@ -24,6 +25,417 @@
 
 #include "ProjectConfiguration.h" // user file
 
+#if (USER_CODES == ENABLE)
+#include <sys/stat.h>
+
+#define TRACE_INDEX_INTERVAL_BITS (20)
+#define TRACE_INDEX_INTERVAL      (1ull << TRACE_INDEX_INTERVAL_BITS) // instruction records between two entries of a trace index
+
+/** @brief
+ *  The sidecar index <trace>.index of a compact trace. The instruction records of a compact trace have no fixed size,
+ *  so the decompressed offset of every TRACE_INDEX_INTERVAL-th instruction record is saved after this header.
+ *  The index is rebuilt when the size or the modification time of the trace changes.
+ */
+struct trace_index_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t interval_bits;     // TRACE_INDEX_INTERVAL_BITS
+  uint64_t trace_size;        // in bytes, of the compressed trace
+  uint64_t trace_time;        // modification time of the compressed trace
+  uint64_t record_number;     // number of instruction records in the trace
+  uint64_t entry_number;      // number of offsets after this header
+};
+
+constexpr char TRACE_INDEX_MAGIC[8] = {'C', 'S', 'T', 'R', 'I', 'D', 'X', '\0'};
+constexpr uint32_t TRACE_INDEX_VERSION = 1;
+#endif // USER_CODES
+
+#if (TRACE_USE_IN_PROCESS_DECOMPRESSION == ENABLE)
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <lzma.h>
+#include <zlib.h>
+
+#define TRACE_DECOMPRESSION_BLOCK_SIZE   (4 * MB)  // decompressed bytes in a block
+#define TRACE_DECOMPRESSION_BLOCK_NUMBER (4)       // number of blocks the background thread can decompress ahead
+#define TRACE_COMPRESSED_BUFFER_SIZE     (1 * MB)  // compressed bytes read from the file at once
+
+/** @brief
+ *  Decompress a local xz/gzip trace on a background thread, so that decompression overlaps with the simulation
+ *  and the records are copied out of memory blocks instead of being read from a pipe one by one.
+ *
+ *  An xz trace compressed into several blocks (e.g., xz -T0 or xz --block-size) can start decompression at the block
+ *  holding a given offset, the blocks are located by the index at the end of the xz file. Other traces always start
+ *  at the beginning.
+ */
+class trace_decompressor
+{
+  std::string trace_string;
+  bool is_xz;
+
+  FILE* compressed_file = NULL;                   // for xz
+  lzma_stream lzma_handler = LZMA_STREAM_INIT;    // for xz
+  std::vector<uint8_t> compressed_buffer;         // for xz
+  bool end_of_stream = false;                     // for xz
+  gzFile gzip_file = NULL;                        // for gzip
+
+  bool decompress_by_block = false;               // for xz, whether decompression starts at a block instead of the beginning
+  lzma_index* block_index = NULL;                 // for xz decompressed block by block
+  lzma_index_iter block_iterator;                 // for xz decompressed block by block, it points to the block being decompressed
+  lzma_block block_options;                       // for xz decompressed block by block, the block decoder keeps a pointer to it
+  uint64_t start_offset = 0;                      // decompressed offset where decompression starts
+
+  std::thread worker;
+  std::mutex lock;
+  std::condition_variable block_filled, block_freed;
+  std::deque<std::vector<char>> filled_blocks;    // blocks ready for the simulation thread
+  std::deque<std::vector<char>> free_blocks;      // blocks ready for the background thread
+  bool end_of_trace = false;                      // the background thread has pushed the last block
+  bool stop = false;                              // the simulation thread asks the background thread to exit
+
+  std::vector<char> current_block;                // block being consumed by the simulation thread
+  std::size_t current_position = 0;
+
+public:
+  // start decompression as close to offset as possible (see get_start_offset()), offset is in decompressed bytes.
+  trace_decompressor(std::string _ts, bool _is_xz, uint64_t offset = 0) : trace_string(_ts), is_xz(_is_xz)
+  {
+    if (is_xz)
+    {
+      compressed_file = fopen(trace_string.c_str(), "rb");
+      if (compressed_file == NULL || lzma_stream_decoder(&lzma_handler, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK)
+      {
+        std::cerr << std::endl << "*** CANNOT OPEN TRACE FILE: " << trace_string << " ***" << std::endl;
+        assert(0);
+      }
+      compressed_buffer.resize(TRACE_COMPRESSED_BUFFER_SIZE);
+
+      if (offset > 0)
+      {
+        locate_block(offset);
+      }
+    }
+    else
+    {
+      gzip_file = gzopen(trace_string.c_str(), "rb");
+      if (gzip_file == NULL)
+      {
+        std::cerr << std::endl << "*** CANNOT OPEN TRACE FILE: " << trace_string << " ***" << std::endl;
+        assert(0);
+      }
+      gzbuffer(gzip_file, TRACE_COMPRESSED_BUFFER_SIZE);
+    }
+
+    for (uint32_t i = 0; i < TRACE_DECOMPRESSION_BLOCK_NUMBER; i++)
+    {
+      free_blocks.emplace_back();
+      free_blocks.back().reserve(TRACE_DECOMPRESSION_BLOCK_SIZE);
+    }
+
+    worker = std::thread(&trace_decompressor::run, this);
+  }
+
+  ~trace_decompressor()
+  {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stop = true;
+    }
+    block_freed.notify_all();
+    worker.join();
+
+    if (is_xz)
+    {
+      lzma_end(&lzma_handler);
+      lzma_index_end(block_index, NULL);
+      fclose(compressed_file);
+    }
+    else
+    {
+      gzclose(gzip_file);
+    }
+  }
+
+  // the decompressed offset of the first byte read(), it is the beginning of the block holding the requested offset.
+  uint64_t get_start_offset() const { return start_offset; }
+
+  // copy the next size bytes of the decompressed trace into destination, return the number of bytes copied.
+  std::size_t read(void* destination, std::size_t size)
+  {
+    char* output = static_cast<char*>(destination);
+    std::size_t copied = 0;
+
+    while (copied < size)
+    {
+      if (current_position == current_block.size())
+      {
+        if (next_block() == false)
+        {
+          break; // reached end of trace
+        }
+      }
+
+      std::size_t length = std::min(size - copied, current_block.size() - current_position);
+      std::copy_n(current_block.data() + current_position, length, output + copied);
+      current_position += length;
+      copied += length;
+    }
+
+    return copied;
+  }
+
+  // skip the next size bytes of the decompressed trace, return the number of bytes skipped.
+  uint64_t discard(uint64_t size)
+  {
+    uint64_t skipped = 0;
+
+    while (skipped < size)
+    {
+      if (current_position == current_block.size())
+      {
+        if (next_block() == false)
+        {
+          break; // reached end of trace
+        }
+      }
+
+      std::size_t length = std::min<uint64_t>(size - skipped, current_block.size() - current_position);
+      current_position += length;
+      skipped += length;
+    }
+
+    return skipped;
+  }
+
+private:
+  // read the index of all blocks at the end of the xz file, return NULL if the file has no valid index.
+  lzma_index* read_block_index()
+  {
+    lzma_stream info_handler = LZMA_STREAM_INIT;
+    lzma_index* index = NULL;
+
+    fseeko(compressed_file, 0, SEEK_END);
+    uint64_t file_size = ftello(compressed_file);
+    fseeko(compressed_file, 0, SEEK_SET);
+
+    lzma_ret result = lzma_file_info_decoder(&info_handler, &index, UINT64_MAX, file_size);
+    while (result == LZMA_OK)
+    {
+      if (info_handler.avail_in == 0)
+      {
+        info_handler.next_in = compressed_buffer.data();
+        info_handler.avail_in = fread(compressed_buffer.data(), 1, compressed_buffer.size(), compressed_file);
+      }
+
+      result = lzma_code(&info_handler, LZMA_RUN);
+      if (result == LZMA_SEEK_NEEDED)
+      {
+        // the decoder jumps between the stream headers, footers and indexes
+        fseeko(compressed_file, info_handler.seek_pos, SEEK_SET);
+        info_handler.avail_in = 0;
+        result = LZMA_OK;
+      }
+    }
+
+    lzma_end(&info_handler);
+    fseeko(compressed_file, 0, SEEK_SET);
+
+    if (result != LZMA_STREAM_END)
+    {
+      lzma_index_end(index, NULL);
+      return NULL;
+    }
+    return index;
+  }
+
+  // switch to block by block decompression from the block holding offset, if the trace has more than one block.
+  void locate_block(uint64_t offset)
+  {
+    block_index = read_block_index();
+    if (block_index == NULL || lzma_index_block_count(block_index) < 2)
+    {
+      return; // decompress from the beginning
+    }
+
+    lzma_index_iter_init(&block_iterator, block_index);
+    if (lzma_index_iter_locate(&block_iterator, offset))
+    {
+      return; // offset is beyond the end of trace
+    }
+
+    decompress_by_block = true;
+    start_offset = block_iterator.block.uncompressed_file_offset;
+    start_block();
+  }
+
+  // parse the header of the block pointed by block_iterator and start decompressing it.
+  void start_block()
+  {
+    uint8_t header[LZMA_BLOCK_HEADER_SIZE_MAX];
+    lzma_filter filters[LZMA_FILTERS_MAX + 1];
+
+    block_options = lzma_block();
+    block_options.version = 1;
+    block_options.check = block_iterator.stream.flags->check;
+    block_options.filters = filters;
+
+    fseeko(compressed_file, block_iterator.block.compressed_file_offset, SEEK_SET);
+    bool valid = (fread(header, 1, 1, compressed_file) == 1);
+    if (valid)
+    {
+      block_options.header_size = lzma_block_header_size_decode(header[0]);
+      valid = (fread(header + 1, 1, block_options.header_size - 1, compressed_file) == block_options.header_size - 1)
+              && (lzma_block_header_decode(&block_options, NULL, header) == LZMA_OK);
+    }
+    if (valid)
+    {
+      // the decoder copies the filter options
+      valid = (lzma_block_decoder(&lzma_handler, &block_options) == LZMA_OK);
+      lzma_filters_free(filters, NULL);
+    }
+
+    if (valid == false)
+    {
+      std::cerr << std::endl << "*** CANNOT DECOMPRESS TRACE FILE: " << trace_string << " (invalid block header) ***" << std::endl;
+      assert(0);
+    }
+
+    lzma_handler.avail_in = 0;
+  }
+
+  // recycle the consumed block and take the next filled block, return false at end of trace.
+  bool next_block()
+  {
+    std::unique_lock<std::mutex> guard(lock);
+    block_filled.wait(guard, [this] { return !filled_blocks.empty() || end_of_trace; });
+
+    if (filled_blocks.empty())
+    {
+      return false;
+    }
+
+    current_block.clear();
+    free_blocks.push_back(std::move(current_block));
+    current_block = std::move(filled_blocks.front());
+    filled_blocks.pop_front();
+    current_position = 0;
+
+    guard.unlock();
+    block_freed.notify_one();
+    return true;
+  }
+
+  void run()
+  {
+    while (true)
+    {
+      std::vector<char> block;
+      {
+        std::unique_lock<std::mutex> guard(lock);
+        block_freed.wait(guard, [this] { return !free_blocks.empty() || stop; });
+        if (stop)
+        {
+          return;
+        }
+        block = std::move(free_blocks.front());
+        free_blocks.pop_front();
+      }
+
+      block.resize(TRACE_DECOMPRESSION_BLOCK_SIZE);
+      std::size_t length = decompress(block.data(), block.size());
+      block.resize(length);
+
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        if (length > 0)
+        {
+          filled_blocks.push_back(std::move(block));
+        }
+        if (length < TRACE_DECOMPRESSION_BLOCK_SIZE)
+        {
+          end_of_trace = true;
+        }
+      }
+      block_filled.notify_one();
+
+      if (length < TRACE_DECOMPRESSION_BLOCK_SIZE)
+      {
+        return;
+      }
+    }
+  }
+
+  // fill destination with decompressed bytes, fewer bytes are returned only at end of trace.
+  std::size_t decompress(char* destination, std::size_t size)
+  {
+    if (is_xz == false)
+    {
+      int length = gzread(gzip_file, destination, size);
+      if (length < 0)
+      {
+        std::cerr << std::endl << "*** CANNOT DECOMPRESS TRACE FILE: " << trace_string << " ***" << std::endl;
+        assert(0);
+      }
+      return length;
+    }
+
+    if (end_of_stream)
+    {
+      return 0;
+    }
+
+    lzma_handler.next_out = reinterpret_cast<uint8_t*>(destination);
+    lzma_handler.avail_out = size;
+    while (lzma_handler.avail_out > 0)
+    {
+      lzma_action action = LZMA_RUN;
+      if (lzma_handler.avail_in == 0)
+      {
+        lzma_handler.next_in = compressed_buffer.data();
+        lzma_handler.avail_in = fread(compressed_buffer.data(), 1, compressed_buffer.size(), compressed_file);
+        if (feof(compressed_file))
+        {
+          action = LZMA_FINISH;
+        }
+      }
+      else if (feof(compressed_file))
+      {
+        action = LZMA_FINISH;
+      }
+
+      lzma_ret result = lzma_code(&lzma_handler, action);
+      if (result == LZMA_STREAM_END)
+      {
+        if (decompress_by_block)
+        {
+          // the stream headers, indexes and padding between blocks are not decompressed, so jump to the next block.
+          if (lzma_index_iter_next(&block_iterator, LZMA_INDEX_ITER_NONEMPTY_BLOCK) == false)
+          {
+            start_block();
+            continue;
+          }
+        }
+
+        end_of_stream = true;
+        break;
+      }
+      if (result != LZMA_OK)
+      {
+        std::cerr << std::endl << "*** CANNOT DECOMPRESS TRACE FILE: " << trace_string << " (liblzma error " << result << ") ***" << std::endl;
+        assert(0);
+      }
+    }
+
+    return size - lzma_handler.avail_out;
+  }
+};
+#endif // TRACE_USE_IN_PROCESS_DECOMPRESSION
+
 tracereader::tracereader(uint8_t cpu, std::string _ts) : cpu(cpu), trace_string(_ts)
 {
   std::string last_dot = trace_string.substr(trace_string.find_last_of("."));
@@ -76,8 +488,116 @@ ooo_model_instr tracereader::read_single_instr()
 {
   T trace_read_instr;
 
+#if (USER_CODES == ENABLE)
+  while (read_bytes(&trace_read_instr, sizeof(T)) != sizeof(T))
+#else
   while (!fread(&trace_read_instr, sizeof(T), 1, trace_file))
+#endif // USER_CODES
+  {
+    // reached end of file for this trace
+    std::cout << "*** Reached end of trace: " << trace_string << std::endl;
+
+    // close the trace file and re-open it
+    close();
+    open(trace_string);
+  }
+
+#if (USER_CODES == ENABLE)
+  next_record++;
+#endif // USER_CODES
+
+  // copy the instruction into the performance model's instruction format
+  ooo_model_instr retval(cpu, trace_read_instr);
+  return retval;
+}
+
+#if (USER_CODES == ENABLE)
+std::size_t tracereader::read_bytes(void* destination, std::size_t size)
+{
+  std::size_t length;
+
+#if (TRACE_USE_IN_PROCESS_DECOMPRESSION == ENABLE)
+  if (decompressor != NULL)
+  {
+    length = decompressor->read(destination, size);
+  }
+  else
+#endif // TRACE_USE_IN_PROCESS_DECOMPRESSION
+  {
+    length = fread(destination, 1, size, trace_file);
+  }
+
+  stream_offset += length;
+  return length;
+}
+
+uint64_t tracereader::discard_bytes(uint64_t size)
+{
+  uint64_t length = 0;
+
+#if (TRACE_USE_IN_PROCESS_DECOMPRESSION == ENABLE)
+  if (decompressor != NULL)
+  {
+    length = decompressor->discard(size);
+  }
+  else
+#endif // TRACE_USE_IN_PROCESS_DECOMPRESSION
+  {
+    // a pipe cannot seek, the bytes are read into a scratch buffer.
+    char scratch[64 * 1024];
+    while (length < size)
+    {
+      std::size_t step = fread(scratch, 1, std::min<uint64_t>(size - length, sizeof(scratch)), trace_file);
+      if (step == 0)
+      {
+        break; // reached end of trace
+      }
+      length += step;
+    }
+  }
+
+  stream_offset += length;
+  return length;
+}
+
+ooo_model_instr tracereader::read_compact_instr()
+{
+  compact_instr trace_read_instr;
+  unsigned char record_type;
+
+  while (true)
   {
+    if (read_bytes(&record_type, sizeof(record_type)) == sizeof(record_type))
+    {
+      if (record_type == COMPACT_RECORD_INSTRUCTION)
+      {
+        if (read_bytes(&trace_read_instr, sizeof(compact_instr)) == sizeof(compact_instr))
+        {
+          next_record++;
+          break;
+        }
+      }
+      else if (record_type == COMPACT_RECORD_ROUTINE_START || record_type == COMPACT_RECORD_ROUTINE_END)
+      {
+        // routine markers are side-band events, the performance model does not consume them for now.
+        compact_routine_event routine_event;
+        if (read_bytes(&routine_event, sizeof(compact_routine_event)) == sizeof(compact_routine_event))
+        {
+          if (routine_event.function_id >= function_dictionary.size())
+          {
+            std::cerr << "*** INVALID FUNCTION ID " << routine_event.function_id << " IN COMPACT TRACE: " << trace_string << " ***" << std::endl;
+            assert(0);
+          }
+          continue;
+        }
+      }
+      else
+      {
+        std::cerr << "*** INVALID RECORD TYPE " << unsigned(record_type) << " IN COMPACT TRACE: " << trace_string << " ***" << std::endl;
+        assert(0);
+      }
+    }
+
     // reached end of file for this trace
     std::cout << "*** Reached end of trace: " << trace_string << std::endl;
 
@@ -91,8 +611,284 @@ ooo_model_instr tracereader::read_single_instr()
   return retval;
 }
 
+bool tracereader::read_compact_header()
+{
+  compact_trace_header header;
+
+  if (read_bytes(&header, sizeof(compact_trace_header)) != sizeof(compact_trace_header))
+  {
+    return false;
+  }
+
+  if (!std::equal(std::begin(header.magic), std::end(header.magic), std::begin(COMPACT_TRACE_MAGIC)))
+  {
+    return false;
+  }
+
+  if (header.version != COMPACT_TRACE_VERSION)
+  {
+    std::cerr << "*** UNSUPPORTED COMPACT TRACE VERSION " << header.version << ": " << trace_string << " ***" << std::endl;
+    assert(0);
+  }
+
+  // load the function-name dictionary
+  function_dictionary.clear();
+  function_dictionary.reserve(header.dictionary_size);
+  for (uint32_t i = 0; i < header.dictionary_size; i++)
+  {
+    uint16_t length;
+    if (read_bytes(&length, sizeof(length)) != sizeof(length))
+    {
+      std::cerr << "*** TRUNCATED FUNCTION DICTIONARY IN COMPACT TRACE: " << trace_string << " ***" << std::endl;
+      assert(0);
+    }
+
+    std::string function_name(length, '\0');
+    if (read_bytes(&function_name[0], length) != length)
+    {
+      std::cerr << "*** TRUNCATED FUNCTION DICTIONARY IN COMPACT TRACE: " << trace_string << " ***" << std::endl;
+      assert(0);
+    }
+    function_dictionary.push_back(function_name);
+  }
+
+  return true;
+}
+
+void tracereader::load_trace_index()
+{
+  std::string index_name = trace_string + ".index";
+
+  struct stat trace_status;
+  if (stat(trace_string.c_str(), &trace_status) != 0)
+  {
+    std::cerr << "*** CANNOT STAT TRACE FILE: " << trace_string << " ***" << std::endl;
+    assert(0);
+  }
+
+  FILE* index_file = fopen(index_name.c_str(), "rb");
+  if (index_file != NULL)
+  {
+    trace_index_header header;
+    bool valid = (fread(&header, sizeof(trace_index_header), 1, index_file) == 1)
+                 && std::equal(std::begin(header.magic), std::end(header.magic), std::begin(TRACE_INDEX_MAGIC))
+                 && (header.version == TRACE_INDEX_VERSION) && (header.interval_bits == TRACE_INDEX_INTERVAL_BITS)
+                 && (header.trace_size == uint64_t(trace_status.st_size)) && (header.trace_time == uint64_t(trace_status.st_mtime));
+
+    if (valid)
+    {
+      trace_index.resize(header.entry_number);
+      valid = (fread(trace_index.data(), sizeof(uint64_t), header.entry_number, index_file) == header.entry_number);
+      record_number = header.record_number;
+    }
+    fclose(index_file);
+
+    if (valid)
+    {
+      return;
+    }
+    trace_index.clear();
+    std::cout << "Trace index " << index_name << " is stale." << std::endl;
+  }
+
+  // read through the trace once, later simulations reuse the index.
+  std::cout << "Building trace index " << index_name << std::endl;
+  build_trace_index();
+
+  trace_index_header header;
+  std::copy(std::begin(TRACE_INDEX_MAGIC), std::end(TRACE_INDEX_MAGIC), std::begin(header.magic));
+  header.version = TRACE_INDEX_VERSION;
+  header.interval_bits = TRACE_INDEX_INTERVAL_BITS;
+  header.trace_size = trace_status.st_size;
+  header.trace_time = trace_status.st_mtime;
+  header.record_number = record_number;
+  header.entry_number = trace_index.size();
+
+  index_file = fopen(index_name.c_str(), "wb");
+  bool written = (index_file != NULL) && (fwrite(&header, sizeof(trace_index_header), 1, index_file) == 1)
+                 && (fwrite(trace_index.data(), sizeof(uint64_t), trace_index.size(), index_file) == trace_index.size());
+  if (index_file != NULL)
+  {
+    written = (fclose(index_file) == 0) && written;
+  }
+  if (written == false)
+  {
+    // the index still serves this simulation.
+    std::cout << "*** CANNOT WRITE TRACE INDEX: " << index_name << " ***" << std::endl;
+    remove(index_name.c_str());
+  }
+}
+
+void tracereader::build_trace_index()
+{
+  close();
+  open(trace_string);
+
+  // only the record types are decoded, the record bodies are discarded.
+  while (true)
+  {
+    uint64_t record_offset = stream_offset;
+    unsigned char record_type;
+    if (read_bytes(&record_type, sizeof(record_type)) != sizeof(record_type))
+    {
+      break;
+    }
+
+    if (record_type == COMPACT_RECORD_INSTRUCTION)
+    {
+      if (discard_bytes(sizeof(compact_instr)) != sizeof(compact_instr))
+      {
+        break;
+      }
+
+      if (next_record % TRACE_INDEX_INTERVAL == 0)
+      {
+        trace_index.push_back(record_offset);
+      }
+      next_record++;
+    }
+    else if (record_type == COMPACT_RECORD_ROUTINE_START || record_type == COMPACT_RECORD_ROUTINE_END)
+    {
+      if (discard_bytes(sizeof(compact_routine_event)) != sizeof(compact_routine_event))
+      {
+        break;
+      }
+    }
+    else
+    {
+      std::cerr << "*** INVALID RECORD TYPE " << unsigned(record_type) << " IN COMPACT TRACE: " << trace_string << " ***" << std::endl;
+      assert(0);
+    }
+  }
+  record_number = next_record;
+
+  close();
+  open(trace_string);
+}
+
+bool tracereader::reposition(uint64_t offset)
+{
+  if (offset < stream_offset)
+  {
+    // a decompressed stream only moves forward.
+    close();
+    open(trace_string);
+  }
+
+#if (TRACE_USE_IN_PROCESS_DECOMPRESSION == ENABLE)
+  if (decompressor != NULL && decomp_program == "xz" && offset > stream_offset)
+  {
+    // start decompression at the xz block holding offset if it is ahead.
+    trace_decompressor* seeking_decompressor = new trace_decompressor(trace_string, true, offset);
+    if (seeking_decompressor->get_start_offset() > stream_offset)
+    {
+      delete decompressor;
+      decompressor = seeking_decompressor;
+      stream_offset = decompressor->get_start_offset();
+    }
+    else
+    {
+      delete seeking_decompressor;
+    }
+  }
+#endif // TRACE_USE_IN_PROCESS_DECOMPRESSION
+
+  uint64_t remaining = offset - stream_offset;
+  return discard_bytes(remaining) == remaining;
+}
+
+void tracereader::seek_record(uint64_t record)
+{
+  if (is_compact_trace)
+  {
+    if (trace_index.empty() && trace_string.substr(0, 4) != "http")
+    {
+      load_trace_index();
+    }
+    if (record_number > 0)
+    {
+      record %= record_number;
+    }
+
+    if (record < next_record)
+    {
+      close();
+      open(trace_string);
+    }
+
+    // jump to the closest indexed record, the remaining records are read one by one.
+    uint64_t entry = record / TRACE_INDEX_INTERVAL;
+    if (entry < trace_index.size() && entry * TRACE_INDEX_INTERVAL > next_record)
+    {
+      reposition(trace_index[entry]);
+      next_record = entry * TRACE_INDEX_INTERVAL;
+    }
+
+    for (uint64_t remaining = record - next_record; remaining > 0; remaining--)
+    {
+      read_compact_instr();
+    }
+    return;
+  }
+
+  if (record_number > 0)
+  {
+    record %= record_number;
+  }
+
+  if (reposition(record * record_size) == false)
+  {
+    // the trace is shorter, now its length is known.
+    record_number = stream_offset / record_size;
+    if (record_number == 0)
+    {
+      std::cerr << "*** EMPTY TRACE FILE: " << trace_string << " ***" << std::endl;
+      assert(0);
+    }
+    std::cout << "*** Reached end of trace: " << trace_string << std::endl;
+
+    record %= record_number;
+    reposition(record * record_size);
+  }
+  next_record = record;
+}
+
+void tracereader::skip_instructions(uint64_t number)
+{
+  // the instructions already decoded into the batch are skipped first.
+  std::size_t step = std::min<uint64_t>(number, batch.size - batch.position);
+  batch.position += step;
+
+  skip_undecoded_instructions(number - step);
+}
+#endif // USER_CODES
+
 void tracereader::open(std::string trace_string)
 {
+#if (USER_CODES == ENABLE)
+  stream_offset = 0;
+  next_record = 0;
+#endif // USER_CODES
+
+#if (TRACE_USE_IN_PROCESS_DECOMPRESSION == ENABLE)
+  // remote traces are still streamed by wget through a pipe
+  if (trace_string.substr(0, 4) != "http")
+  {
+    decompressor = new trace_decompressor(trace_string, decomp_program == "xz");
+
+    // detect the trace format by peeking the header of the decompressed stream
+    is_compact_trace = read_compact_header();
+    if (is_compact_trace == false)
+    {
+      // the peeked bytes belong to the first instruction record, so restart the stream.
+      delete decompressor;
+      decompressor = new trace_decompressor(trace_string, decomp_program == "xz");
+      stream_offset = 0;
+    }
+    return;
+  }
+#endif // TRACE_USE_IN_PROCESS_DECOMPRESSION
+
   char gunzip_command[4096];
   sprintf(gunzip_command, cmd_fmtstr.c_str(), decomp_program.c_str(), trace_string.c_str());
   trace_file = popen(gunzip_command, "r");
@@ -101,13 +897,41 @@ void tracereader::open(std::string trace_string)
     std::cerr << std::endl << "*** CANNOT OPEN TRACE FILE: " << trace_string << " ***" << std::endl;
     assert(0);
   }
+
+#if (USER_CODES == ENABLE)
+  // detect the trace format by peeking the header of the decompressed stream
+  is_compact_trace = read_compact_header();
+  if (is_compact_trace == false)
+  {
+    // the peeked bytes belong to the first instruction record, so restart the stream.
+    pclose(trace_file);
+    trace_file = popen(gunzip_command, "r");
+    if (trace_file == NULL)
+    {
+      std::cerr << std::endl << "*** CANNOT OPEN TRACE FILE: " << trace_string << " ***" << std::endl;
+      assert(0);
+    }
+    stream_offset = 0;
+  }
+#endif // USER_CODES
 }
 
 void tracereader::close()
 {
+#if (TRACE_USE_IN_PROCESS_DECOMPRESSION == ENABLE)
+  if (decompressor != NULL)
+  {
+    delete decompressor;
+    decompressor = NULL;
+  }
+#endif // TRACE_USE_IN_PROCESS_DECOMPRESSION
+
   if (trace_file != NULL)
   {
     pclose(trace_file);
+#if (USER_CODES == ENABLE)
+    trace_file = NULL;
+#endif // USER_CODES
   }
 }
 
@@ -117,7 +941,12 @@ class cloudsuite_tracereader : public tracereader
   bool initialized = false;
 
 public:
-  cloudsuite_tracereader(uint8_t cpu, std::string _tn) : tracereader(cpu, _tn) {}
+  cloudsuite_tracereader(uint8_t cpu, std::string _tn) : tracereader(cpu, _tn)
+  {
+#if (USER_CODES == ENABLE)
+    record_size = sizeof(cloudsuite_instr);
+#endif // USER_CODES
+  }
 
   ooo_model_instr get()
   {
@@ -135,6 +964,63 @@ public:
     last_instr = trace_read_instr;
     return retval;
   }
+
+#if (USER_CODES == ENABLE)
+  ooo_model_instr_batch& get_batch()
+  {
+    if (!batch.empty())
+    {
+      return batch;
+    }
+
+    auto instr = batch.instrs.begin();
+    if (!initialized)
+    {
+      // same as get(), the first instruction of the trace is delivered twice
+      last_instr = read_single_instr<cloudsuite_instr>();
+      *instr = last_instr;
+      instr->branch_target = last_instr.ip;
+      ++instr;
+      initialized = true;
+    }
+
+    // decode in place, the branch target of an instruction is the ip of the next one
+    for (; instr != batch.instrs.end(); ++instr)
+    {
+      *instr = std::move(last_instr);
+      last_instr = read_single_instr<cloudsuite_instr>();
+      instr->branch_target = last_instr.ip;
+    }
+
+    batch.position = 0;
+    batch.size = batch.instrs.size();
+    return batch;
+  }
+
+protected:
+  void skip_undecoded_instructions(uint64_t number) override
+  {
+    if (number == 0)
+    {
+      return;
+    }
+
+    if (!initialized)
+    {
+      // skip the first delivery of the first instruction, see get_batch()
+      last_instr = read_single_instr<cloudsuite_instr>();
+      initialized = true;
+      number--;
+    }
+
+    if (number > 0)
+    {
+      // last_instr is delivered next, so it is replaced by the instruction number records later.
+      seek_record(next_record - 1 + number);
+      last_instr = read_single_instr<cloudsuite_instr>();
+    }
+  }
+#endif // USER_CODES
 };
 
 class input_tracereader : public tracereader
@@ -143,11 +1029,20 @@ class input_tracereader : public tracereader
   bool initialized = false;
 
 public:
-  input_tracereader(uint8_t cpu, std::string _tn) : tracereader(cpu, _tn) {}
+  input_tracereader(uint8_t cpu, std::string _tn) : tracereader(cpu, _tn)
+  {
+#if (USER_CODES == ENABLE)
+    record_size = sizeof(input_instr);
+#endif // USER_CODES
+  }
 
   ooo_model_instr get()
   {
+#if (USER_CODES == ENABLE)
+    ooo_model_instr trace_read_instr = is_compact_trace ? read_compact_instr() : read_single_instr<input_instr>();
+#else
     ooo_model_instr trace_read_instr = read_single_instr<input_instr>();
+#endif // USER_CODES
 
     if (!initialized)
     {
@@ -161,6 +1056,63 @@ public:
     last_instr = trace_read_instr;
     return retval;
   }
+
+#if (USER_CODES == ENABLE)
+  ooo_model_instr_batch& get_batch()
+  {
+    if (!batch.empty())
+    {
+      return batch;
+    }
+
+    auto instr = batch.instrs.begin();
+    if (!initialized)
+    {
+      // same as get(), the first instruction of the trace is delivered twice
+      last_instr = is_compact_trace ? read_compact_instr() : read_single_instr<input_instr>();
+      *instr = last_instr;
+      instr->branch_target = last_instr.ip;
+      ++instr;
+      initialized = true;
+    }
+
+    // decode in place, the branch target of an instruction is the ip of the next one
+    for (; instr != batch.instrs.end(); ++instr)
+    {
+      *instr = std::move(last_instr);
+      last_instr = is_compact_trace ? read_compact_instr() : read_single_instr<input_instr>();
+      instr->branch_target = last_instr.ip;
+    }
+
+    batch.position = 0;
+    batch.size = batch.instrs.size();
+    return batch;
+  }
+
+protected:
+  void skip_undecoded_instructions(uint64_t number) override
+  {
+    if (number == 0)
+    {
+      return;
+    }
+
+    if (!initialized)
+    {
+      // skip the first delivery of the first instruction, see get_batch()
+      last_instr = is_compact_trace ? read_compact_instr() : read_single_instr<input_instr>();
+      initialized = true;
+      number--;
+    }
+
+    if (number > 0)
+    {
+      // last_instr is delivered next, so it is replaced by the instruction number records later.
+      seek_record(next_record - 1 + number);
+      last_instr = is_compact_trace ? read_compact_instr() : read_single_instr<input_instr>();
+    }
+  }
+#endif // USER_CODES
 };
 
 tracereader* get_tracereader(std::string fname, uint8_t cpu, bool is_cloudsuite)
@@ -24,31 +24,77 @@
 
 #include "champsim.h"
 #include "util.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif // SIMULATION_USE_CHECKPOINT
 
 #if (USER_CODES == ENABLE)
 // Note ppage_free_list won't be pushed, which means ChampSim won't handle the case when the physical memory is full.
 
-VirtualMemory::VirtualMemory(uint64_t capacity, uint64_t pg_size, uint32_t page_table_levels, uint64_t random_seed, uint64_t minor_fault_penalty)
-  : minor_fault_penalty(minor_fault_penalty), pt_levels(page_table_levels), page_size(pg_size),
-  ppage_free_list((capacity - VMEM_RESERVE_CAPACITY) / PAGE_SIZE, PAGE_SIZE)
+PPAGE_FREE_LIST::PPAGE_FREE_LIST(uint64_t first_ppage, uint64_t ppage_number, uint64_t random_seed, uint32_t stream_number)
+  : first_ppage(first_ppage), ppage_number(ppage_number), stream_number(stream_number), next_indexes(stream_number), current_ppages(stream_number)
 {
-  assert(capacity % PAGE_SIZE == 0);
-  assert(pg_size == (1ul << lg2(pg_size)) && pg_size > 1024);
+  assert(ppage_number >= stream_number && stream_number > 0);
 
-  // populate the free list
-  ppage_free_list.front() = VMEM_RESERVE_CAPACITY;
+  // each half covers at least half of the bits of the page index
+  while ((1ull << (2 * half_bits)) < ppage_number)
+    half_bits++;
 
-  // Fill ppage_free_list with a sequence that begins as ppage_free_list.front() and the increment is PAGE_SIZE.
-  // Note the initial size of ppage_free_list is (capacity - VMEM_RESERVE_CAPACITY).
-  std::partial_sum(std::cbegin(ppage_free_list), std::cend(ppage_free_list), std::begin(ppage_free_list));
+  std::mt19937_64 random_engine{random_seed};
+  for (auto& key : round_keys)
+    key = random_engine();
 
-  //cout << ppage_free_list.front() << " " << ppage_free_list.back() << endl;
+  for (uint32_t stream = 0; stream < stream_number; stream++)
+  {
+    next_indexes[stream] = stream;
+    current_ppages[stream] = first_ppage + permute(stream) * PAGE_SIZE;
+  }
+}
 
-  // then shuffle it
-  std::shuffle(std::begin(ppage_free_list), std::end(ppage_free_list), std::mt19937_64{random_seed});
+void PPAGE_FREE_LIST::pop_front(uint32_t stream)
+{
+  assert(!empty(stream));
+  popped_number++;
+  next_indexes[stream] += stream_number;
+  if (next_indexes[stream] < ppage_number)
+    current_ppages[stream] = first_ppage + permute(next_indexes[stream]) * PAGE_SIZE;
+}
 
-  next_pte_page = ppage_free_list.front();
-  ppage_free_list.pop_front();
+uint64_t PPAGE_FREE_LIST::permute(uint64_t index) const
+{
+  const uint64_t half_mask = bitmask(half_bits);
+
+  // cycle walking: the Feistel network permutes [0, 2^(2 * half_bits)), repeat it until the result is in range.
+  do
+  {
+    uint64_t left = index >> half_bits, right = index & half_mask;
+    for (auto key : round_keys)
+    {
+      uint64_t mixed = vmem_key_hash::mix((right + key) * 0x9e3779b97f4a7c15ull);
+      uint64_t next_right = left ^ (mixed & half_mask);
+      left = right;
+      right = next_right;
+    }
+    index = (left << half_bits) | right;
+  } while (index >= ppage_number);
+
+  return index;
+}
+
+VirtualMemory::VirtualMemory(uint64_t capacity, uint64_t pg_size, uint32_t page_table_levels, uint64_t random_seed, uint64_t minor_fault_penalty)
+  : next_pte_pages(PPAGE_STREAM_NUMBER), minor_fault_penalty(minor_fault_penalty), pt_levels(page_table_levels), page_size(pg_size),
+  ppage_free_list(VMEM_RESERVE_CAPACITY, (capacity - VMEM_RESERVE_CAPACITY) / PAGE_SIZE, random_seed, PPAGE_STREAM_NUMBER)
+{
+  assert(capacity % PAGE_SIZE == 0);
+  assert(pg_size == (1ul << lg2(pg_size)) && pg_size > 1024);
+
+  // the free list hands out the pages beginning at VMEM_RESERVE_CAPACITY in a random order, like a shuffled list of
+  // (capacity - VMEM_RESERVE_CAPACITY) / PAGE_SIZE pages.
+  for (uint32_t stream = 0; stream < PPAGE_STREAM_NUMBER; stream++)
+  {
+    next_pte_pages[stream] = ppage_free_list.front(stream);
+    ppage_free_list.pop_front(stream);
+  }
 }
 
 // Calculate the shift amount of virtual address for accessing the page table
@@ -59,12 +105,17 @@ uint64_t VirtualMemory::get_offset(uint64_t vaddr, uint32_t level) const { retur
 
 std::pair<uint64_t, bool> VirtualMemory::va_to_pa(uint32_t cpu_num, uint64_t vaddr)
 {
-  auto [ppage, fault] = vpage_to_ppage_map.insert({{cpu_num, vaddr >> LOG2_PAGE_SIZE}, ppage_free_list.front()});
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+  std::lock_guard<std::mutex> lock(mutex);
+#endif // SIMULATION_USE_PARALLEL_CORES
+
+  const uint32_t stream = ppage_stream(cpu_num);
+  auto [ppage, fault] = vpage_to_ppage_map.insert({{cpu_num, vaddr >> LOG2_PAGE_SIZE}, ppage_free_list.front(stream)});
 
   // this vpage doesn't yet have a ppage mapping
   if (fault)
   {
-    ppage_free_list.pop_front();
+    ppage_free_list.pop_front(stream);
 #if (PRINT_STATISTICS_INTO_FILE == ENABLE)
     output_statistics.virtual_page_count++;
 #endif  // PRINT_STATISTICS_INTO_FILE
@@ -75,14 +126,19 @@ std::pair<uint64_t, bool> VirtualMemory::va_to_pa(uint32_t cpu_num, uint64_t vad
 
 std::pair<uint64_t, bool> VirtualMemory::get_pte_pa(uint32_t cpu_num, uint64_t vaddr, uint32_t level)
 {
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+  std::lock_guard<std::mutex> lock(mutex);
+#endif // SIMULATION_USE_PARALLEL_CORES
+
+  const uint32_t stream = ppage_stream(cpu_num);
   std::tuple key{cpu_num, vaddr >> shamt(level + 1), level};
-  auto [ppage, fault] = page_table.insert({key, next_pte_page});
+  auto [ppage, fault] = page_table.insert({key, next_pte_pages[stream]});
 
   // this PTE doesn't yet have a mapping
   if (fault)
   {
-    next_pte_page = ppage_free_list.front();
-    ppage_free_list.pop_front();
+    next_pte_pages[stream] = ppage_free_list.front(stream);
+    ppage_free_list.pop_front(stream);
 
 #if (PRINT_STATISTICS_INTO_FILE == ENABLE)
     output_statistics.valid_pte_count[level - 1]++;
@@ -91,23 +147,47 @@ std::pair<uint64_t, bool> VirtualMemory::get_pte_pa(uint32_t cpu_num, uint64_t v
 
   return {splice_bits(ppage->second, get_offset(vaddr, level) * PTE_BYTES, lg2(page_size)), fault};
 }
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void PPAGE_FREE_LIST::checkpoint(CHECKPOINT& checkpoint)
+{
+  checkpoint.check("first physical page", first_ppage);
+  checkpoint.check("physical page number", ppage_number);
+  for (auto key : round_keys)
+    checkpoint.check("random key of the physical page permutation", key);
+
+  checkpoint.check("physical page streams", stream_number);
+  checkpoint.transfer(popped_number);
+  checkpoint.transfer(next_indexes);
+  checkpoint.transfer(current_ppages);
+}
+
+void VirtualMemory::checkpoint(CHECKPOINT& checkpoint)
+{
+  checkpoint.section("VirtualMemory");
+  checkpoint.check("page table levels", pt_levels);
+  checkpoint.check("page table page size", page_size);
+
+  checkpoint.transfer(vpage_to_ppage_map);
+  checkpoint.transfer(page_table);
+  checkpoint.transfer(next_pte_pages);
+  ppage_free_list.checkpoint(checkpoint);
+
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+  checkpoint.transfer(output_statistics.virtual_page_count);
+  checkpoint.transfer(output_statistics.valid_pte_count);
+#endif // PRINT_STATISTICS_INTO_FILE
+}
+#endif // SIMULATION_USE_CHECKPOINT
 #else
 VirtualMemory::VirtualMemory(uint64_t capacity, uint64_t pg_size, uint32_t page_table_levels, uint64_t random_seed, uint64_t minor_fault_penalty)
   : minor_fault_penalty(minor_fault_penalty), pt_levels(page_table_levels), page_size(pg_size),
-  ppage_free_list((capacity - VMEM_RESERVE_CAPACITY) / PAGE_SIZE, PAGE_SIZE)
+  ppage_free_list(VMEM_RESERVE_CAPACITY, (capacity - VMEM_RESERVE_CAPACITY) / PAGE_SIZE, random_seed), next_pte_pages(1)
 {
   assert(capacity % PAGE_SIZE == 0);
   assert(pg_size == (1ul << lg2(pg_size)) && pg_size > 1024);
 
-  // populate the free list
-  ppage_free_list.front() = VMEM_RESERVE_CAPACITY;
-
-  std::partial_sum(std::cbegin(ppage_free_list), std::cend(ppage_free_list), std::begin(ppage_free_list));
-
-  // then shuffle it
-  std::shuffle(std::begin(ppage_free_list), std::end(ppage_free_list), std::mt19937_64{random_seed});
-
-  next_pte_page = ppage_free_list.front();
+  next_pte_pages[0] = ppage_free_list.front();
   ppage_free_list.pop_front();
 }
 
@@ -129,15 +209,15 @@ std::pair<uint64_t, bool> VirtualMemory::va_to_pa(uint32_t cpu_num, uint64_t vad
 std::pair<uint64_t, bool> VirtualMemory::get_pte_pa(uint32_t cpu_num, uint64_t vaddr, uint32_t level)
 {
   std::tuple key{cpu_num, vaddr >> shamt(level + 1), level};
-  auto [ppage, fault] = page_table.insert({key, next_pte_page});
+  auto [ppage, fault] = page_table.insert({key, next_pte_pages[0]});
 
   // this PTE doesn't yet have a mapping
   if (fault)
   {
-    next_pte_page += page_size;
-    if (next_pte_page % PAGE_SIZE)
+    next_pte_pages[0] += page_size;
+    if (next_pte_pages[0] % PAGE_SIZE)
     {
-      next_pte_page = ppage_free_list.front();
+      next_pte_pages[0] = ppage_free_list.front();
       ppage_free_list.pop_front();
     }
   }
@@ -1,4 +1,5 @@
 #include "ProjectConfiguration.h"
+#include "os_transparent_management.h"
 
 MEMORY_TRACE output_memorytrace("memory trace", ".trace");
 SIMULATOR_STATISTICS output_statistics("ChampSim statistics", ".statistics");
@@ -77,10 +78,10 @@ MEMORY_TRACE::~MEMORY_TRACE()
     }
 }
 
-void MEMORY_TRACE::output_memory_trace_hexadecimal(uint64_t address, char type)
+void MEMORY_TRACE::output_memory_trace_hexadecimal(uint64_t address, char type, uint64_t cycle)
 {
     assert(file_handler);
-    fprintf(file_handler, "0x%lx %c\n", address, type);
+    fprintf(file_handler, "0x%lx %c %lu\n", address, type, cycle);
 }
 
 SIMULATOR_STATISTICS::SIMULATOR_STATISTICS(std::string v1, std::string v2)
@@ -123,13 +124,16 @@ SIMULATOR_STATISTICS::~SIMULATOR_STATISTICS()
         fprintf(file_handler, "remapping_request_queue_congestion: %ld.\n", remapping_request_queue_congestion);
 
 #if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-        fprintf(file_handler, "no_free_space_for_migration: %ld (%f).\n", no_free_space_for_migration, no_free_space_for_migration / float(total_access_request_in_memory));
-        fprintf(file_handler, "no_invalid_group_for_migration: %ld (%f).\n", no_invalid_group_for_migration, no_invalid_group_for_migration / float(total_access_request_in_memory));
-        fprintf(file_handler, "unexpandable_since_start_address: %ld (%f).\n", unexpandable_since_start_address, unexpandable_since_start_address / float(total_access_request_in_memory));
-        fprintf(file_handler, "unexpandable_since_no_invalid_group: %ld (%f).\n", unexpandable_since_no_invalid_group, unexpandable_since_no_invalid_group / float(total_access_request_in_memory));
-        fprintf(file_handler, "data_eviction_success: %ld (%f).\n", data_eviction_success, data_eviction_success / float(total_access_request_in_memory));
-        fprintf(file_handler, "data_eviction_failure: %ld (%f).\n", data_eviction_failure, data_eviction_failure / float(total_access_request_in_memory));
-        fprintf(file_handler, "uncertain_counter: %ld (%f).\n", uncertain_counter, uncertain_counter / float(total_access_request_in_memory));
+        if (management_policy == ManagementPolicy::VariableGranularity)
+        {
+            fprintf(file_handler, "no_free_space_for_migration: %ld (%f).\n", no_free_space_for_migration, no_free_space_for_migration / float(total_access_request_in_memory));
+            fprintf(file_handler, "no_invalid_group_for_migration: %ld (%f).\n", no_invalid_group_for_migration, no_invalid_group_for_migration / float(total_access_request_in_memory));
+            fprintf(file_handler, "unexpandable_since_start_address: %ld (%f).\n", unexpandable_since_start_address, unexpandable_since_start_address / float(total_access_request_in_memory));
+            fprintf(file_handler, "unexpandable_since_no_invalid_group: %ld (%f).\n", unexpandable_since_no_invalid_group, unexpandable_since_no_invalid_group / float(total_access_request_in_memory));
+            fprintf(file_handler, "data_eviction_success: %ld (%f).\n", data_eviction_success, data_eviction_success / float(total_access_request_in_memory));
+            fprintf(file_handler, "data_eviction_failure: %ld (%f).\n", data_eviction_failure, data_eviction_failure / float(total_access_request_in_memory));
+            fprintf(file_handler, "uncertain_counter: %ld (%f).\n", uncertain_counter, uncertain_counter / float(total_access_request_in_memory));
+        }
 #endif  // IDEAL_VARIABLE_GRANULARITY
     }
 }
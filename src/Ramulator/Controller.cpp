@@ -8,7 +8,7 @@ using namespace ramulator;
 namespace ramulator
 {
 
-static vector<int> get_offending_subarray(DRAM<SALP>* channel, vector<int>& addr_vec)
+static AddrVec get_offending_subarray(DRAM<SALP>* channel, const AddrVec& addr_vec)
 {
     int sa_id = 0;
     auto rank = channel->children[addr_vec[int(SALP::Level::Rank)]];
@@ -20,7 +20,7 @@ static vector<int> get_offending_subarray(DRAM<SALP>* channel, vector<int>& addr
             sa_id = sa_other->id;
             break;
         }
-    vector<int> offending = addr_vec;
+    AddrVec offending = addr_vec;
     offending[int(SALP::Level::SubArray)] = sa_id;
     offending[int(SALP::Level::Row)] = -1;
     return offending;
@@ -28,7 +28,7 @@ static vector<int> get_offending_subarray(DRAM<SALP>* channel, vector<int>& addr
 
 
 template <>
-vector<int> Controller<SALP>::get_addr_vec(SALP::Command cmd, list<Request>::iterator req)
+AddrVec Controller<SALP>::get_addr_vec(SALP::Command cmd, RequestList::iterator req)
 {
     if (cmd == SALP::Command::PRE_OTHER)
         return get_offending_subarray(channel, req->addr_vec);
@@ -38,13 +38,13 @@ vector<int> Controller<SALP>::get_addr_vec(SALP::Command cmd, list<Request>::ite
 
 
 template <>
-bool Controller<SALP>::is_ready(list<Request>::iterator req)
+bool Controller<SALP>::is_ready(RequestList::iterator req)
 {
     SALP::Command cmd = get_first_cmd(req);
     if (cmd == SALP::Command::PRE_OTHER)
     {
 
-        vector<int> addr_vec = get_offending_subarray(channel, req->addr_vec);
+        AddrVec addr_vec = get_offending_subarray(channel, req->addr_vec);
         return channel->check(cmd, addr_vec.data(), clk);
     }
     else return channel->check(cmd, req->addr_vec.data(), clk);
@@ -54,6 +54,9 @@ template <>
 void Controller<ALDRAM>::update_temp(ALDRAM::Temp current_temperature)
 {
     channel->spec->aldram_timing(current_temperature);
+#if (MEMORY_USE_FLAT_DRAM_TIMING == ENABLE)
+    channel->flatten_timing();
+#endif  // MEMORY_USE_FLAT_DRAM_TIMING
 }
 
 
@@ -77,13 +80,22 @@ void Controller<TLDRAM>::tick()
                 channel->update_serving_requests(
                     req.addr_vec.data(), -1, clk);
             }
+#if (MEMORY_USE_PARALLEL_CHANNELS == ENABLE)
+            completed_requests.push_back(req);
+#else
             req.callback(req);
+#endif  // MEMORY_USE_PARALLEL_CHANNELS
             pending.pop_front();
         }
     }
 
     /*** 2. Should we schedule refreshes? ***/
+#if (MEMORY_USE_SCHEDULED_REFRESH == ENABLE)
+    if (clk >= refresh->wakeup_clk)
+        refresh->tick_ref();
+#else
     refresh->tick_ref();
+#endif  // MEMORY_USE_SCHEDULED_REFRESH
 
     /*** 3. Should we schedule writes? ***/
     if (!write_mode)
@@ -104,7 +116,7 @@ void Controller<TLDRAM>::tick()
     if (otherq.size())
         queue = &otherq;  // "other" requests are rare, so we give them precedence over reads/writes
 
-    auto req = scheduler->get_head(queue->q);
+    auto req = scheduler->get_head(*queue);
     if (req == queue->q.end() || !is_ready(req))
     {
         // we couldn't find a command to schedule -- let's try to be speculative
@@ -192,12 +204,12 @@ void Controller<TLDRAM>::tick()
     }
 
     // remove request from queue
-    queue->q.erase(req);
+    queue->erase(req);
 }
 
 template<>
 void Controller<TLDRAM>::cmd_issue_autoprecharge(typename TLDRAM::Command& cmd,
-                                                 const vector<int>& addr_vec)
+                                                 const AddrVec& addr_vec)
 {
     //TLDRAM currently does not have autoprecharge commands
     return;
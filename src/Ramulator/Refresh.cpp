@@ -47,6 +47,23 @@ void Refresh<DSARP>::early_inject_refresh() {
   if (ctrl->write_mode)
     return;
 
+#if (MEMORY_USE_SCHEDULED_REFRESH == ENABLE)
+  // A bank is only pulled in when it is behind the early pull threshold, so skip the search below when no bank is.
+  // rand() is still called once per rank to keep the random sequence.
+  bool early_pull = false;
+  for (int r = 0; r < max_rank_count && !early_pull; r++)
+    for (int backlog : *(bank_refresh_backlog[r]))
+      if (backlog < backlog_early_pull_threshold) {
+        early_pull = true;
+        break;
+      }
+  if (!early_pull) {
+    for (int r = 0; r < max_rank_count; r++)
+      rand();
+    return;
+  }
+#endif
+
   // OoO bank-level refresh
   vector<bool> is_bank_occupied(max_rank_count * max_bank_count, false);
   Controller<DSARP>::Queue& rdq = ctrl->readq;
@@ -226,7 +243,12 @@ void Refresh<DSARP>::wrp() {
 // OoO refresh of DSARP
 template<>
 void Refresh<DSARP>::tick_ref() {
+#if (MEMORY_USE_SCHEDULED_REFRESH == ENABLE)
+  // Not called in every tick, so follow the clock of the controller
+  clk = ctrl->clk;
+#else
   clk++;
+#endif
 
   bool b_ref_rank = ctrl->channel->spec->b_ref_rank;
   int refresh_interval =
@@ -249,6 +271,15 @@ void Refresh<DSARP>::tick_ref() {
   // Time to schedule a refresh and also try to skip some refreshes
   if ((clk - refreshed) >= refresh_interval)
     inject_refresh(b_ref_rank);
+
+#if (MEMORY_USE_SCHEDULED_REFRESH == ENABLE)
+  // DARP watches the write mode and the queues in every tick
+  if (ctrl->channel->spec->type == DSARP::Type::DARP ||
+    ctrl->channel->spec->type == DSARP::Type::DSARP)
+    wakeup_clk = clk + 1;
+  else
+    wakeup_clk = refreshed + refresh_interval;
+#endif
 }
 /**** End DSARP specialization ****/
 
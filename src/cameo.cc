@@ -1,23 +1,26 @@
-#include "os_transparent_management.h"
+#include "cameo.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif  // SIMULATION_USE_CHECKPOINT
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 
 #if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address)
-    : total_capacity(max_address), fast_memory_capacity(fast_memory_max_address),
-    total_capacity_at_data_block_granularity(max_address >> DATA_MANAGEMENT_OFFSET_BITS),
-    fast_memory_capacity_at_data_block_granularity(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS),
+CAMEO::CAMEO(uint64_t max_address, uint64_t fast_memory_max_address)
+    : OS_TRANSPARENT_MANAGEMENT(ManagementPolicy::Cameo), total_capacity(max_address), fast_memory_capacity(fast_memory_max_address),
+    total_capacity_at_data_block_granularity(max_address >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS),
+    fast_memory_capacity_at_data_block_granularity(fast_memory_max_address >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS),
     fast_memory_offset_bit(lg2(fast_memory_max_address)),   // note here only support integers of 2's power.
-    counter_table(*(new std::vector<COUNTER_WIDTH>(max_address >> DATA_MANAGEMENT_OFFSET_BITS, COUNTER_DEFAULT_VALUE))),
-    hotness_table(*(new std::vector<HOTNESS_WIDTH>(max_address >> DATA_MANAGEMENT_OFFSET_BITS, HOTNESS_DEFAULT_VALUE))),
-    congruence_group_msb(REMAPPING_LOCATION_WIDTH_BITS + fast_memory_offset_bit - 1),
+    counter_table(*(new std::vector<COUNTER_WIDTH>(max_address >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS, COUNTER_DEFAULT_VALUE))),
+    hotness_table(*(new std::vector<HOTNESS_WIDTH>(max_address >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS, HOTNESS_DEFAULT_VALUE))),
+    congruence_group_msb(CAMEO_REMAPPING_LOCATION_WIDTH_BITS + fast_memory_offset_bit - 1),
 #if (BITS_MANIPULATION == ENABLE)
-    line_location_table(*(new std::vector<LOCATION_TABLE_ENTRY_WIDTH>(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS, LOCATION_TABLE_ENTRY_DEFAULT_VALUE)))
+    line_location_table(*(new std::vector<LOCATION_TABLE_ENTRY_WIDTH>(fast_memory_max_address >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS, LOCATION_TABLE_ENTRY_DEFAULT_VALUE)))
 #else
-    line_location_table(*(new std::vector<LocationTableEntry>(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS)))
+    line_location_table(*(new std::vector<LocationTableEntry>(fast_memory_max_address >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS)))
 #endif  // BITS_MANIPULATION
 {
-    hotness_threshold = HOTNESS_THRESHOLD;
+    hotness_threshold = CAMEO_HOTNESS_THRESHOLD;
     remapping_request_queue_congestion = 0;
 
     uint64_t expected_number_in_congruence_group = total_capacity / fast_memory_capacity;
@@ -32,7 +35,7 @@ OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint6
 
 };
 
-OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
+CAMEO::~CAMEO()
 {
     output_statistics.remapping_request_queue_congestion = remapping_request_queue_congestion;
     
@@ -42,7 +45,7 @@ OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
 };
 
 #if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
-bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8_t type, uint8_t type_origin, float queue_busy_degree)
+bool CAMEO::memory_activity_tracking(uint64_t address, uint8_t type, uint8_t type_origin, float queue_busy_degree)
 {
 
 #if (TRACKING_LOAD_ONLY)
@@ -65,7 +68,7 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
         return false;
     }
 
-    uint64_t data_block_address = address >> DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
+    uint64_t data_block_address = address >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
     uint64_t line_location_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;   // calculate the index in line location table
     REMAPPING_LOCATION_WIDTH location = static_cast<REMAPPING_LOCATION_WIDTH>(data_block_address / fast_memory_capacity_at_data_block_granularity); // calculate the location in the entry of the line location table
 
@@ -76,8 +79,8 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
     }
 
 #if (BITS_MANIPULATION == ENABLE)
-    uint8_t msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - REMAPPING_LOCATION_WIDTH_BITS * location;
-    uint8_t lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (REMAPPING_LOCATION_WIDTH_BITS + REMAPPING_LOCATION_WIDTH_BITS * location - 1);
+    uint8_t msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - CAMEO_REMAPPING_LOCATION_WIDTH_BITS * location;
+    uint8_t lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (CAMEO_REMAPPING_LOCATION_WIDTH_BITS + CAMEO_REMAPPING_LOCATION_WIDTH_BITS * location - 1);
 
     REMAPPING_LOCATION_WIDTH remapping_location = get_bits(line_location_table.at(line_location_table_index), msb_in_location_table_entry, lsb_in_location_table_entry);
 #else
@@ -132,8 +135,8 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
         for (REMAPPING_LOCATION_WIDTH i = REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero); i < REMAPPING_LOCATION_WIDTH(RemappingLocation::Max); i++)
         {
 #if (BITS_MANIPULATION == ENABLE)
-            fm_msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - REMAPPING_LOCATION_WIDTH_BITS * i;
-            fm_lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (REMAPPING_LOCATION_WIDTH_BITS + REMAPPING_LOCATION_WIDTH_BITS * i - 1);
+            fm_msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - CAMEO_REMAPPING_LOCATION_WIDTH_BITS * i;
+            fm_lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (CAMEO_REMAPPING_LOCATION_WIDTH_BITS + CAMEO_REMAPPING_LOCATION_WIDTH_BITS * i - 1);
 
             fm_remapping_location = get_bits(line_location_table.at(line_location_table_index), fm_msb_in_location_table_entry, fm_lsb_in_location_table_entry);
 #else
@@ -169,14 +172,14 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
             abort();
         }
 
-        remapping_request.address_in_fm = replace_bits(line_location_table_index << DATA_MANAGEMENT_OFFSET_BITS, uint64_t(fm_remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit);
-        remapping_request.address_in_sm = replace_bits(line_location_table_index << DATA_MANAGEMENT_OFFSET_BITS, uint64_t(remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit);
+        remapping_request.address_in_fm = replace_bits(line_location_table_index << CAMEO_DATA_MANAGEMENT_OFFSET_BITS, uint64_t(fm_remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit);
+        remapping_request.address_in_sm = replace_bits(line_location_table_index << CAMEO_DATA_MANAGEMENT_OFFSET_BITS, uint64_t(remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit);
 
         // indicate the positions in line location table entry for address_in_fm and address_in_sm.
         remapping_request.fm_location = fm_location;
         remapping_request.sm_location = location;
 
-        remapping_request.size = DATA_GRANULARITY_IN_CACHE_LINE;
+        remapping_request.size = CAMEO_DATA_GRANULARITY_IN_CACHE_LINE;
 
         if (queue_busy_degree <= QUEUE_BUSY_DEGREE_THRESHOLD)
         {
@@ -187,7 +190,7 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
     return true;
 };
 #else
-bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree)
+bool CAMEO::memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree)
 {
     if (address >= total_capacity)
     {
@@ -195,7 +198,7 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
         return false;
     }
 
-    uint64_t data_block_address = address >> DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
+    uint64_t data_block_address = address >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
     uint64_t line_location_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;   // calculate the index in line location table
     REMAPPING_LOCATION_WIDTH location = static_cast<REMAPPING_LOCATION_WIDTH>(data_block_address / fast_memory_capacity_at_data_block_granularity); // calculate the location in the entry of the line location table
 
@@ -206,8 +209,8 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
     }
 
 #if (BITS_MANIPULATION == ENABLE)
-    uint8_t msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - REMAPPING_LOCATION_WIDTH_BITS * location;
-    uint8_t lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (REMAPPING_LOCATION_WIDTH_BITS + REMAPPING_LOCATION_WIDTH_BITS * location - 1);
+    uint8_t msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - CAMEO_REMAPPING_LOCATION_WIDTH_BITS * location;
+    uint8_t lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (CAMEO_REMAPPING_LOCATION_WIDTH_BITS + CAMEO_REMAPPING_LOCATION_WIDTH_BITS * location - 1);
 
     REMAPPING_LOCATION_WIDTH remapping_location = get_bits(line_location_table.at(line_location_table_index), msb_in_location_table_entry, lsb_in_location_table_entry);
 #else
@@ -262,8 +265,8 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
         for (REMAPPING_LOCATION_WIDTH i = REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero); i < REMAPPING_LOCATION_WIDTH(RemappingLocation::Max); i++)
         {
 #if (BITS_MANIPULATION == ENABLE)
-            fm_msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - REMAPPING_LOCATION_WIDTH_BITS * i;
-            fm_lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (REMAPPING_LOCATION_WIDTH_BITS + REMAPPING_LOCATION_WIDTH_BITS * i - 1);
+            fm_msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - CAMEO_REMAPPING_LOCATION_WIDTH_BITS * i;
+            fm_lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (CAMEO_REMAPPING_LOCATION_WIDTH_BITS + CAMEO_REMAPPING_LOCATION_WIDTH_BITS * i - 1);
 
             fm_remapping_location = get_bits(line_location_table.at(line_location_table_index), fm_msb_in_location_table_entry, fm_lsb_in_location_table_entry);
 #else
@@ -299,14 +302,14 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
             abort();
         }
 
-        remapping_request.address_in_fm = replace_bits(line_location_table_index << DATA_MANAGEMENT_OFFSET_BITS, uint64_t(fm_remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit);
-        remapping_request.address_in_sm = replace_bits(line_location_table_index << DATA_MANAGEMENT_OFFSET_BITS, uint64_t(remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit);
+        remapping_request.address_in_fm = replace_bits(line_location_table_index << CAMEO_DATA_MANAGEMENT_OFFSET_BITS, uint64_t(fm_remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit);
+        remapping_request.address_in_sm = replace_bits(line_location_table_index << CAMEO_DATA_MANAGEMENT_OFFSET_BITS, uint64_t(remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit);
 
         // indicate the positions in line location table entry for address_in_fm and address_in_sm.
         remapping_request.fm_location = fm_location;
         remapping_request.sm_location = location;
 
-        remapping_request.size = DATA_GRANULARITY_IN_CACHE_LINE;
+        remapping_request.size = CAMEO_DATA_GRANULARITY_IN_CACHE_LINE;
 
         if (queue_busy_degree <= QUEUE_BUSY_DEGREE_THRESHOLD)
         {
@@ -318,47 +321,47 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
 };
 #endif // TRACKING_LOAD_STORE_STATISTICS
 
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(PACKET& packet)
+void CAMEO::physical_to_hardware_address(PACKET& packet)
 {
-    uint64_t data_block_address = packet.address >> DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t data_block_address = packet.address >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t line_location_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;
     REMAPPING_LOCATION_WIDTH location = static_cast<REMAPPING_LOCATION_WIDTH>(data_block_address / fast_memory_capacity_at_data_block_granularity);
 
 #if (BITS_MANIPULATION == ENABLE)
-    uint8_t msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - REMAPPING_LOCATION_WIDTH_BITS * location;
-    uint8_t lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (REMAPPING_LOCATION_WIDTH_BITS + REMAPPING_LOCATION_WIDTH_BITS * location - 1);
+    uint8_t msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - CAMEO_REMAPPING_LOCATION_WIDTH_BITS * location;
+    uint8_t lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (CAMEO_REMAPPING_LOCATION_WIDTH_BITS + CAMEO_REMAPPING_LOCATION_WIDTH_BITS * location - 1);
 
     REMAPPING_LOCATION_WIDTH remapping_location = get_bits(line_location_table.at(line_location_table_index), msb_in_location_table_entry, lsb_in_location_table_entry);
 #else
     REMAPPING_LOCATION_WIDTH remapping_location = line_location_table.at(line_location_table_index).location[location];
 #endif  // BITS_MANIPULATION
 
-    packet.h_address = replace_bits(replace_bits(line_location_table_index << DATA_MANAGEMENT_OFFSET_BITS, uint64_t(remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit), packet.address, DATA_MANAGEMENT_OFFSET_BITS - 1);
+    packet.h_address = replace_bits(replace_bits(line_location_table_index << CAMEO_DATA_MANAGEMENT_OFFSET_BITS, uint64_t(remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit), packet.address, CAMEO_DATA_MANAGEMENT_OFFSET_BITS - 1);
 
 #if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-    packet.h_address_fm = replace_bits(replace_bits(line_location_table_index << DATA_MANAGEMENT_OFFSET_BITS, uint64_t(RemappingLocation::Zero) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit), packet.address, DATA_MANAGEMENT_OFFSET_BITS - 1);
+    packet.h_address_fm = replace_bits(replace_bits(line_location_table_index << CAMEO_DATA_MANAGEMENT_OFFSET_BITS, uint64_t(RemappingLocation::Zero) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit), packet.address, CAMEO_DATA_MANAGEMENT_OFFSET_BITS - 1);
 #endif  // COLOCATED_LINE_LOCATION_TABLE
 };
 
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
+void CAMEO::physical_to_hardware_address(uint64_t& address)
 {
-    uint64_t data_block_address = address >> DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t data_block_address = address >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t line_location_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;
     REMAPPING_LOCATION_WIDTH location = static_cast<REMAPPING_LOCATION_WIDTH>(data_block_address / fast_memory_capacity_at_data_block_granularity);
 
 #if (BITS_MANIPULATION == ENABLE)
-    uint8_t msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - REMAPPING_LOCATION_WIDTH_BITS * location;
-    uint8_t lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (REMAPPING_LOCATION_WIDTH_BITS + REMAPPING_LOCATION_WIDTH_BITS * location - 1);
+    uint8_t msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - CAMEO_REMAPPING_LOCATION_WIDTH_BITS * location;
+    uint8_t lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (CAMEO_REMAPPING_LOCATION_WIDTH_BITS + CAMEO_REMAPPING_LOCATION_WIDTH_BITS * location - 1);
 
     REMAPPING_LOCATION_WIDTH remapping_location = get_bits(line_location_table.at(line_location_table_index), msb_in_location_table_entry, lsb_in_location_table_entry);
 #else
     REMAPPING_LOCATION_WIDTH remapping_location = line_location_table.at(line_location_table_index).location[location];
 #endif  // BITS_MANIPULATION
 
-    address = replace_bits(replace_bits(line_location_table_index << DATA_MANAGEMENT_OFFSET_BITS, uint64_t(remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit), address, DATA_MANAGEMENT_OFFSET_BITS - 1);
+    address = replace_bits(replace_bits(line_location_table_index << CAMEO_DATA_MANAGEMENT_OFFSET_BITS, uint64_t(remapping_location) << fast_memory_offset_bit, congruence_group_msb, fast_memory_offset_bit), address, CAMEO_DATA_MANAGEMENT_OFFSET_BITS - 1);
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request)
+bool CAMEO::issue_remapping_request(RemappingRequest& remapping_request)
 {
     if (remapping_request_queue.empty() == false)
     {
@@ -369,22 +372,22 @@ bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapp
     return false;
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
+bool CAMEO::finish_remapping_request()
 {
     if (remapping_request_queue.empty() == false)
     {
         RemappingRequest remapping_request = remapping_request_queue.front();
         remapping_request_queue.pop_front();
 
-        uint64_t data_block_address = remapping_request.address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
-        //data_block_address = remapping_request.address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS;
+        uint64_t data_block_address = remapping_request.address_in_fm >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS;
+        //data_block_address = remapping_request.address_in_sm >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS;
         uint64_t line_location_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;
 
 #if (BITS_MANIPULATION == ENABLE)
-        uint8_t fm_msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - REMAPPING_LOCATION_WIDTH_BITS * remapping_request.fm_location;
-        uint8_t fm_lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (REMAPPING_LOCATION_WIDTH_BITS + REMAPPING_LOCATION_WIDTH_BITS * remapping_request.fm_location - 1);
-        uint8_t sm_msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - REMAPPING_LOCATION_WIDTH_BITS * remapping_request.sm_location;
-        uint8_t sm_lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (REMAPPING_LOCATION_WIDTH_BITS + REMAPPING_LOCATION_WIDTH_BITS * remapping_request.sm_location - 1);
+        uint8_t fm_msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - CAMEO_REMAPPING_LOCATION_WIDTH_BITS * remapping_request.fm_location;
+        uint8_t fm_lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (CAMEO_REMAPPING_LOCATION_WIDTH_BITS + CAMEO_REMAPPING_LOCATION_WIDTH_BITS * remapping_request.fm_location - 1);
+        uint8_t sm_msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - CAMEO_REMAPPING_LOCATION_WIDTH_BITS * remapping_request.sm_location;
+        uint8_t sm_lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (CAMEO_REMAPPING_LOCATION_WIDTH_BITS + CAMEO_REMAPPING_LOCATION_WIDTH_BITS * remapping_request.sm_location - 1);
 
         REMAPPING_LOCATION_WIDTH fm_remapping_location = get_bits(line_location_table.at(line_location_table_index), fm_msb_in_location_table_entry, fm_lsb_in_location_table_entry);
         REMAPPING_LOCATION_WIDTH sm_remapping_location = get_bits(line_location_table.at(line_location_table_index), sm_msb_in_location_table_entry, sm_lsb_in_location_table_entry);
@@ -410,8 +413,8 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
         for (REMAPPING_LOCATION_WIDTH i = REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero); i < REMAPPING_LOCATION_WIDTH(RemappingLocation::Max); i++)
         {
 #if (BITS_MANIPULATION == ENABLE)
-            uint8_t msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - REMAPPING_LOCATION_WIDTH_BITS * i;
-            uint8_t lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (REMAPPING_LOCATION_WIDTH_BITS + REMAPPING_LOCATION_WIDTH_BITS * i - 1);
+            uint8_t msb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - CAMEO_REMAPPING_LOCATION_WIDTH_BITS * i;
+            uint8_t lsb_in_location_table_entry = LOCATION_TABLE_ENTRY_MSB - (CAMEO_REMAPPING_LOCATION_WIDTH_BITS + CAMEO_REMAPPING_LOCATION_WIDTH_BITS * i - 1);
 
             sum_of_remapping_location += get_bits(line_location_table.at(line_location_table_index), msb_in_location_table_entry, lsb_in_location_table_entry);
 #else
@@ -443,19 +446,48 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
     return true;
 };
 
-void OS_TRANSPARENT_MANAGEMENT::cold_data_detection()
+void CAMEO::cold_data_detection()
 {
     cycle++;
 }
 
-bool OS_TRANSPARENT_MANAGEMENT::cold_data_eviction(uint64_t source_address, float queue_busy_degree)
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+uint64_t CAMEO::idle_cycles()
+{
+    // CAMEO only counts the cycle
+    return std::numeric_limits<uint64_t>::max();
+}
+
+void CAMEO::skip_cycles(uint64_t cycles)
+{
+    cycle += cycles;
+}
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void CAMEO::checkpoint(CHECKPOINT& checkpoint)
+{
+    checkpoint.section("CAMEO");
+    checkpoint.check("total capacity", total_capacity);
+    checkpoint.check("fast memory capacity", fast_memory_capacity);
+    checkpoint.check("data management granularity", CAMEO_DATA_MANAGEMENT_GRANULARITY);
+    checkpoint.check("bits manipulation", BITS_MANIPULATION);
+
+    checkpoint.transfer(cycle);
+    checkpoint.transfer(counter_table);
+    checkpoint.transfer(hotness_table);
+    checkpoint.transfer(line_location_table);
+}
+#endif  // SIMULATION_USE_CHECKPOINT
+
+bool CAMEO::cold_data_eviction(uint64_t source_address, float queue_busy_degree)
 {
     return false;
 }
 
-bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& remapping_request)
+bool CAMEO::enqueue_remapping_request(RemappingRequest& remapping_request)
 {
-    uint64_t data_block_address = remapping_request.address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t data_block_address = remapping_request.address_in_fm >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t line_location_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;
 
     // check duplicated remapping request in remapping_request_queue
@@ -463,7 +495,7 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
     bool duplicated_remapping_request = false;
     for (uint64_t i = 0; i < remapping_request_queue.size(); i++)
     {
-        uint64_t data_block_address_to_check = remapping_request_queue[i].address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
+        uint64_t data_block_address_to_check = remapping_request_queue[i].address_in_fm >> CAMEO_DATA_MANAGEMENT_OFFSET_BITS;
         uint64_t line_location_table_index_to_check = data_block_address_to_check % fast_memory_capacity_at_data_block_granularity;
 
         if (line_location_table_index_to_check == line_location_table_index)
@@ -476,7 +508,7 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
 
     if (duplicated_remapping_request == false)
     {
-        if (remapping_request_queue.size() < REMAPPING_REQUEST_QUEUE_LENGTH)
+        if (remapping_request_queue.size() < CAMEO_REMAPPING_REQUEST_QUEUE_LENGTH)
         {
             if (remapping_request.address_in_fm == remapping_request.address_in_sm)    // check
             {
@@ -490,7 +522,10 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
         else
         {
             //std::cout << __func__ << ": remapping_request_queue is full." << std::endl;
-            remapping_request_queue_congestion++;
+            if (all_warmup_complete > NUM_CPUS)
+            {
+                remapping_request_queue_congestion++;
+            }
         }
     }
     else
@@ -503,7 +538,7 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
 }
 
 #if (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
-bool OS_TRANSPARENT_MANAGEMENT::finish_fm_access_in_incomplete_read_request_queue(uint64_t h_address)
+bool CAMEO::finish_fm_access_in_incomplete_read_request_queue(uint64_t h_address)
 {
     for (size_t i = 0; i < incomplete_read_request_queue.size(); i++)
     {
@@ -524,7 +559,7 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_fm_access_in_incomplete_read_request_queu
     return false;
 }
 
-bool OS_TRANSPARENT_MANAGEMENT::finish_fm_access_in_incomplete_write_request_queue(uint64_t h_address)
+bool CAMEO::finish_fm_access_in_incomplete_write_request_queue(uint64_t h_address)
 {
     for (size_t i = 0; i < incomplete_write_request_queue.size(); i++)
     {
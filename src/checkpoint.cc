@@ -0,0 +1,73 @@
+#include "checkpoint.h"
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+CHECKPOINT::CHECKPOINT(const std::string& file_name, Mode mode)
+    : mode(mode), file_name(file_name)
+{
+    file = fopen(file_name.c_str(), is_saving() ? "wb" : "rb");
+    if (file == NULL)
+    {
+        std::cout << __func__ << ": can not open checkpoint " << file_name << "." << std::endl;
+        abort();
+    }
+
+    check("magic number", CHECKPOINT_MAGIC_NUMBER);
+    check("version", CHECKPOINT_VERSION);
+};
+
+CHECKPOINT::~CHECKPOINT()
+{
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+};
+
+void CHECKPOINT::section(const std::string& name)
+{
+    std::string saved_name = name;
+    transfer(saved_name);
+
+    if (saved_name != name)
+    {
+        std::cout << __func__ << ": " << file_name << " has " << saved_name << " where " << name << " is expected, it is saved with another configuration." << std::endl;
+        abort();
+    }
+};
+
+void CHECKPOINT::transfer(std::string& value)
+{
+    value.resize(transfer_size(value.size()));
+    transfer_bytes(value.data(), value.size());
+};
+
+void CHECKPOINT::transfer(std::vector<bool>& values)
+{
+    // std::vector<bool> is packed in bits and has no data(), so its values are packed into bytes first.
+    values.resize(transfer_size(values.size()));
+
+    std::vector<uint8_t> bytes((values.size() + 7) / 8, 0);
+    for (uint64_t i = 0; i < values.size(); i++)
+    {
+        bytes[i / 8] |= uint8_t(values[i]) << (i % 8);
+    }
+
+    transfer_bytes(bytes.data(), bytes.size());
+
+    for (uint64_t i = 0; i < values.size(); i++)
+    {
+        values[i] = (bytes[i / 8] >> (i % 8)) & 1;
+    }
+};
+
+void CHECKPOINT::transfer_bytes(void* data, std::size_t size)
+{
+    std::size_t done = is_saving() ? fwrite(data, 1, size, file) : fread(data, 1, size, file);
+    if (done != size)
+    {
+        std::cout << __func__ << ": " << (is_saving() ? "can not write " : "truncated ") << file_name << "." << std::endl;
+        abort();
+    }
+};
+
+#endif  // SIMULATION_USE_CHECKPOINT
@@ -1,17 +1,19 @@
 #include "ideal_single_mempod.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif  // SIMULATION_USE_CHECKPOINT
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 #if (IDEAL_SINGLE_MEMPOD == ENABLE)
 
 // complete
-OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address)
-    : total_capacity(max_address), fast_memory_capacity(fast_memory_max_address),
-    total_capacity_at_granularity(max_address >> DATA_MANAGEMENT_OFFSET_BITS),
-    fast_memory_capacity_at_granularity(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS),
-    fast_memory_offset_bit(DATA_MANAGEMENT_OFFSET_BITS),
-    mea_counter_table(*(new std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, MEA_COUNTER_WIDTH>())),
-    address_remapping_table(*(new std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, REMAPPING_TABLE_ENTRY_WIDTH>())),
-    invert_address_remapping_table(*(new std::unordered_map<REMAPPING_TABLE_ENTRY_WIDTH, REMAPPING_TABLE_ENTRY_WIDTH>()))
+MEMPOD::MEMPOD(uint64_t max_address, uint64_t fast_memory_max_address)
+    : OS_TRANSPARENT_MANAGEMENT(ManagementPolicy::MemPod), total_capacity(max_address), fast_memory_capacity(fast_memory_max_address),
+    total_capacity_at_granularity(max_address >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS),
+    fast_memory_capacity_at_granularity(fast_memory_max_address >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS),
+    fast_memory_offset_bit(MEMPOD_DATA_MANAGEMENT_OFFSET_BITS),
+    address_remapping_table(*(new std::vector<REMAPPING_TABLE_ENTRY_WIDTH>(max_address >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS))),
+    invert_address_remapping_table(*(new std::vector<REMAPPING_TABLE_ENTRY_WIDTH>(fast_memory_max_address >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS)))
 {
     remapping_request_queue_congestion = 0;
     intervals = 1;
@@ -19,35 +21,26 @@ OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint6
     interval_cycle = CPU_FREQUENCY * (double)TIME_INTERVAL_MEMPOD_us / MEMORY_CONTROLLER_CLOCK_SCALE;
     next_interval_cycle = interval_cycle;
 
-    /* initializing address_remapping_table and invert_address_remapping_table */
-    // TODO: I think there is faster way to construct mapping.
+    /* initializing address_remapping_table and invert_address_remapping_table (identity mapping) */
+    std::iota(address_remapping_table.begin(), address_remapping_table.end(), REMAPPING_TABLE_ENTRY_WIDTH(0));
+    std::iota(invert_address_remapping_table.begin(), invert_address_remapping_table.end(), REMAPPING_TABLE_ENTRY_WIDTH(0));
 
-    for (REMAPPING_TABLE_ENTRY_WIDTH itr_map = 0; itr_map < fast_memory_capacity_at_granularity; itr_map++)
-    {
-        address_remapping_table[itr_map] = itr_map;
-        invert_address_remapping_table[itr_map] = itr_map;
-    }
-    for (REMAPPING_TABLE_ENTRY_WIDTH itr_map = fast_memory_capacity_at_granularity; itr_map < total_capacity_at_granularity; itr_map++)
-    {
-        address_remapping_table[itr_map] = itr_map;
-    }
     assert(address_remapping_table.size() == total_capacity_at_granularity);
     assert(invert_address_remapping_table.size() == fast_memory_capacity_at_granularity);
 };
 
 // complete
-OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
+MEMPOD::~MEMPOD()
 {
     output_statistics.remapping_request_queue_congestion = remapping_request_queue_congestion;
 
-    delete& mea_counter_table;
     delete& address_remapping_table;
     delete& invert_address_remapping_table;
 };
 
 #if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
 // complete
-bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8_t type, uint8_t type_origin, float queue_busy_degree)
+bool MEMPOD::memory_activity_tracking(uint64_t address, uint8_t type, uint8_t type_origin, float queue_busy_degree)
 {
 #if (TRACKING_LOAD_ONLY)
     if (type_origin == RFO || type_origin == WRITEBACK) // CPU Store Instruction and LLC Writeback is ignored
@@ -69,12 +62,12 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
         return false;
     }
 
-    uint64_t data_segment_address = address >> DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
+    uint64_t data_segment_address = address >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
     update_mea_counter(data_segment_address);
     return true;
 };
 #else
-bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree)
+bool MEMPOD::memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree)
 {
     if (address >= total_capacity)
     {
@@ -82,7 +75,7 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
         return false;
     }
 
-    uint64_t data_segment_address = address >> DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
+    uint64_t data_segment_address = address >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
     update_mea_counter(data_segment_address);
     return true;
 };
@@ -90,71 +83,66 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
 
 
 // debugged
-void OS_TRANSPARENT_MANAGEMENT::update_mea_counter(uint64_t segment_address)
+void MEMPOD::update_mea_counter(uint64_t segment_address)
 {
-    std::deque<REMAPPING_TABLE_ENTRY_WIDTH> data_to_delete;
+    MEACounterEntry* free_entry = nullptr;
 
-    if (mea_counter_table.count(segment_address) == 1) // exist
-    {
-        if (mea_counter_table[segment_address] < (MEA_COUNTER_MAX_VALUE + 1u))
-        {
-            mea_counter_table[segment_address]++;
-        }
-    }
-    else if (mea_counter_table.count(segment_address) == 0) // not exist
+    for (auto& entry : mea_counter_table)
     {
-        if (mea_counter_table.size() >= NUMBER_MEA_COUNTER) // MEA Counter is full
+        if (entry.counter > mea_counter_offset) // valid entry
         {
-            for (auto mea_itr = mea_counter_table.begin(); mea_itr != mea_counter_table.end(); ++mea_itr)
+            if (entry.segment_address == segment_address) // exist
             {
-                mea_itr->second--;
-                if (mea_itr->second == 0)
+                if ((entry.counter - mea_counter_offset) < (MEA_COUNTER_MAX_VALUE + 1u))
                 {
-                    data_to_delete.push_back(mea_itr->first);
+                    entry.counter++;
                 }
-            }
-            while (!data_to_delete.empty())
-            {
-                mea_counter_table.erase(data_to_delete.front());
-                data_to_delete.pop_front();
+                return;
             }
         }
-        else // MEA Counter is not full
+        else if (free_entry == nullptr)
         {
-            mea_counter_table[segment_address] = 1;
+            free_entry = &entry;
         }
     }
-    else
+
+    // not exist
+    if (free_entry == nullptr) // MEA Counter is full
     {
-        std::cout << __func__ << ": mea counter error" << std::endl;
-        assert(0);
+        // decrement all counters, the entries whose counter becomes 0 are invalid now
+        mea_counter_offset++;
+    }
+    else // MEA Counter is not full
+    {
+        free_entry->segment_address = segment_address;
+        free_entry->counter = mea_counter_offset + 1;
     }
 };
 
 // complete
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(PACKET& packet)
+void MEMPOD::physical_to_hardware_address(PACKET& packet)
 {
-    uint64_t data_segment_address = packet.address >> DATA_MANAGEMENT_OFFSET_BITS;
-    uint64_t data_segment_offset = packet.address - (data_segment_address << DATA_MANAGEMENT_OFFSET_BITS);
+    uint64_t data_segment_address = packet.address >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t data_segment_offset = packet.address - (data_segment_address << MEMPOD_DATA_MANAGEMENT_OFFSET_BITS);
 #if (DEBUG_PRINTF == ENABLE)
     printf("physical_to_hardware_address(PACKET), p_segment %lu, h_segment %lu \n", data_segment_address, address_remapping_table[data_segment_address]);
 #endif
-    packet.h_address = (address_remapping_table[data_segment_address] << DATA_MANAGEMENT_OFFSET_BITS) + data_segment_offset;
+    packet.h_address = (address_remapping_table.at(data_segment_address) << MEMPOD_DATA_MANAGEMENT_OFFSET_BITS) + data_segment_offset;
 };
 
 // complete
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
+void MEMPOD::physical_to_hardware_address(uint64_t& address)
 {
-    uint64_t data_segment_address = address >> DATA_MANAGEMENT_OFFSET_BITS;
-    uint64_t data_segment_offset = address - (data_segment_address << DATA_MANAGEMENT_OFFSET_BITS);
+    uint64_t data_segment_address = address >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t data_segment_offset = address - (data_segment_address << MEMPOD_DATA_MANAGEMENT_OFFSET_BITS);
 #if (DEBUG_PRINTF == ENABLE)
     printf("physical_to_hardware_address(uint64_t), p_segment %lu, h_segment %lu \n", data_segment_address, address_remapping_table[data_segment_address]);
 #endif
-    address = (address_remapping_table[data_segment_address] << DATA_MANAGEMENT_OFFSET_BITS) + data_segment_offset;
+    address = (address_remapping_table.at(data_segment_address) << MEMPOD_DATA_MANAGEMENT_OFFSET_BITS) + data_segment_offset;
 };
 
 // complete
-bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request)
+bool MEMPOD::issue_remapping_request(RemappingRequest& remapping_request)
 {
     if (remapping_request_queue.empty() == false)
     {
@@ -166,7 +154,7 @@ bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapp
 };
 
 // complete
-bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
+bool MEMPOD::finish_remapping_request()
 {
     if (remapping_request_queue.empty() == false)
     {
@@ -174,11 +162,11 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
         remapping_request_queue.pop_front();
 
         /* update address_remapping_table */
-        uint64_t data_segment_p_address_fm = remapping_request.p_address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
-        uint64_t data_segment_p_address_sm = remapping_request.p_address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS;
+        uint64_t data_segment_p_address_fm = remapping_request.p_address_in_fm >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;
+        uint64_t data_segment_p_address_sm = remapping_request.p_address_in_sm >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;
 
-        uint64_t data_segment_h_address_fm = remapping_request.h_address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
-        uint64_t data_segment_h_address_sm = remapping_request.h_address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS;
+        uint64_t data_segment_h_address_fm = remapping_request.address_in_fm >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;
+        uint64_t data_segment_h_address_sm = remapping_request.address_in_sm >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;
 
         // sanity check
         if (data_segment_h_address_fm == data_segment_h_address_sm)
@@ -203,13 +191,48 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
 };
 
 // complete
-void OS_TRANSPARENT_MANAGEMENT::cold_data_detection()
+void MEMPOD::cold_data_detection()
 {
     cycle++;
 };
 
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+uint64_t MEMPOD::idle_cycles()
+{
+    // check_interval_swap() starts a new interval when the counted cycle reaches next_interval_cycle
+    double cycles = std::ceil(next_interval_cycle) - 1 - double(cycle);
+    return (cycles > 0) ? uint64_t(cycles) : 0;
+};
+
+void MEMPOD::skip_cycles(uint64_t cycles)
+{
+    cycle += cycles;
+};
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void MEMPOD::checkpoint(CHECKPOINT& checkpoint)
+{
+    checkpoint.section("MEMPOD");
+    checkpoint.check("total capacity", total_capacity);
+    checkpoint.check("fast memory capacity", fast_memory_capacity);
+    checkpoint.check("data management granularity", MEMPOD_DATA_MANAGEMENT_GRANULARITY);
+    checkpoint.check("interval cycle", interval_cycle);
+
+    // the epoch keeps its phase, thus the next interval swap happens at the same cycle as in the saved simulation.
+    checkpoint.transfer(cycle);
+    checkpoint.transfer(next_interval_cycle);
+    checkpoint.transfer(intervals);
+    checkpoint.transfer(swap_fm_address_itr);
+    checkpoint.transfer(mea_counter_table);
+    checkpoint.transfer(mea_counter_offset);
+    checkpoint.transfer(address_remapping_table);
+    checkpoint.transfer(invert_address_remapping_table);
+}
+#endif  // SIMULATION_USE_CHECKPOINT
+
 // complete
-void OS_TRANSPARENT_MANAGEMENT::check_interval_swap(uint8_t swapping_states)
+void MEMPOD::check_interval_swap(uint8_t swapping_states)
 {
     if (cycle >= next_interval_cycle)
     {
@@ -217,7 +240,8 @@ void OS_TRANSPARENT_MANAGEMENT::check_interval_swap(uint8_t swapping_states)
         cancel_not_started_remapping_request(swapping_states);
 
         /* get hot pages and victim pages */
-        std::vector<REMAPPING_TABLE_ENTRY_WIDTH> hot_pages(mea_counter_table.size());
+        std::vector<REMAPPING_TABLE_ENTRY_WIDTH> hot_pages;
+        hot_pages.reserve(NUMBER_MEA_COUNTER);
         get_hot_page_from_mea_counter(hot_pages);
         determine_swap_pair(hot_pages);
 
@@ -237,17 +261,17 @@ void OS_TRANSPARENT_MANAGEMENT::check_interval_swap(uint8_t swapping_states)
 };
 
 // complete
-bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& remapping_request)
+bool MEMPOD::enqueue_remapping_request(RemappingRequest& remapping_request)
 {
     /*
-        uint64_t data_segment_address = remapping_request.h_address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS;
+        uint64_t data_segment_address = remapping_request.address_in_sm >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;
 
         // check duplicated remapping request in remapping_request_queue
         // if duplicated remapping requests exist, we won't add this new remapping request into the remapping_request_queue.
         bool duplicated_remapping_request = false;
         for (uint64_t i = 1; i < remapping_request_queue.size(); i++)
         {
-            uint64_t data_block_address_to_check = remapping_request_queue[i].address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
+            uint64_t data_block_address_to_check = remapping_request_queue[i].address_in_fm >> MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;
             uint64_t line_location_table_index_to_check = data_block_address_to_check % fast_memory_capacity_at_data_block_granularity;
 
             if (line_location_table_index_to_check == line_location_table_index)
@@ -260,7 +284,7 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
 
         if (duplicated_remapping_request == false)
         {
-            if (remapping_request_queue.size() < REMAPPING_REQUEST_QUEUE_LENGTH)
+            if (remapping_request_queue.size() < MEMPOD_REMAPPING_REQUEST_QUEUE_LENGTH)
             {
                 if (remapping_request.address_in_fm == remapping_request.address_in_sm)    // check
                 {
@@ -274,7 +298,10 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
             else
             {
                 //std::cout << __func__ << ": remapping_request_queue is full." << std::endl;
-                remapping_request_queue_congestion++;
+                if (all_warmup_complete > NUM_CPUS)
+                {
+                    remapping_request_queue_congestion++;
+                }
             }
         }
         else
@@ -282,9 +309,9 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
             return false;
         }
     */
-    if (remapping_request_queue.size() < REMAPPING_REQUEST_QUEUE_LENGTH)
+    if (remapping_request_queue.size() < MEMPOD_REMAPPING_REQUEST_QUEUE_LENGTH)
     {
-        if (remapping_request.h_address_in_fm == remapping_request.h_address_in_sm)    // check
+        if (remapping_request.address_in_fm == remapping_request.address_in_sm)    // check
         {
             std::cout << __func__ << ": add new remapping request error 2." << std::endl;
             abort();
@@ -305,25 +332,27 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
 }
 
 // debugged
-void OS_TRANSPARENT_MANAGEMENT::get_hot_page_from_mea_counter(std::vector<REMAPPING_TABLE_ENTRY_WIDTH>& hot_pages)
+void MEMPOD::get_hot_page_from_mea_counter(std::vector<REMAPPING_TABLE_ENTRY_WIDTH>& hot_pages)
 {
-    int hot_page_itr = 0;
-    for (auto mea_itr = mea_counter_table.begin(); mea_itr != mea_counter_table.end(); ++mea_itr)
+    for (auto& entry : mea_counter_table)
     {
-        hot_pages[hot_page_itr] = mea_itr->first;
-        hot_page_itr++;
+        if (entry.counter > mea_counter_offset) // valid entry
+        {
+            hot_pages.push_back(entry.segment_address);
+        }
     }
     std::sort(hot_pages.begin(), hot_pages.end());
 };
 
 // complete
-void OS_TRANSPARENT_MANAGEMENT::reset_mea_counter()
+void MEMPOD::reset_mea_counter()
 {
-    mea_counter_table.clear();
+    mea_counter_table.fill(MEACounterEntry());
+    mea_counter_offset = 0;
 };
 
 // debugged
-void OS_TRANSPARENT_MANAGEMENT::determine_swap_pair(std::vector<REMAPPING_TABLE_ENTRY_WIDTH>& hot_pages)
+void MEMPOD::determine_swap_pair(std::vector<REMAPPING_TABLE_ENTRY_WIDTH>& hot_pages)
 {
 
 #if (PRINT_SWAPS_PER_EPOCH_MEMPOD == ENABLE)
@@ -368,10 +397,10 @@ void OS_TRANSPARENT_MANAGEMENT::determine_swap_pair(std::vector<REMAPPING_TABLE_
         }
 
         RemappingRequest remapping_request;
-        remapping_request.p_address_in_fm = invert_address_remapping_table[swap_fm_address_itr] << DATA_MANAGEMENT_OFFSET_BITS;
-        remapping_request.p_address_in_sm = hot_page_in_sm[hot_page_in_sm_itr].p_address << DATA_MANAGEMENT_OFFSET_BITS;
-        remapping_request.h_address_in_fm = swap_fm_address_itr << DATA_MANAGEMENT_OFFSET_BITS;
-        remapping_request.h_address_in_sm = hot_page_in_sm[hot_page_in_sm_itr].h_address << DATA_MANAGEMENT_OFFSET_BITS;
+        remapping_request.p_address_in_fm = invert_address_remapping_table[swap_fm_address_itr] << MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;
+        remapping_request.p_address_in_sm = hot_page_in_sm[hot_page_in_sm_itr].p_address << MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;
+        remapping_request.address_in_fm = swap_fm_address_itr << MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;
+        remapping_request.address_in_sm = hot_page_in_sm[hot_page_in_sm_itr].h_address << MEMPOD_DATA_MANAGEMENT_OFFSET_BITS;
         remapping_request.size = SWAP_DATA_CACHE_LINES;
         enqueue_remapping_request(remapping_request);
 
@@ -395,7 +424,7 @@ void OS_TRANSPARENT_MANAGEMENT::determine_swap_pair(std::vector<REMAPPING_TABLE_
 };
 
 // complete
-void OS_TRANSPARENT_MANAGEMENT::cancel_not_started_remapping_request(uint8_t swapping_states)
+void MEMPOD::cancel_not_started_remapping_request(uint8_t swapping_states)
 {
     switch (swapping_states)
     {
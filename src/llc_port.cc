@@ -0,0 +1,90 @@
+#include "llc_port.h"
+
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+LLC_PORT::LLC_PORT(CACHE* llc)
+    : MemoryRequestConsumer(llc->fill_level), MemoryRequestProducer(llc)
+{
+    for (uint8_t queue_type : {RQ_TYPE, WQ_TYPE, PQ_TYPE})
+    {
+        queue_sizes[queue_type] = llc->get_size(queue_type, 0);
+    }
+};
+
+int LLC_PORT::add_request(QueueType queue_type, PACKET* packet)
+{
+    if (requests[queue_type].size() >= queue_sizes[queue_type])
+    {
+        return int(ReturnValue::Full);
+    }
+
+    requests[queue_type].push_back({upper_level->current_cycle, *packet});
+
+    // the LLC returns the data to this port, which passes it to the L2C
+    PACKET& request_packet = requests[queue_type].back().packet;
+    if (request_packet.to_return.empty() == false)
+    {
+        request_packet.to_return = {this};
+    }
+
+    return requests[queue_type].size();
+};
+
+uint32_t LLC_PORT::get_occupancy(uint8_t queue_type, uint64_t address)
+{
+    if (queue_type == RQ_TYPE || queue_type == WQ_TYPE || queue_type == PQ_TYPE)
+    {
+        return requests[queue_type].size();
+    }
+
+    return 0;
+};
+
+uint32_t LLC_PORT::get_size(uint8_t queue_type, uint64_t address)
+{
+    if (queue_type == RQ_TYPE || queue_type == WQ_TYPE || queue_type == PQ_TYPE)
+    {
+        return queue_sizes[queue_type];
+    }
+
+    return 0;
+};
+
+void LLC_PORT::deliver_responses()
+{
+    for (PACKET& packet : responses)
+    {
+        upper_level->return_data(&packet);
+    }
+    responses.clear();
+};
+
+void LLC_PORT::return_data(PACKET* packet)
+{
+    responses.push_back(*packet);
+};
+
+void LLC_PORT::forward_requests(uint64_t cycle)
+{
+    // the L2C sends its writebacks before its reads and prefetches in a cycle
+    for (uint8_t queue_type : {WQ_TYPE, RQ_TYPE, PQ_TYPE})
+    {
+        std::deque<Request>& queue = requests[queue_type];
+        while (queue.empty() == false && queue.front().cycle < cycle)
+        {
+            int result;
+            if (queue_type == WQ_TYPE)
+                result = lower_level->add_wq(&queue.front().packet);
+            else if (queue_type == RQ_TYPE)
+                result = lower_level->add_rq(&queue.front().packet);
+            else
+                result = lower_level->add_pq(&queue.front().packet);
+
+            if (result == int(ReturnValue::Full))
+            {
+                break;
+            }
+            queue.pop_front();
+        }
+    }
+};
+#endif  // SIMULATION_USE_PARALLEL_CORES
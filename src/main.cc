@@ -21,6 +21,9 @@ uint8_t warmup_complete[NUM_CPUS] = {}, simulation_complete[NUM_CPUS] = {}, all_
 MAX_INSTR_DESTINATIONS = NUM_INSTR_DESTINATIONS, knob_cloudsuite = 0, knob_low_bandwidth = 0;
 
 uint64_t warmup_instructions = 1000000, simulation_instructions = 10000000;
+#if (USER_CODES == ENABLE)
+uint64_t skip_instructions = 0;  // instructions at the beginning of every trace which are not simulated
+#endif  // USER_CODES
 
 auto start_time = time(NULL);
 
@@ -39,6 +42,21 @@ champsim::deprecated_clock_cycle current_core_cycle;
 
 std::vector<tracereader*> traces;
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+std::string save_checkpoint_file, load_checkpoint_file;  // empty if the simulation doesn't save or load a checkpoint
+#endif  // SIMULATION_USE_CHECKPOINT
+
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+uint64_t skipped_cycles = 0;  // the idle cycles jumped over by skip_idle_cycles()
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (USER_CODES == ENABLE) && (RAMULATOR == ENABLE)
+// --replay_memory_trace <window> replays a memory trace instead of simulating the cores, see MEMORY_TRACE_REPLAY.
+bool replay_memory_trace_flag = false;
+uint32_t replay_window = 0;
+std::string replay_trace_name;
+#endif  // USER_CODES, RAMULATOR
+
 void record_roi_stats(uint32_t cpu, CACHE* cache);
 void print_roi_stats(uint32_t cpu, CACHE* cache);
 void print_sim_stats(uint32_t cpu, CACHE* cache);
@@ -58,13 +76,88 @@ void print_dram_stats();
 void reset_cache_stats(uint32_t cpu, CACHE* cache);
 #if (USER_CODES == ENABLE)
 #if (RAMULATOR == ENABLE)
-void finish_warmup(std::array<O3_CPU*, NUM_CPUS>& ooo_cpu, std::array<CACHE*, NUM_CACHES>& caches);
+void finish_warmup(std::array<O3_CPU*, NUM_CPUS>& ooo_cpu, std::vector<CACHE*>& caches);
 #else
-void finish_warmup(std::array<O3_CPU*, NUM_CPUS>& ooo_cpu, std::array<CACHE*, NUM_CACHES>& caches, MEMORY_CONTROLLER& memory_controller);
+void finish_warmup(std::array<O3_CPU*, NUM_CPUS>& ooo_cpu, std::vector<CACHE*>& caches, MEMORY_CONTROLLER& memory_controller);
 #endif  // RAMULATOR
 #endif  // USER_CODES
 void signal_handler(int signal);
 
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+/** @brief
+ *  Jump over the following cycles in which every component is idle (e.g., all cores wait for the memories).
+ *  Each component advances its cycle counters and statistics as if it is operated in those cycles, so the results
+ *  are the same as the cycle-by-cycle simulation.
+ */
+void skip_idle_cycles(std::vector<champsim::operable*>& operables);
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (USER_CODES == ENABLE) && (RAMULATOR == ENABLE)
+/** @brief
+ *  Drive the memory controller from the memory trace replay_trace_name, the cores and caches are not built.
+ *  --warmup_instructions and --simulation_instructions count the memory requests of the trace here.
+ */
+template <typename MEMORY_CONTROLLER_TYPE>
+void replay_memory_trace(MEMORY_CONTROLLER_TYPE& memory_controller);
+#endif  // USER_CODES, RAMULATOR
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+// save or restore the state of all components, the memory controller is the last one.
+template <typename MEMORY_CONTROLLER_TYPE>
+void transfer_simulation_state(CHECKPOINT& checkpoint, VirtualMemory& vmem, std::array<O3_CPU*, NUM_CPUS>& ooo_cpu, std::array<PageTableWalker*, NUM_CPUS>& ptws,
+                               std::vector<CACHE*>& caches, MEMORY_CONTROLLER_TYPE& memory_controller);
+#endif  // SIMULATION_USE_CHECKPOINT
+
+#if (USER_CODES == ENABLE)
+/** @brief
+ *  The cores and their cache hierarchy, built for NUM_CPUS cores. Every core has its private L1I, L1D, L2C, ITLB, DTLB,
+ *  STLB and page table walker, and all cores share the LLC, which sends its misses to the memory controller.
+ *  The components are named cpu<n>_<cache> (e.g., cpu0_L1D) and live as long as this object.
+ */
+class CORE_HIERARCHY
+{
+public:
+  std::array<O3_CPU*, NUM_CPUS> ooo_cpu {};
+  std::array<PageTableWalker*, NUM_CPUS> ptws {};
+  std::vector<CACHE*> caches;                  // the LLC, then L2C, L1D, STLB, L1I, ITLB and DTLB of each core
+  std::vector<champsim::operable*> operables;  // the cores, the LLC, then L2C, L1D, PTW, STLB, L1I, ITLB and DTLB of each core, the memory controller is the last one
+
+  template <typename MEMORY_CONTROLLER_TYPE>
+  CORE_HIERARCHY(MEMORY_CONTROLLER_TYPE& memory_controller, VirtualMemory& vmem): CORE_HIERARCHY(&memory_controller, &memory_controller, vmem) {};
+  CORE_HIERARCHY(const CORE_HIERARCHY&) = delete;
+  CORE_HIERARCHY& operator=(const CORE_HIERARCHY&) = delete;
+
+  CACHE* llc() { return caches.front(); };
+
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+  std::array<LLC_PORT*, NUM_CPUS> llc_ports {};                            // the L2C of each core sends its requests to the LLC through its port
+  std::array<std::vector<champsim::operable*>, NUM_CPUS> core_operables;  // the core, then its L2C, L1D, PTW, STLB, L1I, ITLB and DTLB
+  std::vector<champsim::operable*> shared_operables;                      // the LLC and the memory controller
+#endif  // SIMULATION_USE_PARALLEL_CORES
+
+private:
+  std::vector<std::unique_ptr<CACHE>> cache_storage;
+  std::vector<std::unique_ptr<PageTableWalker>> ptw_storage;
+  std::vector<std::unique_ptr<O3_CPU>> cpu_storage;
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+  std::vector<std::unique_ptr<LLC_PORT>> llc_port_storage;
+#endif  // SIMULATION_USE_PARALLEL_CORES
+
+  CORE_HIERARCHY(MemoryRequestConsumer* memory_controller, champsim::operable* memory_controller_operable, VirtualMemory& vmem);
+
+  CACHE* add_cache(CACHE* cache);
+};
+
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+/** @brief
+ *  Simulate PARALLEL_CORES_QUANTUM cycles. First, the private hierarchy of every core runs the quantum on its own thread.
+ *  Then, the LLC and the memory controller run the same cycles on this thread, taking the requests of the cores
+ *  from their LLC ports in the order of the cores, so the results don't depend on the timing of the threads.
+ */
+void run_parallel_quantum(CORE_HIERARCHY& hierarchy);
+#endif  // SIMULATION_USE_PARALLEL_CORES
+#endif  // USER_CODES
+
 #if (RAMULATOR == ENABLE)
 /* Defines and Declaration for Ramulator */
 using namespace ramulator;
@@ -99,16 +192,19 @@ int main(int argc, char** argv)
   {
 #if (RAMULATOR == ENABLE)
 #if (MEMORY_USE_HYBRID == ENABLE)
-    printf("Usage: %s --warmup_instructions <warmup-instructions> --simulation_instructions <simulation-instructions> [--stats <filename>] <configs-file> <configs-file2> <trace-filename1>\n"
+    printf("Usage: %s --warmup_instructions <warmup-instructions> --simulation_instructions <simulation-instructions> [--skip_instructions <skipped-instructions>] [--stats <filename>] [--memory_policy <name>] [--save_checkpoint <filename> | --load_checkpoint <filename>] [--replay_memory_trace <window>] <configs-file> <configs-file2> <trace-filename1>\n"
            "Example: %s --warmup_instructions 1000000 --simulation_instructions 2000000 ramulator-configs1.cfg ramulator-configs2.cfg cpu_trace.xz\n",
            argv[0], argv[0]);
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    print_management_policies();
+#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
 #else
-    printf("Usage: %s --warmup_instructions <warmup-instructions> --simulation_instructions <simulation-instructions> [--stats <filename>] <configs-file> <trace-filename1>\n"
+    printf("Usage: %s --warmup_instructions <warmup-instructions> --simulation_instructions <simulation-instructions> [--skip_instructions <skipped-instructions>] [--stats <filename>] [--save_checkpoint <filename> | --load_checkpoint <filename>] [--replay_memory_trace <window>] <configs-file> <trace-filename1>\n"
            "Example: %s --warmup_instructions 1000000 --simulation_instructions 2000000 ramulator-configs1.cfg cpu_trace.xz\n",
            argv[0], argv[0]);
 #endif  // MEMORY_USE_HYBRID
 #else
-    printf("Usage: %s --warmup_instructions <warmup-instructions> --simulation_instructions <simulation-instructions> <trace-filename1>\n"
+    printf("Usage: %s --warmup_instructions <warmup-instructions> --simulation_instructions <simulation-instructions> [--skip_instructions <skipped-instructions>] <trace-filename1>\n"
            "Example: %s --warmup_instructions 1000000 --simulation_instructions 2000000 cpu_trace.xz\n",
            argv[0], argv[0]);
 #endif  // RAMULATOR
@@ -117,6 +213,11 @@ int main(int argc, char** argv)
     printf("\nNote: assign cpu traces to each cpu by appending multiple trace files to the command line.\n");
 #endif  // CPU_USE_MULTIPLE_CORES
 
+#if (RAMULATOR == ENABLE)
+    printf("\nNote: with --replay_memory_trace, the trace is a memory trace written by PRINT_MEMORY_TRACE, and the instruction counts are request counts.\n"
+           "The window is the maximum number of reads in flight, and 0 replays the requests at their recorded cycles.\n");
+#endif  // RAMULATOR
+
     return 0;
   }
 
@@ -196,6 +297,27 @@ int main(int argc, char** argv)
       }
     }
 
+    if (strcmp(argv[i], "--skip_instructions") == 0)
+    {
+      if (i + 1 < argc)
+      {
+        skip_instructions = atol(argv[++i]);
+
+#if (RAMULATOR == ENABLE)
+        start_position_of_configs = i + 1;
+        start_position_of_traces = start_position_of_configs + NUMBER_OF_MEMORIES;
+#else
+        start_position_of_traces = i + 1;
+#endif  // RAMULATOR
+        continue;
+      }
+      else
+      {
+        std::cout << __func__ << ": Need parameter behind --skip_instructions." << std::endl;
+        abort_flag++;
+      }
+    }
+
 #if (RAMULATOR == ENABLE)
     if (strcmp(argv[i], "--stats") == 0)
     {
@@ -232,6 +354,68 @@ int main(int argc, char** argv)
         abort_flag++;
       }
     }
+
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+    if (strcmp(argv[i], "--memory_policy") == 0)
+    {
+      if (i + 1 < argc)
+      {
+        if (find_management_policy(argv[++i], management_policy) == false)
+        {
+          std::cout << __func__ << ": Unknown memory policy " << argv[i] << "." << std::endl;
+          print_management_policies();
+          abort_flag++;
+        }
+
+        start_position_of_configs = i + 1;
+        start_position_of_traces = start_position_of_configs + NUMBER_OF_MEMORIES;
+        continue;
+      }
+      else
+      {
+        std::cout << __func__ << ": Need parameter behind --memory_policy." << std::endl;
+        abort_flag++;
+      }
+    }
+#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+    if (strcmp(argv[i], "--save_checkpoint") == 0 || strcmp(argv[i], "--load_checkpoint") == 0)
+    {
+      if (i + 1 < argc)
+      {
+        std::string& checkpoint_file = (strcmp(argv[i], "--save_checkpoint") == 0) ? save_checkpoint_file : load_checkpoint_file;
+        checkpoint_file = argv[++i];
+
+        start_position_of_configs = i + 1;
+        start_position_of_traces = start_position_of_configs + NUMBER_OF_MEMORIES;
+        continue;
+      }
+      else
+      {
+        std::cout << __func__ << ": Need parameter behind " << argv[i] << "." << std::endl;
+        abort_flag++;
+      }
+    }
+#endif  // SIMULATION_USE_CHECKPOINT
+
+    if (strcmp(argv[i], "--replay_memory_trace") == 0)
+    {
+      if (i + 1 < argc)
+      {
+        replay_memory_trace_flag = true;
+        replay_window = atol(argv[++i]);
+
+        start_position_of_configs = i + 1;
+        start_position_of_traces = start_position_of_configs + NUMBER_OF_MEMORIES;
+        continue;
+      }
+      else
+      {
+        std::cout << __func__ << ": Need parameter behind --replay_memory_trace." << std::endl;
+        abort_flag++;
+      }
+    }
 #endif  // RAMULATOR
 
     if (strcmp(argv[i], "--hide_heartbeat") == 0)
@@ -254,6 +438,14 @@ int main(int argc, char** argv)
       abort();
     }
   }
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  if ((save_checkpoint_file.empty() == false) && (load_checkpoint_file.empty() == false))
+  {
+    std::cout << __func__ << ": --save_checkpoint and --load_checkpoint can not be used together." << std::endl;
+    abort();
+  }
+#endif  // SIMULATION_USE_CHECKPOINT
 #else
   // initialize knobs
   uint8_t show_heartbeat = 1;
@@ -382,6 +574,14 @@ int main(int argc, char** argv)
   fprintf(output_statistics.file_handler, "\n*** ChampSim Multicore Out-of-Order Simulator ***\n\n");
 #endif  // PRINT_STATISTICS_INTO_FILE
 
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+  fprintf(output_statistics.file_handler, "Memory management policy: %s\n", get_management_policy_name(management_policy));
+#else
+  std::cout << "Memory management policy: " << get_management_policy_name(management_policy) << std::endl;
+#endif  // PRINT_STATISTICS_INTO_FILE
+#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
+
 #else
   std::cout << "Warmup Instructions: " << warmup_instructions << std::endl;
   std::cout << "Simulation Instructions: " << simulation_instructions << std::endl;
@@ -405,7 +605,27 @@ int main(int argc, char** argv)
 
   // start trace file setup
 #if (USER_CODES == ENABLE)
+#if (RAMULATOR == ENABLE)
+  if (replay_memory_trace_flag)
+  {
+    if (argc - start_position_of_traces != 1)
+    {
+      printf("\n*** Replay exactly one memory trace ***\n\n");
+      assert(0);
+    }
+    replay_trace_name = argv[start_position_of_traces];
+
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+    fprintf(output_statistics.file_handler, "Replay memory trace %s with window %d\n", argv[start_position_of_traces], replay_window);
+#else
+    std::cout << "Replay memory trace " << argv[start_position_of_traces] << " with window " << replay_window << std::endl;
+#endif  // PRINT_STATISTICS_INTO_FILE
+  }
+
+  for (int64_t i = start_position_of_traces; i < argc && (replay_memory_trace_flag == false); i++)
+#else
   for (int64_t i = start_position_of_traces; i < argc; i++)
+#endif  // RAMULATOR
   {
 #if (PRINT_STATISTICS_INTO_FILE == ENABLE)
     fprintf(output_statistics.file_handler, "CPU %ld runs %s\n", traces.size(), argv[i]);
@@ -420,6 +640,12 @@ int main(int argc, char** argv)
       printf("\n*** Too many traces for the configured number of cores ***\n\n");
       assert(0);
     }
+
+    // fast-forward the trace, the skipped instructions are not decoded.
+    if (skip_instructions > 0)
+    {
+      traces.back()->skip_instructions(skip_instructions);
+    }
   }
 #else
   for (int i = optind; i < argc; i++)
@@ -436,7 +662,11 @@ int main(int argc, char** argv)
   }
 #endif
 
+#if (USER_CODES == ENABLE) && (RAMULATOR == ENABLE)
+  if (traces.size() != NUM_CPUS && (replay_memory_trace_flag == false))
+#else
   if (traces.size() != NUM_CPUS)
+#endif  // USER_CODES, RAMULATOR
   {
     printf("\n*** Not enough traces for the configured number of cores ***\n\n");
     assert(0);
@@ -809,7 +1039,8 @@ void print_memory_stats(MEMORY_CONTROLLER& memory_controller)
 void print_configuration_details(VirtualMemory& vmem)
 {
 #if (PRINT_STATISTICS_INTO_FILE == ENABLE)
-  fprintf(output_statistics.file_handler, "\nWarmup Instructions: %ld\n", warmup_instructions);
+  fprintf(output_statistics.file_handler, "\nSkip Instructions: %ld\n", skip_instructions);
+  fprintf(output_statistics.file_handler, "Warmup Instructions: %ld\n", warmup_instructions);
   fprintf(output_statistics.file_handler, "Simulation Instructions: %ld\n", simulation_instructions);
   fprintf(output_statistics.file_handler, "Number of CPUs: %d\n", NUM_CPUS);
 
@@ -854,6 +1085,7 @@ void print_configuration_details(VirtualMemory& vmem)
   fprintf(output_statistics.file_handler, ", num_ppages: %ld\n", std::size(vmem.ppage_free_list));
   fprintf(output_statistics.file_handler, "VirtualMemory page size: %ld, log2_page_size: %d\n\n", PAGE_SIZE, LOG2_PAGE_SIZE);
 #else
+  std::cout << "Skip Instructions: " << skip_instructions << std::endl;
   std::cout << "Warmup Instructions: " << warmup_instructions << std::endl;
   std::cout << "Simulation Instructions: " << simulation_instructions << std::endl;
   std::cout << "Number of CPUs: " << NUM_CPUS << std::endl;
@@ -979,9 +1211,9 @@ void reset_cache_stats(uint32_t cpu, CACHE* cache)
 
 #if (USER_CODES == ENABLE)
 #if (RAMULATOR == ENABLE)
-void finish_warmup(std::array<O3_CPU*, NUM_CPUS>& ooo_cpu, std::array<CACHE*, NUM_CACHES>& caches)
+void finish_warmup(std::array<O3_CPU*, NUM_CPUS>& ooo_cpu, std::vector<CACHE*>& caches)
 #else
-void finish_warmup(std::array<O3_CPU*, NUM_CPUS>& ooo_cpu, std::array<CACHE*, NUM_CACHES>& caches, MEMORY_CONTROLLER& memory_controller)
+void finish_warmup(std::array<O3_CPU*, NUM_CPUS>& ooo_cpu, std::vector<CACHE*>& caches, MEMORY_CONTROLLER& memory_controller)
 #endif
 #endif
 {
@@ -1073,6 +1305,247 @@ void signal_handler(int signal)
   exit(1);
 }
 
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+void skip_idle_cycles(std::vector<champsim::operable*>& operables)
+{
+  // the cores are the most expensive to check, so they are checked last
+  uint64_t cycles = std::numeric_limits<uint64_t>::max();
+  for (auto it = operables.rbegin(); it != operables.rend(); ++it)
+  {
+    cycles = (*it)->idle_cycles(cycles);
+    if (cycles == 0)
+    {
+      return;
+    }
+  }
+
+  if (cycles == std::numeric_limits<uint64_t>::max())
+  {
+    return;  // nothing is in flight, so nothing ends the idle cycles
+  }
+
+  for (auto op : operables)
+  {
+    op->skip_cycles(cycles);
+  }
+  skipped_cycles += cycles;
+}
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (USER_CODES == ENABLE)
+CORE_HIERARCHY::CORE_HIERARCHY(MemoryRequestConsumer* memory_controller, champsim::operable* memory_controller_operable, VirtualMemory& vmem)
+{
+  CACHE* LLC = add_cache(new CACHE("LLC", CACHE_CLOCK_SCALE, LLC_LEVEL, LLC_SETS, LLC_WAYS, LLC_WQ_SIZE, LLC_RQ_SIZE, LLC_PQ_SIZE, LLC_MSHR_SIZE, LLC_LATENCY - 1, LLC_FILL_LATENCY, LLC_MAX_READ, LLC_MAX_WRITE, LOG2_BLOCK_SIZE, LLC_PREFETCH_AS_LOAD, LLC_WQ_FULL_ADDRESS, LLC_VIRTUAL_PREFETCH,
+                                   LLC_PREF_ACTIVATE_MASK, memory_controller, LLC_PREFETCHER, LLC_REPLACEMENT_POLICY, ooo_cpu, vmem));
+
+  // the private components of each core, the lower level of each one is built in front of it.
+  std::vector<champsim::operable*> private_operables;
+  for (uint32_t cpu = 0; cpu < NUM_CPUS; cpu++)
+  {
+    const std::string name = "cpu" + std::to_string(cpu) + "_";
+
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+    LLC_PORT* llc_port = new LLC_PORT(LLC);
+    llc_port_storage.emplace_back(llc_port);
+    MemoryRequestConsumer* L2C_lower_level = llc_port;
+#else
+    MemoryRequestConsumer* L2C_lower_level = LLC;
+#endif  // SIMULATION_USE_PARALLEL_CORES
+
+    CACHE* L2C = add_cache(new CACHE(name + "L2C", CACHE_CLOCK_SCALE, L2C_LEVEL, L2C_SETS, L2C_WAYS, L2C_WQ_SIZE, L2C_RQ_SIZE, L2C_PQ_SIZE, L2C_MSHR_SIZE, L2C_LATENCY - 1, L2C_FILL_LATENCY, L2C_MAX_READ, L2C_MAX_WRITE, LOG2_BLOCK_SIZE, L2C_PREFETCH_AS_LOAD, L2C_WQ_FULL_ADDRESS, L2C_VIRTUAL_PREFETCH,
+                                     L2C_PREF_ACTIVATE_MASK, L2C_lower_level, CPU_L2C_PREFETCHER, CPU_L2C_REPLACEMENT_POLICY, ooo_cpu, vmem));
+    CACHE* L1D = add_cache(new CACHE(name + "L1D", CACHE_CLOCK_SCALE, L1D_LEVEL, L1D_SETS, L1D_WAYS, L1D_WQ_SIZE, L1D_RQ_SIZE, L1D_PQ_SIZE, L1D_MSHR_SIZE, L1D_LATENCY - 1, L1D_FILL_LATENCY, L1D_MAX_READ, L1D_MAX_WRITE, LOG2_BLOCK_SIZE, L1D_PREFETCH_AS_LOAD, L1D_WQ_FULL_ADDRESS, L1D_VIRTUAL_PREFETCH,
+                                     L1D_PREF_ACTIVATE_MASK, L2C, CPU_L1D_PREFETCHER, CPU_L1D_REPLACEMENT_POLICY, ooo_cpu, vmem));
+    PageTableWalker* PTW = new PageTableWalker(name + "PTW", cpu, PTW_LEVEL, PTW_PSCL5_SET, PTW_PSCL5_WAY, PTW_PSCL4_SET, PTW_PSCL4_WAY, PTW_PSCL3_SET, PTW_PSCL3_WAY, PTW_PSCL2_SET, PTW_PSCL2_WAY, PTW_RQ_SIZE, PTW_MSHR_SIZE, PTW_MAX_READ, PTW_MAX_WRITE, PTW_LATENCY - 1, L1D, vmem);
+    ptw_storage.emplace_back(PTW);
+    CACHE* STLB = add_cache(new CACHE(name + "STLB", CACHE_CLOCK_SCALE, STLB_LEVEL, STLB_SETS, STLB_WAYS, STLB_WQ_SIZE, STLB_RQ_SIZE, STLB_PQ_SIZE, STLB_MSHR_SIZE, STLB_LATENCY - 1, STLB_FILL_LATENCY, STLB_MAX_READ, STLB_MAX_WRITE, LOG2_PAGE_SIZE, STLB_PREFETCH_AS_LOAD, STLB_WQ_FULL_ADDRESS, STLB_VIRTUAL_PREFETCH,
+                                      STLB_PREF_ACTIVATE_MASK, PTW, CPU_STLB_PREFETCHER, CPU_STLB_REPLACEMENT_POLICY, ooo_cpu, vmem));
+    CACHE* L1I = add_cache(new CACHE(name + "L1I", CACHE_CLOCK_SCALE, L1I_LEVEL, L1I_SETS, L1I_WAYS, L1I_WQ_SIZE, L1I_RQ_SIZE, L1I_PQ_SIZE, L1I_MSHR_SIZE, L1I_LATENCY - 1, L1I_FILL_LATENCY, L1I_MAX_READ, L1I_MAX_WRITE, LOG2_BLOCK_SIZE, L1I_PREFETCH_AS_LOAD, L1I_WQ_FULL_ADDRESS, L1I_VIRTUAL_PREFETCH,
+                                     L1I_PREF_ACTIVATE_MASK, L2C, CPU_L1I_PREFETCHER, CPU_L1I_REPLACEMENT_POLICY, ooo_cpu, vmem));
+    CACHE* ITLB = add_cache(new CACHE(name + "ITLB", CACHE_CLOCK_SCALE, ITLB_LEVEL, ITLB_SETS, ITLB_WAYS, ITLB_WQ_SIZE, ITLB_RQ_SIZE, ITLB_PQ_SIZE, ITLB_MSHR_SIZE, ITLB_LATENCY - 1, ITLB_FILL_LATENCY, ITLB_MAX_READ, ITLB_MAX_WRITE, LOG2_PAGE_SIZE, ITLB_PREFETCH_AS_LOAD, ITLB_WQ_FULL_ADDRESS, ITLB_VIRTUAL_PREFETCH,
+                                      ITLB_PREF_ACTIVATE_MASK, STLB, CPU_ITLB_PREFETCHER, CPU_ITLB_REPLACEMENT_POLICY, ooo_cpu, vmem));
+    CACHE* DTLB = add_cache(new CACHE(name + "DTLB", CACHE_CLOCK_SCALE, DTLB_LEVEL, DTLB_SETS, DTLB_WAYS, DTLB_WQ_SIZE, DTLB_RQ_SIZE, DTLB_PQ_SIZE, DTLB_MSHR_SIZE, DTLB_LATENCY - 1, DTLB_FILL_LATENCY, DTLB_MAX_READ, DTLB_MAX_WRITE, LOG2_PAGE_SIZE, DTLB_PREFETCH_AS_LOAD, DTLB_WQ_FULL_ADDRESS, DTLB_VIRTUAL_PREFETCH,
+                                      DTLB_PREF_ACTIVATE_MASK, STLB, CPU_DTLB_PREFETCHER, CPU_DTLB_REPLACEMENT_POLICY, ooo_cpu, vmem));
+    O3_CPU* core = new O3_CPU(cpu, O3_CPU_CLOCK_SCALE, CPU_DIB_SET, CPU_DIB_WAY, CPU_DIB_WINDOW, CPU_IFETCH_BUFFER_SIZE, CPU_DECODE_BUFFER_SIZE, CPU_DISPATCH_BUFFER_SIZE, CPU_ROB_SIZE, CPU_LQ_SIZE, CPU_SQ_SIZE, CPU_FETCH_WIDTH, CPU_DECODE_WIDTH, CPU_DISPATCH_WIDTH,
+                              CPU_SCHEDULER_SIZE, CPU_EXECUTE_WIDTH, CPU_LQ_WIDTH, CPU_SQ_WIDTH, CPU_RETIRE_WIDTH, CPU_MISPREDICT_PENALTY, CPU_DECODE_LATENCY, CPU_DISPATCH_LATENCY, CPU_SCHEDULE_LATENCY, CPU_EXECUTE_LATENCY, ITLB, DTLB, L1I, L1D,
+                              BRANCH_PREDICTOR, BRANCH_TARGET_BUFFER, INSTRUCTION_PREFETCHER);
+    cpu_storage.emplace_back(core);
+
+    ooo_cpu.at(cpu) = core;
+    ptws.at(cpu) = PTW;
+    private_operables.insert(private_operables.end(), {L2C, L1D, PTW, STLB, L1I, ITLB, DTLB});
+
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+    llc_port->upper_level = L2C;
+    llc_ports.at(cpu) = llc_port;
+    core_operables.at(cpu) = {core, L2C, L1D, PTW, STLB, L1I, ITLB, DTLB};
+#endif  // SIMULATION_USE_PARALLEL_CORES
+  }
+
+  // the order of operables is the order in which they are operated in each cycle.
+  operables.insert(operables.end(), ooo_cpu.begin(), ooo_cpu.end());
+  operables.push_back(LLC);
+  operables.insert(operables.end(), private_operables.begin(), private_operables.end());
+  operables.push_back(memory_controller_operable);
+
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+  shared_operables = {LLC, memory_controller_operable};
+#endif  // SIMULATION_USE_PARALLEL_CORES
+}
+
+CACHE* CORE_HIERARCHY::add_cache(CACHE* cache)
+{
+  cache_storage.emplace_back(cache);
+  caches.push_back(cache);
+  return cache;
+}
+
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+void run_parallel_quantum(CORE_HIERARCHY& hierarchy)
+{
+  bool deadlock = false;
+
+#pragma omp parallel for num_threads(std::min<uint32_t>(NUM_CPUS, SET_THREADS_NUMBER)) schedule(static)
+  for (uint32_t cpu = 0; cpu < NUM_CPUS; cpu++)
+  {
+    O3_CPU* core = hierarchy.ooo_cpu[cpu];
+    hierarchy.llc_ports[cpu]->deliver_responses();
+
+    try
+    {
+      for (uint64_t cycle = 0; cycle < PARALLEL_CORES_QUANTUM; cycle++)
+      {
+        for (auto op : hierarchy.core_operables[cpu])
+        {
+          op->_operate();
+        }
+
+        // read from trace
+        while (core->fetch_stall == 0 && core->instrs_to_read_this_cycle > 0)
+        {
+          core->init_instructions(traces[cpu]->get_batch());
+        }
+      }
+    }
+    catch (champsim::deadlock& dl)
+    {
+#pragma omp atomic write
+      deadlock = true;
+    }
+  }
+
+  try
+  {
+    for (uint64_t cycle = 0; cycle < PARALLEL_CORES_QUANTUM; cycle++)
+    {
+      // the LLC takes the requests sent before its current cycle, as if the L2Cs were operated after it in the last cycle.
+      for (LLC_PORT* llc_port : hierarchy.llc_ports)
+      {
+        llc_port->forward_requests(hierarchy.llc()->current_cycle);
+      }
+
+      for (auto op : hierarchy.shared_operables)
+      {
+        op->_operate();
+      }
+    }
+  }
+  catch (champsim::deadlock& dl)
+  {
+    deadlock = true;
+  }
+
+  if (deadlock)
+  {
+    for (auto op : hierarchy.operables)
+    {
+      op->print_deadlock();
+      std::cout << std::endl;
+    }
+
+    abort();
+  }
+}
+#endif  // SIMULATION_USE_PARALLEL_CORES
+#endif  // USER_CODES
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+template <typename MEMORY_CONTROLLER_TYPE>
+void transfer_simulation_state(CHECKPOINT& checkpoint, VirtualMemory& vmem, std::array<O3_CPU*, NUM_CPUS>& ooo_cpu, std::array<PageTableWalker*, NUM_CPUS>& ptws,
+                               std::vector<CACHE*>& caches, MEMORY_CONTROLLER_TYPE& memory_controller)
+{
+  checkpoint.check("number of cpus", NUM_CPUS);
+  checkpoint.check("number of caches", uint32_t(caches.size()));
+  checkpoint.check("skipped instructions", skip_instructions);
+
+  vmem.checkpoint(checkpoint);
+
+  for (O3_CPU* cpu : ooo_cpu)
+  {
+    cpu->checkpoint(checkpoint);
+  }
+
+  for (PageTableWalker* ptw : ptws)
+  {
+    ptw->checkpoint(checkpoint);
+  }
+
+  for (CACHE* cache : caches)
+  {
+    cache->checkpoint(checkpoint);
+  }
+
+  memory_controller.checkpoint(checkpoint);
+}
+#endif  // SIMULATION_USE_CHECKPOINT
+
+#if (USER_CODES == ENABLE) && (RAMULATOR == ENABLE)
+template <typename MEMORY_CONTROLLER_TYPE>
+void replay_memory_trace(MEMORY_CONTROLLER_TYPE& memory_controller)
+{
+  MEMORY_TRACE_REPLAY replay(&memory_controller, replay_trace_name, replay_window);
+
+  // warmup, the memory controller operates once per request like it does during the warmup of the cores
+  uint64_t warmup_request_number = 0;
+  while ((warmup_request_number < warmup_instructions) && replay.warmup())
+  {
+    memory_controller._operate();
+    warmup_request_number++;
+  }
+  replay.finish_warmup();
+
+  all_warmup_complete = NUM_CPUS + 1;
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+  fprintf(output_statistics.file_handler, "Warmup complete with %ld memory requests\n", warmup_request_number);
+#else
+  std::cout << "Warmup complete with " << warmup_request_number << " memory requests" << std::endl;
+#endif  // PRINT_STATISTICS_INTO_FILE
+
+  const uint64_t begin_cycle = memory_controller.current_cycle;
+  while (replay.is_finished(simulation_instructions) == false)
+  {
+    replay.operate(memory_controller.current_cycle, simulation_instructions);
+    memory_controller._operate();
+  }
+  const uint64_t finish_cycle = memory_controller.current_cycle - begin_cycle;
+
+  uint64_t elapsed_second = (uint64_t)(time(NULL) - start_time), elapsed_minute = elapsed_second / 60, elapsed_hour = elapsed_minute / 60;
+  elapsed_minute -= elapsed_hour * 60;
+  elapsed_second -= (elapsed_hour * 3600 + elapsed_minute * 60);
+
+  const double average_read_latency = replay.read_number ? double(replay.read_latency_sum) / replay.read_number : 0;
+#if (PRINT_STATISTICS_INTO_FILE == ENABLE)
+  fprintf(output_statistics.file_handler, "\nReplayed memory requests: %ld reads: %ld writes: %ld cycles: %ld", replay.read_number + replay.write_number, replay.read_number, replay.write_number, finish_cycle);
+  fprintf(output_statistics.file_handler, " average read latency: %f", average_read_latency);
+  fprintf(output_statistics.file_handler, " (Simulation time: %ld hr %ld min %ld sec) \n", elapsed_hour, elapsed_minute, elapsed_second);
+#else
+  std::cout << std::endl << "Replayed memory requests: " << replay.read_number + replay.write_number << " reads: " << replay.read_number << " writes: " << replay.write_number << " cycles: " << finish_cycle;
+  std::cout << " average read latency: " << average_read_latency;
+  std::cout << " (Simulation time: " << elapsed_hour << " hr " << elapsed_minute << " min " << elapsed_second << " sec) " << std::endl;
+#endif  // PRINT_STATISTICS_INTO_FILE
+}
+#endif  // USER_CODES, RAMULATOR
+
 #if (RAMULATOR == ENABLE)
 #if (MEMORY_USE_HYBRID == ENABLE)
 void configure_fast_memory_to_run_simulation
@@ -1288,71 +1761,28 @@ void simulation_run(const Config& configs, Memory<T, Controller>& memory, const
 {
   VirtualMemory vmem(memory.max_address + memory2.max_address, PAGE_SIZE, PAGE_TABLE_LEVELS, 1, MINOR_FAULT_PENALTY);
 
-  std::array<O3_CPU*, NUM_CPUS> ooo_cpu{};
   MEMORY_CONTROLLER<T, T2> memory_controller(MEMORY_CONTROLLER_CLOCK_SCALE, CPU_FREQUENCY / memory.spec->speed_entry.freq, CPU_FREQUENCY / memory2.spec->speed_entry.freq, memory, memory2);
-  CACHE LLC("LLC", CACHE_CLOCK_SCALE, LLC_LEVEL, LLC_SETS, LLC_WAYS, LLC_WQ_SIZE, LLC_RQ_SIZE, LLC_PQ_SIZE, LLC_MSHR_SIZE, LLC_LATENCY - 1, LLC_FILL_LATENCY, LLC_MAX_READ, LLC_MAX_WRITE, LOG2_BLOCK_SIZE, LLC_PREFETCH_AS_LOAD, LLC_WQ_FULL_ADDRESS, LLC_VIRTUAL_PREFETCH,
-            LLC_PREF_ACTIVATE_MASK, &memory_controller, LLC_PREFETCHER, LLC_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_L2C("cpu0_L2C", CACHE_CLOCK_SCALE, L2C_LEVEL, L2C_SETS, L2C_WAYS, L2C_WQ_SIZE, L2C_RQ_SIZE, L2C_PQ_SIZE, L2C_MSHR_SIZE, L2C_LATENCY - 1, L2C_FILL_LATENCY, L2C_MAX_READ, L2C_MAX_WRITE, LOG2_BLOCK_SIZE, L2C_PREFETCH_AS_LOAD, L2C_WQ_FULL_ADDRESS, L2C_VIRTUAL_PREFETCH,
-                 L2C_PREF_ACTIVATE_MASK, &LLC, CPU_L2C_PREFETCHER, CPU_L2C_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_L1D("cpu0_L1D", CACHE_CLOCK_SCALE, L1D_LEVEL, L1D_SETS, L1D_WAYS, L1D_WQ_SIZE, L1D_RQ_SIZE, L1D_PQ_SIZE, L1D_MSHR_SIZE, L1D_LATENCY - 1, L1D_FILL_LATENCY, L1D_MAX_READ, L1D_MAX_WRITE, LOG2_BLOCK_SIZE, L1D_PREFETCH_AS_LOAD, L1D_WQ_FULL_ADDRESS, L1D_VIRTUAL_PREFETCH,
-                 L1D_PREF_ACTIVATE_MASK, &cpu0_L2C, CPU_L1D_PREFETCHER, CPU_L1D_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  PageTableWalker cpu0_PTW("cpu0_PTW", PTW_CPU, PTW_LEVEL, PTW_PSCL5_SET, PTW_PSCL5_WAY, PTW_PSCL4_SET, PTW_PSCL4_WAY, PTW_PSCL3_SET, PTW_PSCL3_WAY, PTW_PSCL2_SET, PTW_PSCL2_WAY, PTW_RQ_SIZE, PTW_MSHR_SIZE, PTW_MAX_READ, PTW_MAX_WRITE, PTW_LATENCY - 1, &cpu0_L1D, vmem);
-  CACHE cpu0_STLB("cpu0_STLB", CACHE_CLOCK_SCALE, STLB_LEVEL, STLB_SETS, STLB_WAYS, STLB_WQ_SIZE, STLB_RQ_SIZE, STLB_PQ_SIZE, STLB_MSHR_SIZE, STLB_LATENCY - 1, STLB_FILL_LATENCY, STLB_MAX_READ, STLB_MAX_WRITE, LOG2_PAGE_SIZE, STLB_PREFETCH_AS_LOAD, STLB_WQ_FULL_ADDRESS, STLB_VIRTUAL_PREFETCH,
-                  STLB_PREF_ACTIVATE_MASK, &cpu0_PTW, CPU_STLB_PREFETCHER, CPU_STLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_L1I("cpu0_L1I", CACHE_CLOCK_SCALE, L1I_LEVEL, L1I_SETS, L1I_WAYS, L1I_WQ_SIZE, L1I_RQ_SIZE, L1I_PQ_SIZE, L1I_MSHR_SIZE, L1I_LATENCY - 1, L1I_FILL_LATENCY, L1I_MAX_READ, L1I_MAX_WRITE, LOG2_BLOCK_SIZE, L1I_PREFETCH_AS_LOAD, L1I_WQ_FULL_ADDRESS, L1I_VIRTUAL_PREFETCH,
-                 L1I_PREF_ACTIVATE_MASK, &cpu0_L2C, CPU_L1I_PREFETCHER, CPU_L1I_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_ITLB("cpu0_ITLB", CACHE_CLOCK_SCALE, ITLB_LEVEL, ITLB_SETS, ITLB_WAYS, ITLB_WQ_SIZE, ITLB_RQ_SIZE, ITLB_PQ_SIZE, ITLB_MSHR_SIZE, ITLB_LATENCY - 1, ITLB_FILL_LATENCY, ITLB_MAX_READ, ITLB_MAX_WRITE, LOG2_PAGE_SIZE, ITLB_PREFETCH_AS_LOAD, ITLB_WQ_FULL_ADDRESS, ITLB_VIRTUAL_PREFETCH,
-                  ITLB_PREF_ACTIVATE_MASK, &cpu0_STLB, CPU_ITLB_PREFETCHER, CPU_ITLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_DTLB("cpu0_DTLB", CACHE_CLOCK_SCALE, DTLB_LEVEL, DTLB_SETS, DTLB_WAYS, DTLB_WQ_SIZE, DTLB_RQ_SIZE, DTLB_PQ_SIZE, DTLB_MSHR_SIZE, DTLB_LATENCY - 1, DTLB_FILL_LATENCY, DTLB_MAX_READ, DTLB_MAX_WRITE, LOG2_PAGE_SIZE, DTLB_PREFETCH_AS_LOAD, DTLB_WQ_FULL_ADDRESS, DTLB_VIRTUAL_PREFETCH,
-                  DTLB_PREF_ACTIVATE_MASK, &cpu0_STLB, CPU_DTLB_PREFETCHER, CPU_DTLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  O3_CPU cpu0(CPU_0, O3_CPU_CLOCK_SCALE, CPU_DIB_SET, CPU_DIB_WAY, CPU_DIB_WINDOW, CPU_IFETCH_BUFFER_SIZE, CPU_DECODE_BUFFER_SIZE, CPU_DISPATCH_BUFFER_SIZE, CPU_ROB_SIZE, CPU_LQ_SIZE, CPU_SQ_SIZE, CPU_FETCH_WIDTH, CPU_DECODE_WIDTH, CPU_DISPATCH_WIDTH,
-              CPU_SCHEDULER_SIZE, CPU_EXECUTE_WIDTH, CPU_LQ_WIDTH, CPU_SQ_WIDTH, CPU_RETIRE_WIDTH, CPU_MISPREDICT_PENALTY, CPU_DECODE_LATENCY, CPU_DISPATCH_LATENCY, CPU_SCHEDULE_LATENCY, CPU_EXECUTE_LATENCY, &cpu0_ITLB, &cpu0_DTLB, &cpu0_L1I, &cpu0_L1D,
-              BRANCH_PREDICTOR, BRANCH_TARGET_BUFFER, INSTRUCTION_PREFETCHER);
 
-#if (CPU_USE_MULTIPLE_CORES == ENABLE)
-  CACHE cpu1_L2C("cpu1_L2C", CACHE_CLOCK_SCALE, L2C_LEVEL, L2C_SETS, L2C_WAYS, L2C_WQ_SIZE, L2C_RQ_SIZE, L2C_PQ_SIZE, L2C_MSHR_SIZE, L2C_LATENCY - 1, L2C_FILL_LATENCY, L2C_MAX_READ, L2C_MAX_WRITE, LOG2_BLOCK_SIZE, L2C_PREFETCH_AS_LOAD, L2C_WQ_FULL_ADDRESS, L2C_VIRTUAL_PREFETCH,
-                 L2C_PREF_ACTIVATE_MASK, &LLC, CPU_L2C_PREFETCHER, CPU_L2C_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu1_L1D("cpu1_L1D", CACHE_CLOCK_SCALE, L1D_LEVEL, L1D_SETS, L1D_WAYS, L1D_WQ_SIZE, L1D_RQ_SIZE, L1D_PQ_SIZE, L1D_MSHR_SIZE, L1D_LATENCY - 1, L1D_FILL_LATENCY, L1D_MAX_READ, L1D_MAX_WRITE, LOG2_BLOCK_SIZE, L1D_PREFETCH_AS_LOAD, L1D_WQ_FULL_ADDRESS, L1D_VIRTUAL_PREFETCH,
-                 L1D_PREF_ACTIVATE_MASK, &cpu1_L2C, CPU_L1D_PREFETCHER, CPU_L1D_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  PageTableWalker cpu1_PTW("cpu1_PTW", PTW_CPU, PTW_LEVEL, PTW_PSCL5_SET, PTW_PSCL5_WAY, PTW_PSCL4_SET, PTW_PSCL4_WAY, PTW_PSCL3_SET, PTW_PSCL3_WAY, PTW_PSCL2_SET, PTW_PSCL2_WAY, PTW_RQ_SIZE, PTW_MSHR_SIZE, PTW_MAX_READ, PTW_MAX_WRITE, PTW_LATENCY - 1, &cpu1_L1D, vmem);
-  CACHE cpu1_STLB("cpu1_STLB", CACHE_CLOCK_SCALE, STLB_LEVEL, STLB_SETS, STLB_WAYS, STLB_WQ_SIZE, STLB_RQ_SIZE, STLB_PQ_SIZE, STLB_MSHR_SIZE, STLB_LATENCY - 1, STLB_FILL_LATENCY, STLB_MAX_READ, STLB_MAX_WRITE, LOG2_PAGE_SIZE, STLB_PREFETCH_AS_LOAD, STLB_WQ_FULL_ADDRESS, STLB_VIRTUAL_PREFETCH,
-                  STLB_PREF_ACTIVATE_MASK, &cpu1_PTW, CPU_STLB_PREFETCHER, CPU_STLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu1_L1I("cpu1_L1I", CACHE_CLOCK_SCALE, L1I_LEVEL, L1I_SETS, L1I_WAYS, L1I_WQ_SIZE, L1I_RQ_SIZE, L1I_PQ_SIZE, L1I_MSHR_SIZE, L1I_LATENCY - 1, L1I_FILL_LATENCY, L1I_MAX_READ, L1I_MAX_WRITE, LOG2_BLOCK_SIZE, L1I_PREFETCH_AS_LOAD, L1I_WQ_FULL_ADDRESS, L1I_VIRTUAL_PREFETCH,
-                 L1I_PREF_ACTIVATE_MASK, &cpu1_L2C, CPU_L1I_PREFETCHER, CPU_L1I_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu1_ITLB("cpu1_ITLB", CACHE_CLOCK_SCALE, ITLB_LEVEL, ITLB_SETS, ITLB_WAYS, ITLB_WQ_SIZE, ITLB_RQ_SIZE, ITLB_PQ_SIZE, ITLB_MSHR_SIZE, ITLB_LATENCY - 1, ITLB_FILL_LATENCY, ITLB_MAX_READ, ITLB_MAX_WRITE, LOG2_PAGE_SIZE, ITLB_PREFETCH_AS_LOAD, ITLB_WQ_FULL_ADDRESS, ITLB_VIRTUAL_PREFETCH,
-                  ITLB_PREF_ACTIVATE_MASK, &cpu1_STLB, CPU_ITLB_PREFETCHER, CPU_ITLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu1_DTLB("cpu1_DTLB", CACHE_CLOCK_SCALE, DTLB_LEVEL, DTLB_SETS, DTLB_WAYS, DTLB_WQ_SIZE, DTLB_RQ_SIZE, DTLB_PQ_SIZE, DTLB_MSHR_SIZE, DTLB_LATENCY - 1, DTLB_FILL_LATENCY, DTLB_MAX_READ, DTLB_MAX_WRITE, LOG2_PAGE_SIZE, DTLB_PREFETCH_AS_LOAD, DTLB_WQ_FULL_ADDRESS, DTLB_VIRTUAL_PREFETCH,
-                  DTLB_PREF_ACTIVATE_MASK, &cpu1_STLB, CPU_DTLB_PREFETCHER, CPU_DTLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  O3_CPU cpu1(CPU_1, O3_CPU_CLOCK_SCALE, CPU_DIB_SET, CPU_DIB_WAY, CPU_DIB_WINDOW, CPU_IFETCH_BUFFER_SIZE, CPU_DECODE_BUFFER_SIZE, CPU_DISPATCH_BUFFER_SIZE, CPU_ROB_SIZE, CPU_LQ_SIZE, CPU_SQ_SIZE, CPU_FETCH_WIDTH, CPU_DECODE_WIDTH, CPU_DISPATCH_WIDTH,
-              CPU_SCHEDULER_SIZE, CPU_EXECUTE_WIDTH, CPU_LQ_WIDTH, CPU_SQ_WIDTH, CPU_RETIRE_WIDTH, CPU_MISPREDICT_PENALTY, CPU_DECODE_LATENCY, CPU_DISPATCH_LATENCY, CPU_SCHEDULE_LATENCY, CPU_EXECUTE_LATENCY, &cpu1_ITLB, &cpu1_DTLB, &cpu1_L1I, &cpu1_L1D,
-              BRANCH_PREDICTOR, BRANCH_TARGET_BUFFER, INSTRUCTION_PREFETCHER);
-
-  // put cpu into the cpu array.
-  ooo_cpu.at(0) = &cpu0;
-  ooo_cpu.at(NUM_CPUS - 1) = &cpu1;
-
-  std::array<CACHE*, NUM_CACHES> caches{
-    &LLC,
-      & cpu0_L2C, & cpu0_L1D, & cpu0_STLB, & cpu0_L1I, & cpu0_ITLB, & cpu0_DTLB,
-      & cpu1_L2C, & cpu1_L1D, & cpu1_STLB, & cpu1_L1I, & cpu1_ITLB, & cpu1_DTLB
-  };
-
-  std::array<champsim::operable*, NUM_OPERABLES> operables{
-    &cpu0, & cpu1,
-      & LLC,
-      & cpu0_L2C, & cpu0_L1D, & cpu0_PTW, & cpu0_STLB, & cpu0_L1I, & cpu0_ITLB, & cpu0_DTLB,
-      & cpu1_L2C, & cpu1_L1D, & cpu1_PTW, & cpu1_STLB, & cpu1_L1I, & cpu1_ITLB, & cpu1_DTLB,
-      & memory_controller
-  };
-
-#else
-  // put cpu into the cpu array.
-  ooo_cpu.at(NUM_CPUS - 1) = &cpu0;
-
-  std::array<CACHE*, NUM_CACHES> caches{&LLC, & cpu0_L2C, & cpu0_L1D, & cpu0_STLB, & cpu0_L1I, & cpu0_ITLB, & cpu0_DTLB};
-
-  std::array<champsim::operable*, NUM_OPERABLES> operables{&cpu0, & LLC, & cpu0_L2C, & cpu0_L1D, & cpu0_PTW, & cpu0_STLB, & cpu0_L1I, & cpu0_ITLB, & cpu0_DTLB, & memory_controller};
-#endif  // CPU_USE_MULTIPLE_CORES
+  if (replay_memory_trace_flag)
+  {
+    replay_memory_trace(memory_controller);
+
+    // This a workaround for statistics set only initially lost in the end
+    memory.finish();
+    memory2.finish();
+    Stats::statlist.printall();
+    return;
+  }
+
+  CORE_HIERARCHY hierarchy(memory_controller, vmem);
+  std::array<O3_CPU*, NUM_CPUS>& ooo_cpu = hierarchy.ooo_cpu;
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  std::array<PageTableWalker*, NUM_CPUS>& ptws = hierarchy.ptws;
+#endif  // SIMULATION_USE_CHECKPOINT
+  std::vector<CACHE*>& caches = hierarchy.caches;
+#if (SIMULATION_USE_PARALLEL_CORES == DISABLE)
+  std::vector<champsim::operable*>& operables = hierarchy.operables;
+#endif  // SIMULATION_USE_PARALLEL_CORES
 
   // Output configuration details
   print_configuration_details(vmem);
@@ -1369,6 +1799,25 @@ void simulation_run(const Config& configs, Memory<T, Controller>& memory, const
     (*it)->impl_replacement_initialize();
   }
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  if (load_checkpoint_file.empty() == false)
+  {
+    CHECKPOINT checkpoint(load_checkpoint_file, CHECKPOINT::Mode::Restore);
+    transfer_simulation_state(checkpoint, vmem, ooo_cpu, ptws, caches, memory_controller);
+
+    // the simulation resumes at the end of the saved warmup, so the instructions retired before it are skipped
+    // and finish_warmup() is called in the first cycle.
+    for (std::size_t i = 0; i < ooo_cpu.size(); ++i)
+    {
+      traces[i]->skip_instructions(ooo_cpu[i]->num_retired);
+      warmup_complete[i] = 1;
+    }
+    all_warmup_complete = NUM_CPUS;
+
+    std::cout << "Simulation state is restored from " << load_checkpoint_file << "." << std::endl;
+  }
+#endif  // SIMULATION_USE_CHECKPOINT
+
 #if (MEMORY_USE_SWAPPING_UNIT == ENABLE) && (TEST_SWAPPING_UNIT == ENABLE)
   /* Test */
   all_warmup_complete = 1;
@@ -1377,7 +1826,7 @@ void simulation_run(const Config& configs, Memory<T, Controller>& memory, const
     static uint64_t count = 0;
     static PACKET data1, data2;
     data1.cpu = data2.cpu = 0;
-    data1.to_return = data2.to_return = {(MemoryRequestProducer*)(&LLC)};
+    data1.to_return = data2.to_return = {(MemoryRequestProducer*)(hierarchy.llc())};
     memory_controller.operate();
 
     // issue read and write
@@ -1448,6 +1897,15 @@ void simulation_run(const Config& configs, Memory<T, Controller>& memory, const
     elapsed_minute -= elapsed_hour * 60;
     elapsed_second -= (elapsed_hour * 3600 + elapsed_minute * 60);
 
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+    // the cores run a quantum in parallel and read their traces, then the LLC and the memory controller catch up.
+    // so the checks below (e.g., the end of warmup) are done once per quantum.
+    run_parallel_quantum(hierarchy);
+#else
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+    skip_idle_cycles(operables);
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
     for (auto op : operables)
     {
       try
@@ -1468,16 +1926,23 @@ void simulation_run(const Config& configs, Memory<T, Controller>& memory, const
         abort();
       }
     }
+#endif  // SIMULATION_USE_PARALLEL_CORES
     // we don't need to sort here since the clock difference of cpu and memory is expressed in the memory controller.
     //std::sort(std::begin(operables), std::end(operables), champsim::by_next_operate());
 
     for (std::size_t i = 0; i < ooo_cpu.size(); ++i)
     {
+#if (SIMULATION_USE_PARALLEL_CORES == DISABLE)
       // read from trace
       while (ooo_cpu[i]->fetch_stall == 0 && ooo_cpu[i]->instrs_to_read_this_cycle > 0)
       {
+#if (USER_CODES == ENABLE)
+        ooo_cpu[i]->init_instructions(traces[i]->get_batch());
+#else
         ooo_cpu[i]->init_instruction(traces[i]->get());
+#endif // USER_CODES
       }
+#endif  // SIMULATION_USE_PARALLEL_CORES
 
       // heartbeat information
       if (show_heartbeat && (ooo_cpu[i]->num_retired >= ooo_cpu[i]->next_print_instruction))
@@ -1520,6 +1985,15 @@ void simulation_run(const Config& configs, Memory<T, Controller>& memory, const
         // when all cores are warmed up
         all_warmup_complete++;
         finish_warmup(ooo_cpu, caches);
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+        if (save_checkpoint_file.empty() == false)
+        {
+          CHECKPOINT checkpoint(save_checkpoint_file, CHECKPOINT::Mode::Save);
+          transfer_simulation_state(checkpoint, vmem, ooo_cpu, ptws, caches, memory_controller);
+          std::cout << "Simulation state is saved into " << save_checkpoint_file << "." << std::endl;
+        }
+#endif  // SIMULATION_USE_CHECKPOINT
       }
 
       // simulation complete
@@ -1546,6 +2020,10 @@ void simulation_run(const Config& configs, Memory<T, Controller>& memory, const
     }
   }
 
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+  std::cout << "Clock skipping: " << skipped_cycles << " idle cycles are skipped." << std::endl;
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
   // This a workaround for statistics set only initially lost in the end
   memory.finish();
   memory2.finish();
@@ -1729,71 +2207,27 @@ void simulation_run(const Config& configs, Memory<T, Controller>& memory)
 {
   VirtualMemory vmem(memory.max_address, PAGE_SIZE, PAGE_TABLE_LEVELS, 1, MINOR_FAULT_PENALTY);
 
-  std::array<O3_CPU*, NUM_CPUS> ooo_cpu{};
   MEMORY_CONTROLLER<T> memory_controller(MEMORY_CONTROLLER_CLOCK_SCALE, CPU_FREQUENCY / memory.spec->speed_entry.freq, memory);
-  CACHE LLC("LLC", CACHE_CLOCK_SCALE, LLC_LEVEL, LLC_SETS, LLC_WAYS, LLC_WQ_SIZE, LLC_RQ_SIZE, LLC_PQ_SIZE, LLC_MSHR_SIZE, LLC_LATENCY - 1, LLC_FILL_LATENCY, LLC_MAX_READ, LLC_MAX_WRITE, LOG2_BLOCK_SIZE, LLC_PREFETCH_AS_LOAD, LLC_WQ_FULL_ADDRESS, LLC_VIRTUAL_PREFETCH,
-            LLC_PREF_ACTIVATE_MASK, &memory_controller, LLC_PREFETCHER, LLC_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_L2C("cpu0_L2C", CACHE_CLOCK_SCALE, L2C_LEVEL, L2C_SETS, L2C_WAYS, L2C_WQ_SIZE, L2C_RQ_SIZE, L2C_PQ_SIZE, L2C_MSHR_SIZE, L2C_LATENCY - 1, L2C_FILL_LATENCY, L2C_MAX_READ, L2C_MAX_WRITE, LOG2_BLOCK_SIZE, L2C_PREFETCH_AS_LOAD, L2C_WQ_FULL_ADDRESS, L2C_VIRTUAL_PREFETCH,
-                 L2C_PREF_ACTIVATE_MASK, &LLC, CPU_L2C_PREFETCHER, CPU_L2C_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_L1D("cpu0_L1D", CACHE_CLOCK_SCALE, L1D_LEVEL, L1D_SETS, L1D_WAYS, L1D_WQ_SIZE, L1D_RQ_SIZE, L1D_PQ_SIZE, L1D_MSHR_SIZE, L1D_LATENCY - 1, L1D_FILL_LATENCY, L1D_MAX_READ, L1D_MAX_WRITE, LOG2_BLOCK_SIZE, L1D_PREFETCH_AS_LOAD, L1D_WQ_FULL_ADDRESS, L1D_VIRTUAL_PREFETCH,
-                 L1D_PREF_ACTIVATE_MASK, &cpu0_L2C, CPU_L1D_PREFETCHER, CPU_L1D_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  PageTableWalker cpu0_PTW("cpu0_PTW", PTW_CPU, PTW_LEVEL, PTW_PSCL5_SET, PTW_PSCL5_WAY, PTW_PSCL4_SET, PTW_PSCL4_WAY, PTW_PSCL3_SET, PTW_PSCL3_WAY, PTW_PSCL2_SET, PTW_PSCL2_WAY, PTW_RQ_SIZE, PTW_MSHR_SIZE, PTW_MAX_READ, PTW_MAX_WRITE, PTW_LATENCY - 1, &cpu0_L1D, vmem);
-  CACHE cpu0_STLB("cpu0_STLB", CACHE_CLOCK_SCALE, STLB_LEVEL, STLB_SETS, STLB_WAYS, STLB_WQ_SIZE, STLB_RQ_SIZE, STLB_PQ_SIZE, STLB_MSHR_SIZE, STLB_LATENCY - 1, STLB_FILL_LATENCY, STLB_MAX_READ, STLB_MAX_WRITE, LOG2_PAGE_SIZE, STLB_PREFETCH_AS_LOAD, STLB_WQ_FULL_ADDRESS, STLB_VIRTUAL_PREFETCH,
-                  STLB_PREF_ACTIVATE_MASK, &cpu0_PTW, CPU_STLB_PREFETCHER, CPU_STLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_L1I("cpu0_L1I", CACHE_CLOCK_SCALE, L1I_LEVEL, L1I_SETS, L1I_WAYS, L1I_WQ_SIZE, L1I_RQ_SIZE, L1I_PQ_SIZE, L1I_MSHR_SIZE, L1I_LATENCY - 1, L1I_FILL_LATENCY, L1I_MAX_READ, L1I_MAX_WRITE, LOG2_BLOCK_SIZE, L1I_PREFETCH_AS_LOAD, L1I_WQ_FULL_ADDRESS, L1I_VIRTUAL_PREFETCH,
-                 L1I_PREF_ACTIVATE_MASK, &cpu0_L2C, CPU_L1I_PREFETCHER, CPU_L1I_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_ITLB("cpu0_ITLB", CACHE_CLOCK_SCALE, ITLB_LEVEL, ITLB_SETS, ITLB_WAYS, ITLB_WQ_SIZE, ITLB_RQ_SIZE, ITLB_PQ_SIZE, ITLB_MSHR_SIZE, ITLB_LATENCY - 1, ITLB_FILL_LATENCY, ITLB_MAX_READ, ITLB_MAX_WRITE, LOG2_PAGE_SIZE, ITLB_PREFETCH_AS_LOAD, ITLB_WQ_FULL_ADDRESS, ITLB_VIRTUAL_PREFETCH,
-                  ITLB_PREF_ACTIVATE_MASK, &cpu0_STLB, CPU_ITLB_PREFETCHER, CPU_ITLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_DTLB("cpu0_DTLB", CACHE_CLOCK_SCALE, DTLB_LEVEL, DTLB_SETS, DTLB_WAYS, DTLB_WQ_SIZE, DTLB_RQ_SIZE, DTLB_PQ_SIZE, DTLB_MSHR_SIZE, DTLB_LATENCY - 1, DTLB_FILL_LATENCY, DTLB_MAX_READ, DTLB_MAX_WRITE, LOG2_PAGE_SIZE, DTLB_PREFETCH_AS_LOAD, DTLB_WQ_FULL_ADDRESS, DTLB_VIRTUAL_PREFETCH,
-                  DTLB_PREF_ACTIVATE_MASK, &cpu0_STLB, CPU_DTLB_PREFETCHER, CPU_DTLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  O3_CPU cpu0(CPU_0, O3_CPU_CLOCK_SCALE, CPU_DIB_SET, CPU_DIB_WAY, CPU_DIB_WINDOW, CPU_IFETCH_BUFFER_SIZE, CPU_DECODE_BUFFER_SIZE, CPU_DISPATCH_BUFFER_SIZE, CPU_ROB_SIZE, CPU_LQ_SIZE, CPU_SQ_SIZE, CPU_FETCH_WIDTH, CPU_DECODE_WIDTH, CPU_DISPATCH_WIDTH,
-              CPU_SCHEDULER_SIZE, CPU_EXECUTE_WIDTH, CPU_LQ_WIDTH, CPU_SQ_WIDTH, CPU_RETIRE_WIDTH, CPU_MISPREDICT_PENALTY, CPU_DECODE_LATENCY, CPU_DISPATCH_LATENCY, CPU_SCHEDULE_LATENCY, CPU_EXECUTE_LATENCY, &cpu0_ITLB, &cpu0_DTLB, &cpu0_L1I, &cpu0_L1D,
-              BRANCH_PREDICTOR, BRANCH_TARGET_BUFFER, INSTRUCTION_PREFETCHER);
 
-#if (CPU_USE_MULTIPLE_CORES == ENABLE)
-  CACHE cpu1_L2C("cpu1_L2C", CACHE_CLOCK_SCALE, L2C_LEVEL, L2C_SETS, L2C_WAYS, L2C_WQ_SIZE, L2C_RQ_SIZE, L2C_PQ_SIZE, L2C_MSHR_SIZE, L2C_LATENCY - 1, L2C_FILL_LATENCY, L2C_MAX_READ, L2C_MAX_WRITE, LOG2_BLOCK_SIZE, L2C_PREFETCH_AS_LOAD, L2C_WQ_FULL_ADDRESS, L2C_VIRTUAL_PREFETCH,
-                 L2C_PREF_ACTIVATE_MASK, &LLC, CPU_L2C_PREFETCHER, CPU_L2C_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu1_L1D("cpu1_L1D", CACHE_CLOCK_SCALE, L1D_LEVEL, L1D_SETS, L1D_WAYS, L1D_WQ_SIZE, L1D_RQ_SIZE, L1D_PQ_SIZE, L1D_MSHR_SIZE, L1D_LATENCY - 1, L1D_FILL_LATENCY, L1D_MAX_READ, L1D_MAX_WRITE, LOG2_BLOCK_SIZE, L1D_PREFETCH_AS_LOAD, L1D_WQ_FULL_ADDRESS, L1D_VIRTUAL_PREFETCH,
-                 L1D_PREF_ACTIVATE_MASK, &cpu1_L2C, CPU_L1D_PREFETCHER, CPU_L1D_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  PageTableWalker cpu1_PTW("cpu1_PTW", PTW_CPU, PTW_LEVEL, PTW_PSCL5_SET, PTW_PSCL5_WAY, PTW_PSCL4_SET, PTW_PSCL4_WAY, PTW_PSCL3_SET, PTW_PSCL3_WAY, PTW_PSCL2_SET, PTW_PSCL2_WAY, PTW_RQ_SIZE, PTW_MSHR_SIZE, PTW_MAX_READ, PTW_MAX_WRITE, PTW_LATENCY - 1, &cpu1_L1D, vmem);
-  CACHE cpu1_STLB("cpu1_STLB", CACHE_CLOCK_SCALE, STLB_LEVEL, STLB_SETS, STLB_WAYS, STLB_WQ_SIZE, STLB_RQ_SIZE, STLB_PQ_SIZE, STLB_MSHR_SIZE, STLB_LATENCY - 1, STLB_FILL_LATENCY, STLB_MAX_READ, STLB_MAX_WRITE, LOG2_PAGE_SIZE, STLB_PREFETCH_AS_LOAD, STLB_WQ_FULL_ADDRESS, STLB_VIRTUAL_PREFETCH,
-                  STLB_PREF_ACTIVATE_MASK, &cpu1_PTW, CPU_STLB_PREFETCHER, CPU_STLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu1_L1I("cpu1_L1I", CACHE_CLOCK_SCALE, L1I_LEVEL, L1I_SETS, L1I_WAYS, L1I_WQ_SIZE, L1I_RQ_SIZE, L1I_PQ_SIZE, L1I_MSHR_SIZE, L1I_LATENCY - 1, L1I_FILL_LATENCY, L1I_MAX_READ, L1I_MAX_WRITE, LOG2_BLOCK_SIZE, L1I_PREFETCH_AS_LOAD, L1I_WQ_FULL_ADDRESS, L1I_VIRTUAL_PREFETCH,
-                 L1I_PREF_ACTIVATE_MASK, &cpu1_L2C, CPU_L1I_PREFETCHER, CPU_L1I_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu1_ITLB("cpu1_ITLB", CACHE_CLOCK_SCALE, ITLB_LEVEL, ITLB_SETS, ITLB_WAYS, ITLB_WQ_SIZE, ITLB_RQ_SIZE, ITLB_PQ_SIZE, ITLB_MSHR_SIZE, ITLB_LATENCY - 1, ITLB_FILL_LATENCY, ITLB_MAX_READ, ITLB_MAX_WRITE, LOG2_PAGE_SIZE, ITLB_PREFETCH_AS_LOAD, ITLB_WQ_FULL_ADDRESS, ITLB_VIRTUAL_PREFETCH,
-                  ITLB_PREF_ACTIVATE_MASK, &cpu1_STLB, CPU_ITLB_PREFETCHER, CPU_ITLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu1_DTLB("cpu1_DTLB", CACHE_CLOCK_SCALE, DTLB_LEVEL, DTLB_SETS, DTLB_WAYS, DTLB_WQ_SIZE, DTLB_RQ_SIZE, DTLB_PQ_SIZE, DTLB_MSHR_SIZE, DTLB_LATENCY - 1, DTLB_FILL_LATENCY, DTLB_MAX_READ, DTLB_MAX_WRITE, LOG2_PAGE_SIZE, DTLB_PREFETCH_AS_LOAD, DTLB_WQ_FULL_ADDRESS, DTLB_VIRTUAL_PREFETCH,
-                  DTLB_PREF_ACTIVATE_MASK, &cpu1_STLB, CPU_DTLB_PREFETCHER, CPU_DTLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  O3_CPU cpu1(CPU_1, O3_CPU_CLOCK_SCALE, CPU_DIB_SET, CPU_DIB_WAY, CPU_DIB_WINDOW, CPU_IFETCH_BUFFER_SIZE, CPU_DECODE_BUFFER_SIZE, CPU_DISPATCH_BUFFER_SIZE, CPU_ROB_SIZE, CPU_LQ_SIZE, CPU_SQ_SIZE, CPU_FETCH_WIDTH, CPU_DECODE_WIDTH, CPU_DISPATCH_WIDTH,
-              CPU_SCHEDULER_SIZE, CPU_EXECUTE_WIDTH, CPU_LQ_WIDTH, CPU_SQ_WIDTH, CPU_RETIRE_WIDTH, CPU_MISPREDICT_PENALTY, CPU_DECODE_LATENCY, CPU_DISPATCH_LATENCY, CPU_SCHEDULE_LATENCY, CPU_EXECUTE_LATENCY, &cpu1_ITLB, &cpu1_DTLB, &cpu1_L1I, &cpu1_L1D,
-              BRANCH_PREDICTOR, BRANCH_TARGET_BUFFER, INSTRUCTION_PREFETCHER);
-
-  // put cpu into the cpu array.
-  ooo_cpu.at(0) = &cpu0;
-  ooo_cpu.at(NUM_CPUS - 1) = &cpu1;
-
-  std::array<CACHE*, NUM_CACHES> caches{
-    &LLC,
-      & cpu0_L2C, & cpu0_L1D, & cpu0_STLB, & cpu0_L1I, & cpu0_ITLB, & cpu0_DTLB,
-      & cpu1_L2C, & cpu1_L1D, & cpu1_STLB, & cpu1_L1I, & cpu1_ITLB, & cpu1_DTLB
-  };
-
-  std::array<champsim::operable*, NUM_OPERABLES> operables{
-    &cpu0, & cpu1,
-      & LLC,
-      & cpu0_L2C, & cpu0_L1D, & cpu0_PTW, & cpu0_STLB, & cpu0_L1I, & cpu0_ITLB, & cpu0_DTLB,
-      & cpu1_L2C, & cpu1_L1D, & cpu1_PTW, & cpu1_STLB, & cpu1_L1I, & cpu1_ITLB, & cpu1_DTLB,
-      & memory_controller
-  };
-
-#else
-  // put cpu into the cpu array.
-  ooo_cpu.at(NUM_CPUS - 1) = &cpu0;
-
-  std::array<CACHE*, NUM_CACHES> caches{&LLC, & cpu0_L2C, & cpu0_L1D, & cpu0_STLB, & cpu0_L1I, & cpu0_ITLB, & cpu0_DTLB};
-
-  std::array<champsim::operable*, NUM_OPERABLES> operables{&cpu0, & LLC, & cpu0_L2C, & cpu0_L1D, & cpu0_PTW, & cpu0_STLB, & cpu0_L1I, & cpu0_ITLB, & cpu0_DTLB, & memory_controller};
-#endif  // CPU_USE_MULTIPLE_CORES
+  if (replay_memory_trace_flag)
+  {
+    replay_memory_trace(memory_controller);
+
+    // This a workaround for statistics set only initially lost in the end
+    memory.finish();
+    Stats::statlist.printall();
+    return;
+  }
+
+  CORE_HIERARCHY hierarchy(memory_controller, vmem);
+  std::array<O3_CPU*, NUM_CPUS>& ooo_cpu = hierarchy.ooo_cpu;
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  std::array<PageTableWalker*, NUM_CPUS>& ptws = hierarchy.ptws;
+#endif  // SIMULATION_USE_CHECKPOINT
+  std::vector<CACHE*>& caches = hierarchy.caches;
+#if (SIMULATION_USE_PARALLEL_CORES == DISABLE)
+  std::vector<champsim::operable*>& operables = hierarchy.operables;
+#endif  // SIMULATION_USE_PARALLEL_CORES
 
   // Output configuration details
   print_configuration_details(vmem);
@@ -1810,6 +2244,25 @@ void simulation_run(const Config& configs, Memory<T, Controller>& memory)
     (*it)->impl_replacement_initialize();
   }
 
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+  if (load_checkpoint_file.empty() == false)
+  {
+    CHECKPOINT checkpoint(load_checkpoint_file, CHECKPOINT::Mode::Restore);
+    transfer_simulation_state(checkpoint, vmem, ooo_cpu, ptws, caches, memory_controller);
+
+    // the simulation resumes at the end of the saved warmup, so the instructions retired before it are skipped
+    // and finish_warmup() is called in the first cycle.
+    for (std::size_t i = 0; i < ooo_cpu.size(); ++i)
+    {
+      traces[i]->skip_instructions(ooo_cpu[i]->num_retired);
+      warmup_complete[i] = 1;
+    }
+    all_warmup_complete = NUM_CPUS;
+
+    std::cout << "Simulation state is restored from " << load_checkpoint_file << "." << std::endl;
+  }
+#endif  // SIMULATION_USE_CHECKPOINT
+
   // simulation entry point
   while (std::any_of(std::begin(simulation_complete), std::end(simulation_complete), std::logical_not<uint8_t>()))
   {
@@ -1817,6 +2270,15 @@ void simulation_run(const Config& configs, Memory<T, Controller>& memory)
     elapsed_minute -= elapsed_hour * 60;
     elapsed_second -= (elapsed_hour * 3600 + elapsed_minute * 60);
 
+#if (SIMULATION_USE_PARALLEL_CORES == ENABLE)
+    // the cores run a quantum in parallel and read their traces, then the LLC and the memory controller catch up.
+    // so the checks below (e.g., the end of warmup) are done once per quantum.
+    run_parallel_quantum(hierarchy);
+#else
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+    skip_idle_cycles(operables);
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
     for (auto op : operables)
     {
       try
@@ -1837,16 +2299,23 @@ void simulation_run(const Config& configs, Memory<T, Controller>& memory)
         abort();
       }
     }
+#endif  // SIMULATION_USE_PARALLEL_CORES
     // we don't need to sort here since the clock difference of cpu and memory is expressed in the memory controller.
     //std::sort(std::begin(operables), std::end(operables), champsim::by_next_operate());
 
     for (std::size_t i = 0; i < ooo_cpu.size(); ++i)
     {
+#if (SIMULATION_USE_PARALLEL_CORES == DISABLE)
       // read from trace
       while (ooo_cpu[i]->fetch_stall == 0 && ooo_cpu[i]->instrs_to_read_this_cycle > 0)
       {
+#if (USER_CODES == ENABLE)
+        ooo_cpu[i]->init_instructions(traces[i]->get_batch());
+#else
         ooo_cpu[i]->init_instruction(traces[i]->get());
+#endif // USER_CODES
       }
+#endif  // SIMULATION_USE_PARALLEL_CORES
 
       // heartbeat information
       if (show_heartbeat && (ooo_cpu[i]->num_retired >= ooo_cpu[i]->next_print_instruction))
@@ -1889,6 +2358,15 @@ void simulation_run(const Config& configs, Memory<T, Controller>& memory)
         // when all cores are warmed up
         all_warmup_complete++;
         finish_warmup(ooo_cpu, caches);
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+        if (save_checkpoint_file.empty() == false)
+        {
+          CHECKPOINT checkpoint(save_checkpoint_file, CHECKPOINT::Mode::Save);
+          transfer_simulation_state(checkpoint, vmem, ooo_cpu, ptws, caches, memory_controller);
+          std::cout << "Simulation state is saved into " << save_checkpoint_file << "." << std::endl;
+        }
+#endif  // SIMULATION_USE_CHECKPOINT
       }
 
       // simulation complete
@@ -1915,6 +2393,10 @@ void simulation_run(const Config& configs, Memory<T, Controller>& memory)
     }
   }
 
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+  std::cout << "Clock skipping: " << skipped_cycles << " idle cycles are skipped." << std::endl;
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
   // This a workaround for statistics set only initially lost in the end
   memory.finish();
   Stats::statlist.printall();
@@ -1988,71 +2470,11 @@ void simulation_run()
 {
   VirtualMemory vmem(MEMORY_CAPACITY, PAGE_SIZE, PAGE_TABLE_LEVELS, 1, MINOR_FAULT_PENALTY);
 
-  std::array<O3_CPU*, NUM_CPUS> ooo_cpu{};
   MEMORY_CONTROLLER memory_controller(MEMORY_CONTROLLER_CLOCK_SCALE);
-  CACHE LLC("LLC", CACHE_CLOCK_SCALE, LLC_LEVEL, LLC_SETS, LLC_WAYS, LLC_WQ_SIZE, LLC_RQ_SIZE, LLC_PQ_SIZE, LLC_MSHR_SIZE, LLC_LATENCY - 1, LLC_FILL_LATENCY, LLC_MAX_READ, LLC_MAX_WRITE, LOG2_BLOCK_SIZE, LLC_PREFETCH_AS_LOAD, LLC_WQ_FULL_ADDRESS, LLC_VIRTUAL_PREFETCH,
-            LLC_PREF_ACTIVATE_MASK, &memory_controller, LLC_PREFETCHER, LLC_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_L2C("cpu0_L2C", CACHE_CLOCK_SCALE, L2C_LEVEL, L2C_SETS, L2C_WAYS, L2C_WQ_SIZE, L2C_RQ_SIZE, L2C_PQ_SIZE, L2C_MSHR_SIZE, L2C_LATENCY - 1, L2C_FILL_LATENCY, L2C_MAX_READ, L2C_MAX_WRITE, LOG2_BLOCK_SIZE, L2C_PREFETCH_AS_LOAD, L2C_WQ_FULL_ADDRESS, L2C_VIRTUAL_PREFETCH,
-                 L2C_PREF_ACTIVATE_MASK, &LLC, CPU_L2C_PREFETCHER, CPU_L2C_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_L1D("cpu0_L1D", CACHE_CLOCK_SCALE, L1D_LEVEL, L1D_SETS, L1D_WAYS, L1D_WQ_SIZE, L1D_RQ_SIZE, L1D_PQ_SIZE, L1D_MSHR_SIZE, L1D_LATENCY - 1, L1D_FILL_LATENCY, L1D_MAX_READ, L1D_MAX_WRITE, LOG2_BLOCK_SIZE, L1D_PREFETCH_AS_LOAD, L1D_WQ_FULL_ADDRESS, L1D_VIRTUAL_PREFETCH,
-                 L1D_PREF_ACTIVATE_MASK, &cpu0_L2C, CPU_L1D_PREFETCHER, CPU_L1D_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  PageTableWalker cpu0_PTW("cpu0_PTW", PTW_CPU, PTW_LEVEL, PTW_PSCL5_SET, PTW_PSCL5_WAY, PTW_PSCL4_SET, PTW_PSCL4_WAY, PTW_PSCL3_SET, PTW_PSCL3_WAY, PTW_PSCL2_SET, PTW_PSCL2_WAY, PTW_RQ_SIZE, PTW_MSHR_SIZE, PTW_MAX_READ, PTW_MAX_WRITE, PTW_LATENCY - 1, &cpu0_L1D, vmem);
-  CACHE cpu0_STLB("cpu0_STLB", CACHE_CLOCK_SCALE, STLB_LEVEL, STLB_SETS, STLB_WAYS, STLB_WQ_SIZE, STLB_RQ_SIZE, STLB_PQ_SIZE, STLB_MSHR_SIZE, STLB_LATENCY - 1, STLB_FILL_LATENCY, STLB_MAX_READ, STLB_MAX_WRITE, LOG2_PAGE_SIZE, STLB_PREFETCH_AS_LOAD, STLB_WQ_FULL_ADDRESS, STLB_VIRTUAL_PREFETCH,
-                  STLB_PREF_ACTIVATE_MASK, &cpu0_PTW, CPU_STLB_PREFETCHER, CPU_STLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_L1I("cpu0_L1I", CACHE_CLOCK_SCALE, L1I_LEVEL, L1I_SETS, L1I_WAYS, L1I_WQ_SIZE, L1I_RQ_SIZE, L1I_PQ_SIZE, L1I_MSHR_SIZE, L1I_LATENCY - 1, L1I_FILL_LATENCY, L1I_MAX_READ, L1I_MAX_WRITE, LOG2_BLOCK_SIZE, L1I_PREFETCH_AS_LOAD, L1I_WQ_FULL_ADDRESS, L1I_VIRTUAL_PREFETCH,
-                 L1I_PREF_ACTIVATE_MASK, &cpu0_L2C, CPU_L1I_PREFETCHER, CPU_L1I_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_ITLB("cpu0_ITLB", CACHE_CLOCK_SCALE, ITLB_LEVEL, ITLB_SETS, ITLB_WAYS, ITLB_WQ_SIZE, ITLB_RQ_SIZE, ITLB_PQ_SIZE, ITLB_MSHR_SIZE, ITLB_LATENCY - 1, ITLB_FILL_LATENCY, ITLB_MAX_READ, ITLB_MAX_WRITE, LOG2_PAGE_SIZE, ITLB_PREFETCH_AS_LOAD, ITLB_WQ_FULL_ADDRESS, ITLB_VIRTUAL_PREFETCH,
-                  ITLB_PREF_ACTIVATE_MASK, &cpu0_STLB, CPU_ITLB_PREFETCHER, CPU_ITLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu0_DTLB("cpu0_DTLB", CACHE_CLOCK_SCALE, DTLB_LEVEL, DTLB_SETS, DTLB_WAYS, DTLB_WQ_SIZE, DTLB_RQ_SIZE, DTLB_PQ_SIZE, DTLB_MSHR_SIZE, DTLB_LATENCY - 1, DTLB_FILL_LATENCY, DTLB_MAX_READ, DTLB_MAX_WRITE, LOG2_PAGE_SIZE, DTLB_PREFETCH_AS_LOAD, DTLB_WQ_FULL_ADDRESS, DTLB_VIRTUAL_PREFETCH,
-                  DTLB_PREF_ACTIVATE_MASK, &cpu0_STLB, CPU_DTLB_PREFETCHER, CPU_DTLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  O3_CPU cpu0(CPU_0, O3_CPU_CLOCK_SCALE, CPU_DIB_SET, CPU_DIB_WAY, CPU_DIB_WINDOW, CPU_IFETCH_BUFFER_SIZE, CPU_DECODE_BUFFER_SIZE, CPU_DISPATCH_BUFFER_SIZE, CPU_ROB_SIZE, CPU_LQ_SIZE, CPU_SQ_SIZE, CPU_FETCH_WIDTH, CPU_DECODE_WIDTH, CPU_DISPATCH_WIDTH,
-              CPU_SCHEDULER_SIZE, CPU_EXECUTE_WIDTH, CPU_LQ_WIDTH, CPU_SQ_WIDTH, CPU_RETIRE_WIDTH, CPU_MISPREDICT_PENALTY, CPU_DECODE_LATENCY, CPU_DISPATCH_LATENCY, CPU_SCHEDULE_LATENCY, CPU_EXECUTE_LATENCY, &cpu0_ITLB, &cpu0_DTLB, &cpu0_L1I, &cpu0_L1D,
-              BRANCH_PREDICTOR, BRANCH_TARGET_BUFFER, INSTRUCTION_PREFETCHER);
-
-#if (CPU_USE_MULTIPLE_CORES == ENABLE)
-  CACHE cpu1_L2C("cpu1_L2C", CACHE_CLOCK_SCALE, L2C_LEVEL, L2C_SETS, L2C_WAYS, L2C_WQ_SIZE, L2C_RQ_SIZE, L2C_PQ_SIZE, L2C_MSHR_SIZE, L2C_LATENCY - 1, L2C_FILL_LATENCY, L2C_MAX_READ, L2C_MAX_WRITE, LOG2_BLOCK_SIZE, L2C_PREFETCH_AS_LOAD, L2C_WQ_FULL_ADDRESS, L2C_VIRTUAL_PREFETCH,
-                 L2C_PREF_ACTIVATE_MASK, &LLC, CPU_L2C_PREFETCHER, CPU_L2C_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu1_L1D("cpu1_L1D", CACHE_CLOCK_SCALE, L1D_LEVEL, L1D_SETS, L1D_WAYS, L1D_WQ_SIZE, L1D_RQ_SIZE, L1D_PQ_SIZE, L1D_MSHR_SIZE, L1D_LATENCY - 1, L1D_FILL_LATENCY, L1D_MAX_READ, L1D_MAX_WRITE, LOG2_BLOCK_SIZE, L1D_PREFETCH_AS_LOAD, L1D_WQ_FULL_ADDRESS, L1D_VIRTUAL_PREFETCH,
-                 L1D_PREF_ACTIVATE_MASK, &cpu1_L2C, CPU_L1D_PREFETCHER, CPU_L1D_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  PageTableWalker cpu1_PTW("cpu1_PTW", PTW_CPU, PTW_LEVEL, PTW_PSCL5_SET, PTW_PSCL5_WAY, PTW_PSCL4_SET, PTW_PSCL4_WAY, PTW_PSCL3_SET, PTW_PSCL3_WAY, PTW_PSCL2_SET, PTW_PSCL2_WAY, PTW_RQ_SIZE, PTW_MSHR_SIZE, PTW_MAX_READ, PTW_MAX_WRITE, PTW_LATENCY - 1, &cpu1_L1D, vmem);
-  CACHE cpu1_STLB("cpu1_STLB", CACHE_CLOCK_SCALE, STLB_LEVEL, STLB_SETS, STLB_WAYS, STLB_WQ_SIZE, STLB_RQ_SIZE, STLB_PQ_SIZE, STLB_MSHR_SIZE, STLB_LATENCY - 1, STLB_FILL_LATENCY, STLB_MAX_READ, STLB_MAX_WRITE, LOG2_PAGE_SIZE, STLB_PREFETCH_AS_LOAD, STLB_WQ_FULL_ADDRESS, STLB_VIRTUAL_PREFETCH,
-                  STLB_PREF_ACTIVATE_MASK, &cpu1_PTW, CPU_STLB_PREFETCHER, CPU_STLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu1_L1I("cpu1_L1I", CACHE_CLOCK_SCALE, L1I_LEVEL, L1I_SETS, L1I_WAYS, L1I_WQ_SIZE, L1I_RQ_SIZE, L1I_PQ_SIZE, L1I_MSHR_SIZE, L1I_LATENCY - 1, L1I_FILL_LATENCY, L1I_MAX_READ, L1I_MAX_WRITE, LOG2_BLOCK_SIZE, L1I_PREFETCH_AS_LOAD, L1I_WQ_FULL_ADDRESS, L1I_VIRTUAL_PREFETCH,
-                 L1I_PREF_ACTIVATE_MASK, &cpu1_L2C, CPU_L1I_PREFETCHER, CPU_L1I_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu1_ITLB("cpu1_ITLB", CACHE_CLOCK_SCALE, ITLB_LEVEL, ITLB_SETS, ITLB_WAYS, ITLB_WQ_SIZE, ITLB_RQ_SIZE, ITLB_PQ_SIZE, ITLB_MSHR_SIZE, ITLB_LATENCY - 1, ITLB_FILL_LATENCY, ITLB_MAX_READ, ITLB_MAX_WRITE, LOG2_PAGE_SIZE, ITLB_PREFETCH_AS_LOAD, ITLB_WQ_FULL_ADDRESS, ITLB_VIRTUAL_PREFETCH,
-                  ITLB_PREF_ACTIVATE_MASK, &cpu1_STLB, CPU_ITLB_PREFETCHER, CPU_ITLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  CACHE cpu1_DTLB("cpu1_DTLB", CACHE_CLOCK_SCALE, DTLB_LEVEL, DTLB_SETS, DTLB_WAYS, DTLB_WQ_SIZE, DTLB_RQ_SIZE, DTLB_PQ_SIZE, DTLB_MSHR_SIZE, DTLB_LATENCY - 1, DTLB_FILL_LATENCY, DTLB_MAX_READ, DTLB_MAX_WRITE, LOG2_PAGE_SIZE, DTLB_PREFETCH_AS_LOAD, DTLB_WQ_FULL_ADDRESS, DTLB_VIRTUAL_PREFETCH,
-                  DTLB_PREF_ACTIVATE_MASK, &cpu1_STLB, CPU_DTLB_PREFETCHER, CPU_DTLB_REPLACEMENT_POLICY, ooo_cpu, vmem);
-  O3_CPU cpu1(CPU_1, O3_CPU_CLOCK_SCALE, CPU_DIB_SET, CPU_DIB_WAY, CPU_DIB_WINDOW, CPU_IFETCH_BUFFER_SIZE, CPU_DECODE_BUFFER_SIZE, CPU_DISPATCH_BUFFER_SIZE, CPU_ROB_SIZE, CPU_LQ_SIZE, CPU_SQ_SIZE, CPU_FETCH_WIDTH, CPU_DECODE_WIDTH, CPU_DISPATCH_WIDTH,
-              CPU_SCHEDULER_SIZE, CPU_EXECUTE_WIDTH, CPU_LQ_WIDTH, CPU_SQ_WIDTH, CPU_RETIRE_WIDTH, CPU_MISPREDICT_PENALTY, CPU_DECODE_LATENCY, CPU_DISPATCH_LATENCY, CPU_SCHEDULE_LATENCY, CPU_EXECUTE_LATENCY, &cpu1_ITLB, &cpu1_DTLB, &cpu1_L1I, &cpu1_L1D,
-              BRANCH_PREDICTOR, BRANCH_TARGET_BUFFER, INSTRUCTION_PREFETCHER);
-
-  // put cpu into the cpu array.
-  ooo_cpu.at(0) = &cpu0;
-  ooo_cpu.at(NUM_CPUS - 1) = &cpu1;
-
-  std::array<CACHE*, NUM_CACHES> caches{
-    &LLC,
-      & cpu0_L2C, & cpu0_L1D, & cpu0_STLB, & cpu0_L1I, & cpu0_ITLB, & cpu0_DTLB,
-      & cpu1_L2C, & cpu1_L1D, & cpu1_STLB, & cpu1_L1I, & cpu1_ITLB, & cpu1_DTLB
-  };
-
-  std::array<champsim::operable*, NUM_OPERABLES> operables{
-    &cpu0, & cpu1,
-      & LLC,
-      & cpu0_L2C, & cpu0_L1D, & cpu0_PTW, & cpu0_STLB, & cpu0_L1I, & cpu0_ITLB, & cpu0_DTLB,
-      & cpu1_L2C, & cpu1_L1D, & cpu1_PTW, & cpu1_STLB, & cpu1_L1I, & cpu1_ITLB, & cpu1_DTLB,
-      & memory_controller
-  };
-
-#else
-  // put cpu into the cpu array.
-  ooo_cpu.at(NUM_CPUS - 1) = &cpu0;
-
-  std::array<CACHE*, NUM_CACHES> caches{&LLC, & cpu0_L2C, & cpu0_L1D, & cpu0_STLB, & cpu0_L1I, & cpu0_ITLB, & cpu0_DTLB};
-
-  std::array<champsim::operable*, NUM_OPERABLES> operables{&cpu0, & LLC, & cpu0_L2C, & cpu0_L1D, & cpu0_PTW, & cpu0_STLB, & cpu0_L1I, & cpu0_ITLB, & cpu0_DTLB, & memory_controller};
-#endif  // CPU_USE_MULTIPLE_CORES
+  CORE_HIERARCHY hierarchy(memory_controller, vmem);
+  std::array<O3_CPU*, NUM_CPUS>& ooo_cpu = hierarchy.ooo_cpu;
+  std::vector<CACHE*>& caches = hierarchy.caches;
+  std::vector<champsim::operable*>& operables = hierarchy.operables;
 
   // Output configuration details
   print_configuration_details(vmem);
@@ -2103,7 +2525,11 @@ void simulation_run()
       // read from trace
       while (ooo_cpu[i]->fetch_stall == 0 && ooo_cpu[i]->instrs_to_read_this_cycle > 0)
       {
+#if (USER_CODES == ENABLE)
+        ooo_cpu[i]->init_instructions(traces[i]->get_batch());
+#else
         ooo_cpu[i]->init_instruction(traces[i]->get());
+#endif // USER_CODES
       }
 
       // heartbeat information
@@ -0,0 +1,163 @@
+#include "memory_trace_replay.h"
+
+#include <cassert>
+#include <iostream>
+
+#include "champsim_constants.h"
+
+#if (RAMULATOR == ENABLE)
+MEMORY_TRACE_REPLAY::MEMORY_TRACE_REPLAY(MemoryRequestConsumer* memory_controller, const std::string& trace_name, uint32_t window)
+    : MemoryRequestProducer(memory_controller), window(window), trace_name(trace_name)
+{
+    trace_file = fopen(trace_name.c_str(), "r");
+    if (trace_file == NULL)
+    {
+        std::cout << __func__ << ": Cannot open the memory trace " << trace_name << "." << std::endl;
+        abort();
+    }
+
+    read_record();
+    first_cycle = record.cycle;
+};
+
+MEMORY_TRACE_REPLAY::~MEMORY_TRACE_REPLAY()
+{
+    fclose(trace_file);
+};
+
+bool MEMORY_TRACE_REPLAY::warmup()
+{
+    if (has_record == false)
+    {
+        return false;
+    }
+
+    // the memory controller takes all requests during warmup and returns the reads at once
+    int result = send_record(0);
+    assert(result != int(MemoryRequestConsumer::ReturnValue::Full));
+    read_record();
+
+    return true;
+};
+
+void MEMORY_TRACE_REPLAY::finish_warmup()
+{
+    if (has_record)
+    {
+        first_cycle = record.cycle;
+    }
+    read_number = write_number = read_latency_sum = 0;
+};
+
+void MEMORY_TRACE_REPLAY::operate(uint64_t cycle, uint64_t request_number)
+{
+    if (started == false)
+    {
+        start_cycle = cycle;
+        started = true;
+    }
+    current_cycle = cycle;
+
+    while (has_record && (read_number + write_number < request_number))
+    {
+        if (window == 0)
+        {
+            // open loop, the request waits for its recorded cycle
+            if (record.cycle > first_cycle + (cycle - start_cycle))
+            {
+                break;
+            }
+        }
+        else if ((record.is_write == false) && (inflight_read_number >= window))
+        {
+            // closed loop, the request waits for a read in flight
+            break;
+        }
+
+        if (send_record(cycle) == int(MemoryRequestConsumer::ReturnValue::Full))
+        {
+            break;  // try again in the next cycle, the requests keep their order
+        }
+        read_record();
+    }
+};
+
+void MEMORY_TRACE_REPLAY::return_data(PACKET* packet)
+{
+    assert(inflight_read_number > 0);
+    inflight_read_number--;
+
+    read_latency_sum += current_cycle - packet->cycle_enqueued;
+};
+
+void MEMORY_TRACE_REPLAY::read_record()
+{
+    char line[256];
+    while (fgets(line, sizeof(line), trace_file) != NULL)
+    {
+        char type;
+        unsigned long address, cycle = 0;
+        int field_number = sscanf(line, "%lx %c %lu", &address, &type, &cycle);
+
+        if (field_number < 2 || (type != 'R' && type != 'W'))
+        {
+            continue;   // the requests of the swapping unit and broken lines
+        }
+
+        if (field_number < 3 && window == 0)
+        {
+            std::cout << __func__ << ": The memory trace " << trace_name << " has no cycles, replay it with a window (closed loop)." << std::endl;
+            abort();
+        }
+
+        record.address = address;
+        record.cycle = cycle;
+        record.is_write = (type == 'W');
+        has_record = true;
+        return;
+    }
+
+    has_record = false;
+};
+
+int MEMORY_TRACE_REPLAY::send_record(uint64_t cycle)
+{
+    PACKET packet;
+    packet.address = record.address;
+    packet.cpu = 0;
+    packet.cycle_enqueued = cycle;
+
+    int result;
+    if (record.is_write)
+    {
+        packet.type = WRITEBACK;
+        result = lower_level->add_wq(&packet);
+        if (result != int(MemoryRequestConsumer::ReturnValue::Full))
+        {
+            write_number++;
+        }
+    }
+    else
+    {
+        packet.type = LOAD;
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE) && (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+        packet.type_origin = LOAD;
+#endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT, TRACKING_LOAD_STORE_STATISTICS
+        packet.to_return = {this};
+
+        // a read forwarded by the memory controller returns inside add_rq()
+        inflight_read_number++;
+        result = lower_level->add_rq(&packet);
+        if (result == int(MemoryRequestConsumer::ReturnValue::Full))
+        {
+            inflight_read_number--;
+        }
+        else
+        {
+            read_number++;
+        }
+    }
+
+    return result;
+};
+#endif  // RAMULATOR
@@ -1,89 +1,94 @@
 #include "os_transparent_management.h"
 
-#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
+/* Includes for research */
+#include "cameo.h"
+#include "variable_granularity.h"
+#include "ideal_single_mempod.h"
 
-#if (NO_METHOD_FOR_RUN_HYBRID_MEMORY == ENABLE)
+#if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 
-OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address)
-    : total_capacity(max_address), fast_memory_capacity(fast_memory_max_address),
-    fast_memory_capacity_at_data_block_granularity(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS),
-    fast_memory_offset_bit(lg2(fast_memory_max_address)),   // note here only support integers of 2's power.
-    counter_table(*(new std::vector<COUNTER_WIDTH>(max_address >> DATA_MANAGEMENT_OFFSET_BITS, COUNTER_DEFAULT_VALUE))),
-    hotness_table(*(new std::vector<HOTNESS_WIDTH>(max_address >> DATA_MANAGEMENT_OFFSET_BITS, HOTNESS_DEFAULT_VALUE)))
+/* Registered designs */
+struct ManagementPolicyEntry
 {
-    hotness_threshold = HOTNESS_THRESHOLD;
+    const char* name;
+    ManagementPolicy policy;
 };
 
-OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
+static const ManagementPolicyEntry management_policy_registry[] =
 {
-    output_statistics.remapping_request_queue_congestion = remapping_request_queue_congestion;
-    delete& counter_table;
-    delete& hotness_table;
+#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
+    {"cameo", ManagementPolicy::Cameo},
+#endif  // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE
+#if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
+    {"variable_granularity", ManagementPolicy::VariableGranularity},
+#endif  // IDEAL_VARIABLE_GRANULARITY
+#if (IDEAL_SINGLE_MEMPOD == ENABLE)
+    {"mempod", ManagementPolicy::MemPod},
+#endif  // IDEAL_SINGLE_MEMPOD
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree)
+ManagementPolicy management_policy = management_policy_registry[0].policy;
+
+bool find_management_policy(const std::string& name, ManagementPolicy& policy)
 {
-    if (address >= total_capacity)
+    for (const ManagementPolicyEntry& entry : management_policy_registry)
     {
-        std::cout << __func__ << ": address input error." << std::endl;
-        return false;
+        if (name == entry.name)
+        {
+            policy = entry.policy;
+            return true;
+        }
     }
 
-    return true;
-};
-
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(PACKET& packet)
-{
-
+    return false;
 };
 
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
+const char* get_management_policy_name(ManagementPolicy policy)
 {
+    for (const ManagementPolicyEntry& entry : management_policy_registry)
+    {
+        if (policy == entry.policy)
+        {
+            return entry.name;
+        }
+    }
 
+    return "unknown";
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request)
+void print_management_policies()
 {
-    if (remapping_request_queue.empty() == false)
+    std::cout << "Registered memory management policies:";
+    for (const ManagementPolicyEntry& entry : management_policy_registry)
     {
-        remapping_request = remapping_request_queue.front();
-        return true;
+        std::cout << " " << entry.name;
     }
-
-    return false;
+    std::cout << " (default: " << management_policy_registry[0].name << ")." << std::endl;
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
+OS_TRANSPARENT_MANAGEMENT* create_os_transparent_management(ManagementPolicy policy, uint64_t max_address, uint64_t fast_memory_max_address)
 {
-    if (remapping_request_queue.empty() == false)
-    {
-        RemappingRequest remapping_request = remapping_request_queue.front();
-        remapping_request_queue.pop_front();
-    }
-    else
+    switch (policy)
     {
-        std::cout << __func__ << ": remapping error." << std::endl;
-        assert(0);
-        return false;   // error
+#if (IDEAL_LINE_LOCATION_TABLE == ENABLE) || (COLOCATED_LINE_LOCATION_TABLE == ENABLE)
+    case ManagementPolicy::Cameo:
+        return new CAMEO(max_address, fast_memory_max_address);
+#endif  // IDEAL_LINE_LOCATION_TABLE, COLOCATED_LINE_LOCATION_TABLE
+#if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
+    case ManagementPolicy::VariableGranularity:
+        return new VARIABLE_GRANULARITY(max_address, fast_memory_max_address);
+#endif  // IDEAL_VARIABLE_GRANULARITY
+#if (IDEAL_SINGLE_MEMPOD == ENABLE)
+    case ManagementPolicy::MemPod:
+        return new MEMPOD(max_address, fast_memory_max_address);
+#endif  // IDEAL_SINGLE_MEMPOD
+    default:
+        break;
     }
 
-    return true;
+    std::cout << __func__ << ": memory management policy " << unsigned(policy) << " is not compiled in." << std::endl;
+    abort();
+    return nullptr;
 };
 
-void OS_TRANSPARENT_MANAGEMENT::cold_data_detection()
-{
-    cycle++;
-}
-
-bool OS_TRANSPARENT_MANAGEMENT::cold_data_eviction(uint64_t source_address, float queue_busy_degree)
-{
-    return false;
-}
-
-bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& remapping_request)
-{
-    return false;
-}
-
-#endif  // NO_METHOD_FOR_RUN_HYBRID_MEMORY
 #endif  // MEMORY_USE_OS_TRANSPARENT_MANAGEMENT
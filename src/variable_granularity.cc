@@ -1,20 +1,24 @@
-#include "os_transparent_management.h"
+#include "variable_granularity.h"
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+#include "checkpoint.h"
+#endif  // SIMULATION_USE_CHECKPOINT
 
 #if (MEMORY_USE_OS_TRANSPARENT_MANAGEMENT == ENABLE)
 
 #if (IDEAL_VARIABLE_GRANULARITY == ENABLE)
-OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint64_t fast_memory_max_address)
-    : total_capacity(max_address), fast_memory_capacity(fast_memory_max_address),
-    total_capacity_at_data_block_granularity(max_address >> DATA_MANAGEMENT_OFFSET_BITS),
-    fast_memory_capacity_at_data_block_granularity(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS),
+VARIABLE_GRANULARITY::VARIABLE_GRANULARITY(uint64_t max_address, uint64_t fast_memory_max_address)
+    : OS_TRANSPARENT_MANAGEMENT(ManagementPolicy::VariableGranularity), total_capacity(max_address), fast_memory_capacity(fast_memory_max_address),
+    total_capacity_at_data_block_granularity(max_address >> VG_DATA_MANAGEMENT_OFFSET_BITS),
+    fast_memory_capacity_at_data_block_granularity(fast_memory_max_address >> VG_DATA_MANAGEMENT_OFFSET_BITS),
     fast_memory_offset_bit(lg2(fast_memory_max_address)),   // note here only support integers of 2's power.
-    counter_table(*(new std::vector<COUNTER_WIDTH>(max_address >> DATA_MANAGEMENT_OFFSET_BITS, COUNTER_DEFAULT_VALUE))),
-    hotness_table(*(new std::vector<HOTNESS_WIDTH>(max_address >> DATA_MANAGEMENT_OFFSET_BITS, HOTNESS_DEFAULT_VALUE))),
-    set_msb(REMAPPING_LOCATION_WIDTH_BITS + fast_memory_offset_bit - 1),
-    access_table(*(new std::vector<AccessDistribution>(max_address >> DATA_MANAGEMENT_OFFSET_BITS))),
-    placement_table(*(new std::vector<PlacementEntry>(fast_memory_max_address >> DATA_MANAGEMENT_OFFSET_BITS)))
+    counter_table(*(new std::vector<COUNTER_WIDTH>(max_address >> VG_DATA_MANAGEMENT_OFFSET_BITS, COUNTER_DEFAULT_VALUE))),
+    hotness_table(*(new std::vector<HOTNESS_WIDTH>(max_address >> VG_DATA_MANAGEMENT_OFFSET_BITS, HOTNESS_DEFAULT_VALUE))),
+    epoch_table(*(new std::vector<uint32_t>(max_address >> VG_DATA_MANAGEMENT_OFFSET_BITS, 0))),
+    set_msb(VG_REMAPPING_LOCATION_WIDTH_BITS + fast_memory_offset_bit - 1),
+    access_table(*(new std::vector<AccessDistribution>(max_address >> VG_DATA_MANAGEMENT_OFFSET_BITS))),
+    placement_table(*(new std::vector<PlacementEntry>(fast_memory_max_address >> VG_DATA_MANAGEMENT_OFFSET_BITS)))
 {
-    hotness_threshold = HOTNESS_THRESHOLD;
+    hotness_threshold = VG_HOTNESS_THRESHOLD;
     remapping_request_queue_congestion = 0;
 
     expected_number_in_congruence_group = total_capacity / fast_memory_capacity;
@@ -22,7 +26,7 @@ OS_TRANSPARENT_MANAGEMENT::OS_TRANSPARENT_MANAGEMENT(uint64_t max_address, uint6
 
 };
 
-OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
+VARIABLE_GRANULARITY::~VARIABLE_GRANULARITY()
 {
     output_statistics.remapping_request_queue_congestion = remapping_request_queue_congestion;
 
@@ -33,7 +37,7 @@ OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
     uint64_t granularity_total_counts = 0;
     uint64_t granularity_predict_counts[MIGRATION_GRANULARITY_WIDTH(MigrationGranularity::Max)] = {0};
     uint64_t granularity_total_predict_counts = 0;
-    uint64_t access_table_size = total_capacity >> DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t access_table_size = total_capacity >> VG_DATA_MANAGEMENT_OFFSET_BITS;
 
     for (uint64_t i = 0; i < access_table_size; i++)
     {
@@ -102,11 +106,16 @@ OS_TRANSPARENT_MANAGEMENT::~OS_TRANSPARENT_MANAGEMENT()
 
     delete& counter_table;
     delete& hotness_table;
+    delete& epoch_table;
     delete& access_table;
     delete& placement_table;
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree)
+#if (TRACKING_LOAD_STORE_STATISTICS == ENABLE)
+bool VARIABLE_GRANULARITY::memory_activity_tracking(uint64_t address, uint8_t type, uint8_t type_origin, float queue_busy_degree)
+#else
+bool VARIABLE_GRANULARITY::memory_activity_tracking(uint64_t address, uint8_t type, float queue_busy_degree)
+#endif // TRACKING_LOAD_STORE_STATISTICS
 {
     if (address >= total_capacity)
     {
@@ -114,13 +123,15 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
         return false;
     }
 
-    uint64_t data_block_address = address >> DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
+    uint64_t data_block_address = address >> VG_DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
     uint64_t placement_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;   // calculate the index in placement table
-    uint64_t base_remapping_address = placement_table_index << DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t base_remapping_address = placement_table_index << VG_DATA_MANAGEMENT_OFFSET_BITS;
     REMAPPING_LOCATION_WIDTH tag = static_cast<REMAPPING_LOCATION_WIDTH>(data_block_address / fast_memory_capacity_at_data_block_granularity); // calculate the tag of the data block address
-    uint64_t first_address = data_block_address << DATA_MANAGEMENT_OFFSET_BITS; // the first address in the page granularity of this address
+    uint64_t first_address = data_block_address << VG_DATA_MANAGEMENT_OFFSET_BITS; // the first address in the page granularity of this address
     START_ADDRESS_WIDTH data_line_positon = START_ADDRESS_WIDTH((address >> DATA_LINE_OFFSET_BITS) - (first_address >> DATA_LINE_OFFSET_BITS));
 
+    apply_pending_decay(data_block_address);
+
     // mark accessed data line
     access_table.at(data_block_address).access[data_line_positon] = true;
 
@@ -128,6 +139,11 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
     access_table.at(data_block_address).access_flag = true;
     access_table.at(data_block_address).access_stats[data_line_positon] = true;
     access_table.at(data_block_address).temporal_access_stats[data_line_positon] = true;
+    if (access_table.at(data_block_address).temporal_access_flag == false)
+    {
+        access_table.at(data_block_address).temporal_access_flag = true;
+        temporal_accessed_blocks.push_back(data_block_address);
+    }
 #endif  // STATISTICS_INFORMATION
 
 #if (COLD_DATA_DETECTION_IN_GROUP == ENABLE)
@@ -278,11 +294,17 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
                     }
 
                     // this existing group can not be expanded because no invalid groups behind it (i.e., no continuous free space).
-                    output_statistics.unexpandable_since_no_invalid_group++;
+                    if (all_warmup_complete > NUM_CPUS)
+                    {
+                        output_statistics.unexpandable_since_no_invalid_group++;
+                    }
 #else
                     // this existing group can not be expanded because no invalid groups behind it (i.e., no continuous free space).
                     cold_data_eviction(address, queue_busy_degree);
-                    output_statistics.unexpandable_since_no_invalid_group++;
+                    if (all_warmup_complete > NUM_CPUS)
+                    {
+                        output_statistics.unexpandable_since_no_invalid_group++;
+                    }
                     return true;
 #endif  // FLEXIBLE_DATA_PLACEMENT
 
@@ -302,7 +324,10 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
                         break;
 #else
                         // this existing group can not be expanded because the new start_address is smaller than the existing group's start_address
-                        output_statistics.unexpandable_since_start_address++;
+                        if (all_warmup_complete > NUM_CPUS)
+                        {
+                            output_statistics.unexpandable_since_start_address++;
+                        }
                         return true;
 #endif  // FLEXIBLE_DATA_PLACEMENT
                     }
@@ -360,14 +385,20 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
                                     {
                                         // no enough free space for data migration. Data eviction is necessary.
                                         cold_data_eviction(address, queue_busy_degree);
-                                        output_statistics.no_free_space_for_migration++;
+                                        if (all_warmup_complete > NUM_CPUS)
+                                        {
+                                            output_statistics.no_free_space_for_migration++;
+                                        }
                                         return true;
                                     }
 
 #else
                                     // no enough free space for data migration. Data eviction is necessary.
                                     cold_data_eviction(address, queue_busy_degree);
-                                    output_statistics.no_free_space_for_migration++;
+                                    if (all_warmup_complete > NUM_CPUS)
+                                    {
+                                        output_statistics.no_free_space_for_migration++;
+                                    }
                                     return true;
 #endif  // FLEXIBLE_GRANULARITY
                                 }
@@ -407,11 +438,14 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
             if (migration_granularity <= free_space)
             {
                 // check whether there have enough invalid groups in placement table entry for new migration
-                if (placement_table.at(placement_table_index).cursor == NUMBER_OF_BLOCK)
+                if (placement_table.at(placement_table_index).cursor == VG_NUMBER_OF_BLOCK)
                 {
                     // no enough invalid groups for data migration. Data eviction is necessary.
                     cold_data_eviction(address, queue_busy_degree);
-                    output_statistics.no_invalid_group_for_migration++;
+                    if (all_warmup_complete > NUM_CPUS)
+                    {
+                        output_statistics.no_invalid_group_for_migration++;
+                    }
                     return true;
                 }
             }
@@ -422,11 +456,14 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
                 {
                     // free_space is not empty
                     // check whether there have enough invalid groups in placement table entry for new migration
-                    if (placement_table.at(placement_table_index).cursor == NUMBER_OF_BLOCK)
+                    if (placement_table.at(placement_table_index).cursor == VG_NUMBER_OF_BLOCK)
                     {
                         // no enough invalid groups for data migration. Data eviction is necessary.
                         cold_data_eviction(address, queue_busy_degree);
-                        output_statistics.no_invalid_group_for_migration++;
+                        if (all_warmup_complete > NUM_CPUS)
+                        {
+                            output_statistics.no_invalid_group_for_migration++;
+                        }
                         return true;
                     }
                     migration_granularity = free_space;
@@ -435,13 +472,19 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
                 {
                     // no enough free space for data migration. Data eviction is necessary.
                     cold_data_eviction(address, queue_busy_degree);
-                    output_statistics.no_free_space_for_migration++;
+                    if (all_warmup_complete > NUM_CPUS)
+                    {
+                        output_statistics.no_free_space_for_migration++;
+                    }
                     return true;
                 }
 #else
                 // no enough free space for data migration. Data eviction is necessary.
                 cold_data_eviction(address, queue_busy_degree);
-                output_statistics.no_free_space_for_migration++;
+                if (all_warmup_complete > NUM_CPUS)
+                {
+                    output_statistics.no_free_space_for_migration++;
+                }
                 return true;
 #endif  // FLEXIBLE_GRANULARITY
             }
@@ -572,13 +615,13 @@ bool OS_TRANSPARENT_MANAGEMENT::memory_activity_tracking(uint64_t address, uint8
     return true;
 };
 
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(PACKET& packet)
+void VARIABLE_GRANULARITY::physical_to_hardware_address(PACKET& packet)
 {
-    uint64_t data_block_address = packet.address >> DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t data_block_address = packet.address >> VG_DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t placement_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;
-    uint64_t base_remapping_address = placement_table_index << DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t base_remapping_address = placement_table_index << VG_DATA_MANAGEMENT_OFFSET_BITS;
     REMAPPING_LOCATION_WIDTH tag = static_cast<REMAPPING_LOCATION_WIDTH>(data_block_address / fast_memory_capacity_at_data_block_granularity);
-    uint64_t first_address = data_block_address << DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t first_address = data_block_address << VG_DATA_MANAGEMENT_OFFSET_BITS;
     START_ADDRESS_WIDTH data_line_positon = START_ADDRESS_WIDTH((packet.address >> DATA_LINE_OFFSET_BITS) - (first_address >> DATA_LINE_OFFSET_BITS));
 
     if (tag != REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero))
@@ -676,13 +719,13 @@ void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(PACKET& packet)
     }
 };
 
-void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
+void VARIABLE_GRANULARITY::physical_to_hardware_address(uint64_t& address)
 {
-    uint64_t data_block_address = address >> DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t data_block_address = address >> VG_DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t placement_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;
-    uint64_t base_remapping_address = placement_table_index << DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t base_remapping_address = placement_table_index << VG_DATA_MANAGEMENT_OFFSET_BITS;
     REMAPPING_LOCATION_WIDTH tag = static_cast<REMAPPING_LOCATION_WIDTH>(data_block_address / fast_memory_capacity_at_data_block_granularity);
-    uint64_t first_address = data_block_address << DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t first_address = data_block_address << VG_DATA_MANAGEMENT_OFFSET_BITS;
     START_ADDRESS_WIDTH data_line_positon = START_ADDRESS_WIDTH((address >> DATA_LINE_OFFSET_BITS) - (first_address >> DATA_LINE_OFFSET_BITS));
 
     if (tag != REMAPPING_LOCATION_WIDTH(RemappingLocation::Zero))
@@ -780,7 +823,7 @@ void OS_TRANSPARENT_MANAGEMENT::physical_to_hardware_address(uint64_t& address)
     }
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapping_request)
+bool VARIABLE_GRANULARITY::issue_remapping_request(RemappingRequest& remapping_request)
 {
     if (remapping_request_queue.empty() == false)
     {
@@ -791,15 +834,15 @@ bool OS_TRANSPARENT_MANAGEMENT::issue_remapping_request(RemappingRequest& remapp
     return false;
 };
 
-bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
+bool VARIABLE_GRANULARITY::finish_remapping_request()
 {
     if (remapping_request_queue.empty() == false)
     {
         RemappingRequest remapping_request = remapping_request_queue.front();
         remapping_request_queue.pop_front();
 
-        uint64_t data_block_address = remapping_request.address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
-        //data_block_address = remapping_request.address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS;
+        uint64_t data_block_address = remapping_request.address_in_fm >> VG_DATA_MANAGEMENT_OFFSET_BITS;
+        //data_block_address = remapping_request.address_in_sm >> VG_DATA_MANAGEMENT_OFFSET_BITS;
         uint64_t placement_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;
 
         // check whether the remapping_request moves block 0's data into fast memory
@@ -807,7 +850,7 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
         {
             // this remapping_request moves block 0's data into slow memory
 
-            data_block_address = remapping_request.address_in_sm >> DATA_MANAGEMENT_OFFSET_BITS;
+            data_block_address = remapping_request.address_in_sm >> VG_DATA_MANAGEMENT_OFFSET_BITS;
             REMAPPING_LOCATION_WIDTH tag = remapping_request.sm_location;
             START_ADDRESS_WIDTH start_address = (remapping_request.address_in_sm >> DATA_LINE_OFFSET_BITS) % (START_ADDRESS_WIDTH(StartAddress::Max));
 
@@ -911,7 +954,7 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
                 placement_table.at(placement_table_index).granularity[data_block_position] = remapping_request.size;
 
                 // remember to update the cursor
-                if (placement_table.at(placement_table_index).cursor < NUMBER_OF_BLOCK)
+                if (placement_table.at(placement_table_index).cursor < VG_NUMBER_OF_BLOCK)
                 {
                     placement_table.at(placement_table_index).cursor++;
                 }
@@ -1064,65 +1107,117 @@ bool OS_TRANSPARENT_MANAGEMENT::finish_remapping_request()
     return true;
 };
 
-void OS_TRANSPARENT_MANAGEMENT::cold_data_detection()
+void VARIABLE_GRANULARITY::cold_data_detection()
 {
     if ((cycle % INTERVAL_FOR_DECREMENT) == 0)
     {
 #if (IMMEDIATE_EVICTION == ENABLE)
 #else
-        // Overhead here is heavy. OpenMP is necessary.
-#if (USE_OPENMP == ENABLE)
-#pragma omp parallel
-        {
-#pragma omp for
-#endif  // USE_OPENMP
-            for (uint64_t i = 0; i < total_capacity_at_data_block_granularity; i++)
-            {
-                counter_table[i] >>= 1; // halve the counter value
-                if (counter_table[i] == 0)
-                {
-                    hotness_table.at(i) = false;    // mark cold data block
-                    for (START_ADDRESS_WIDTH j = START_ADDRESS_WIDTH(StartAddress::Zero); j < START_ADDRESS_WIDTH(StartAddress::Max); j++)
-                    {
-                        // clear accessed data line
-                        access_table.at(i).access[j] = false;
-                    }
-                }
+        // every counter is halved at this interval, but lazily. (see apply_pending_decay())
+        decay_epoch++;
 
 #if (STATISTICS_INFORMATION == ENABLE)
-                // count the estimated spatial locality
-                START_ADDRESS_WIDTH count_access = START_ADDRESS_WIDTH(StartAddress::Zero);
-                for (START_ADDRESS_WIDTH j = START_ADDRESS_WIDTH(StartAddress::Zero); j < START_ADDRESS_WIDTH(StartAddress::Max); j++)
+        // only the data blocks accessed in this interval have temporal_access_stats to count
+        for (uint64_t i : temporal_accessed_blocks)
+        {
+            // count the estimated spatial locality
+            START_ADDRESS_WIDTH count_access = START_ADDRESS_WIDTH(StartAddress::Zero);
+            for (START_ADDRESS_WIDTH j = START_ADDRESS_WIDTH(StartAddress::Zero); j < START_ADDRESS_WIDTH(StartAddress::Max); j++)
+            {
+                if (access_table.at(i).temporal_access_stats[j] == true)
                 {
-                    if (access_table.at(i).temporal_access_stats[j] == true)
-                    {
-                        count_access++;
-                        access_table.at(i).temporal_access_stats[j] = false;    // clear this bit
-                    }
+                    count_access++;
+                    access_table.at(i).temporal_access_stats[j] = false;    // clear this bit
                 }
+            }
 
-                if (access_table.at(i).estimated_spatial_locality_stats < count_access)
-                {
-                    // store the biggest estimated spatial locality
-                    access_table.at(i).estimated_spatial_locality_stats = count_access;
-                }
-#endif  // STATISTICS_INFORMATION
+            if (access_table.at(i).estimated_spatial_locality_stats < count_access)
+            {
+                // store the biggest estimated spatial locality
+                access_table.at(i).estimated_spatial_locality_stats = count_access;
             }
-#if (USE_OPENMP == ENABLE)
+            access_table.at(i).temporal_access_flag = false;
         }
-#endif  // USE_OPENMP
+        temporal_accessed_blocks.clear();
+#endif  // STATISTICS_INFORMATION
 #endif  // IMMEDIATE_EVICTION
     }
 
     cycle++;
 }
 
+#if (SIMULATION_USE_CLOCK_SKIPPING == ENABLE)
+uint64_t VARIABLE_GRANULARITY::idle_cycles()
+{
+    // the counters decay when the cycle reaches a multiple of INTERVAL_FOR_DECREMENT
+    uint64_t remainder = cycle % INTERVAL_FOR_DECREMENT;
+    return (remainder == 0) ? 0 : INTERVAL_FOR_DECREMENT - remainder;
+}
+
+void VARIABLE_GRANULARITY::skip_cycles(uint64_t cycles)
+{
+    cycle += cycles;
+}
+#endif  // SIMULATION_USE_CLOCK_SKIPPING
+
+#if (SIMULATION_USE_CHECKPOINT == ENABLE)
+void VARIABLE_GRANULARITY::checkpoint(CHECKPOINT& checkpoint)
+{
+    checkpoint.section("VARIABLE_GRANULARITY");
+    checkpoint.check("total capacity", total_capacity);
+    checkpoint.check("fast memory capacity", fast_memory_capacity);
+    checkpoint.check("data management granularity", VG_DATA_MANAGEMENT_GRANULARITY);
+    checkpoint.check("statistics information", STATISTICS_INFORMATION);
+
+    checkpoint.transfer(cycle);
+    checkpoint.transfer(counter_table);
+    checkpoint.transfer(hotness_table);
+    checkpoint.transfer(decay_epoch);
+    checkpoint.transfer(epoch_table);
+    checkpoint.transfer(access_table);
+#if (STATISTICS_INFORMATION == ENABLE)
+    checkpoint.transfer(temporal_accessed_blocks);
+#endif  // STATISTICS_INFORMATION
+    checkpoint.transfer(placement_table);
+}
+#endif  // SIMULATION_USE_CHECKPOINT
+
+void VARIABLE_GRANULARITY::apply_pending_decay(uint64_t data_block_address)
+{
+    uint32_t pending_halvings = decay_epoch - epoch_table.at(data_block_address);
+    if (pending_halvings == 0)
+    {
+        return;
+    }
+    epoch_table[data_block_address] = decay_epoch;
+
+    // halving the counter n times equals shifting it by n bits, and once it reaches zero, later halvings only clear it again.
+    if (pending_halvings >= sizeof(COUNTER_WIDTH) * 8)
+    {
+        counter_table[data_block_address] = 0;
+    }
+    else
+    {
+        counter_table[data_block_address] >>= pending_halvings; // halve the counter value
+    }
+
+    if (counter_table[data_block_address] == 0)
+    {
+        hotness_table.at(data_block_address) = false;    // mark cold data block
+        for (START_ADDRESS_WIDTH j = START_ADDRESS_WIDTH(StartAddress::Zero); j < START_ADDRESS_WIDTH(StartAddress::Max); j++)
+        {
+            // clear accessed data line
+            access_table.at(data_block_address).access[j] = false;
+        }
+    }
+}
+
 #if (COLD_DATA_DETECTION_IN_GROUP == ENABLE)
-void OS_TRANSPARENT_MANAGEMENT::cold_data_detection_in_group(uint64_t source_address)
+void VARIABLE_GRANULARITY::cold_data_detection_in_group(uint64_t source_address)
 {
-    uint64_t data_block_address = source_address >> DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
+    uint64_t data_block_address = source_address >> VG_DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
     uint64_t placement_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;   // calculate the index in placement table
-    uint64_t base_remapping_address = placement_table_index << DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t base_remapping_address = placement_table_index << VG_DATA_MANAGEMENT_OFFSET_BITS;
     REMAPPING_LOCATION_WIDTH tag = static_cast<REMAPPING_LOCATION_WIDTH>(data_block_address / fast_memory_capacity_at_data_block_granularity); // calculate the tag of the data block address
 
     for (REMAPPING_LOCATION_WIDTH i = 0; i < expected_number_in_congruence_group; i++)
@@ -1131,8 +1226,9 @@ void OS_TRANSPARENT_MANAGEMENT::cold_data_detection_in_group(uint64_t source_add
         {
             REMAPPING_LOCATION_WIDTH location = i;
             uint64_t data_base_address_to_evict = replace_bits(base_remapping_address, uint64_t(location) << fast_memory_offset_bit, set_msb, fast_memory_offset_bit);
-            uint64_t data_block_address_to_evict = data_base_address_to_evict >> DATA_MANAGEMENT_OFFSET_BITS;
+            uint64_t data_block_address_to_evict = data_base_address_to_evict >> VG_DATA_MANAGEMENT_OFFSET_BITS;
 
+            apply_pending_decay(data_block_address_to_evict);
             counter_table[data_block_address_to_evict] >>= 1; // halve the counter value
             if (counter_table[data_block_address_to_evict] == 0)
             {
@@ -1148,14 +1244,14 @@ void OS_TRANSPARENT_MANAGEMENT::cold_data_detection_in_group(uint64_t source_add
 }
 #endif  // COLD_DATA_DETECTION_IN_GROUP
 
-bool OS_TRANSPARENT_MANAGEMENT::cold_data_eviction(uint64_t source_address, float queue_busy_degree)
+bool VARIABLE_GRANULARITY::cold_data_eviction(uint64_t source_address, float queue_busy_degree)
 {
 #if (DATA_EVICTION == ENABLE)
-    uint64_t data_block_address = source_address >> DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
+    uint64_t data_block_address = source_address >> VG_DATA_MANAGEMENT_OFFSET_BITS;   // calculate the data block address
     uint64_t placement_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;   // calculate the index in placement table
-    uint64_t base_remapping_address = placement_table_index << DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t base_remapping_address = placement_table_index << VG_DATA_MANAGEMENT_OFFSET_BITS;
     REMAPPING_LOCATION_WIDTH tag = static_cast<REMAPPING_LOCATION_WIDTH>(data_block_address / fast_memory_capacity_at_data_block_granularity); // calculate the tag of the data block address
-    //uint64_t first_address = data_block_address << DATA_MANAGEMENT_OFFSET_BITS;
+    //uint64_t first_address = data_block_address << VG_DATA_MANAGEMENT_OFFSET_BITS;
     //START_ADDRESS_WIDTH data_line_positon = START_ADDRESS_WIDTH((source_address >> DATA_LINE_OFFSET_BITS) - (first_address >> DATA_LINE_OFFSET_BITS));
 
     // find cold data block and it belongs to slow memory in placement table entry
@@ -1182,7 +1278,7 @@ bool OS_TRANSPARENT_MANAGEMENT::cold_data_eviction(uint64_t source_address, floa
 #if (IMMEDIATE_EVICTION == ENABLE)
             REMAPPING_LOCATION_WIDTH sm_location = placement_table.at(placement_table_index).tag[i];
             uint64_t data_base_address_to_evict = replace_bits(base_remapping_address, uint64_t(sm_location) << fast_memory_offset_bit, set_msb, fast_memory_offset_bit);
-            uint64_t data_block_address_to_evict = data_base_address_to_evict >> DATA_MANAGEMENT_OFFSET_BITS;
+            uint64_t data_block_address_to_evict = data_base_address_to_evict >> VG_DATA_MANAGEMENT_OFFSET_BITS;
             for (START_ADDRESS_WIDTH j = 0; j < START_ADDRESS_WIDTH(StartAddress::Max); j++)
             {
                 // clear accessed data line
@@ -1197,8 +1293,9 @@ bool OS_TRANSPARENT_MANAGEMENT::cold_data_eviction(uint64_t source_address, floa
             // check whether this data block is cold
             REMAPPING_LOCATION_WIDTH sm_location = placement_table.at(placement_table_index).tag[i];
             uint64_t data_base_address_to_evict = replace_bits(base_remapping_address, uint64_t(sm_location) << fast_memory_offset_bit, set_msb, fast_memory_offset_bit);
-            uint64_t data_block_address_to_evict = data_base_address_to_evict >> DATA_MANAGEMENT_OFFSET_BITS;
+            uint64_t data_block_address_to_evict = data_base_address_to_evict >> VG_DATA_MANAGEMENT_OFFSET_BITS;
 
+            apply_pending_decay(data_block_address_to_evict);
             if (hotness_table.at(data_block_address_to_evict) == false) // this data block is cold
             {
                 is_cold = true;
@@ -1245,12 +1342,18 @@ bool OS_TRANSPARENT_MANAGEMENT::cold_data_eviction(uint64_t source_address, floa
                 if (enqueue)
                 {
                     // new eviction request is issued.
-                    output_statistics.data_eviction_success++;
+                    if (all_warmup_complete > NUM_CPUS)
+                    {
+                        output_statistics.data_eviction_success++;
+                    }
                 }
                 else
                 {
                     // no eviction request is issued.
-                    output_statistics.data_eviction_failure++;
+                    if (all_warmup_complete > NUM_CPUS)
+                    {
+                        output_statistics.data_eviction_failure++;
+                    }
                 }
             }
 
@@ -1263,9 +1366,9 @@ bool OS_TRANSPARENT_MANAGEMENT::cold_data_eviction(uint64_t source_address, floa
     return true;
 }
 
-bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& remapping_request)
+bool VARIABLE_GRANULARITY::enqueue_remapping_request(RemappingRequest& remapping_request)
 {
-    uint64_t data_block_address = remapping_request.address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
+    uint64_t data_block_address = remapping_request.address_in_fm >> VG_DATA_MANAGEMENT_OFFSET_BITS;
     uint64_t placement_table_index = data_block_address % fast_memory_capacity_at_data_block_granularity;
 
     // check duplicated remapping request in remapping_request_queue
@@ -1273,7 +1376,7 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
     bool duplicated_remapping_request = false;
     for (uint64_t i = 0; i < remapping_request_queue.size(); i++)
     {
-        uint64_t data_block_address_to_check = remapping_request_queue[i].address_in_fm >> DATA_MANAGEMENT_OFFSET_BITS;
+        uint64_t data_block_address_to_check = remapping_request_queue[i].address_in_fm >> VG_DATA_MANAGEMENT_OFFSET_BITS;
         uint64_t placement_table_index_to_check = data_block_address_to_check % fast_memory_capacity_at_data_block_granularity;
 
         if (placement_table_index_to_check == placement_table_index)
@@ -1322,7 +1425,7 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
     // add new remapping request to queue
     if (duplicated_remapping_request == false)
     {
-        if (remapping_request_queue.size() < REMAPPING_REQUEST_QUEUE_LENGTH)
+        if (remapping_request_queue.size() < VG_REMAPPING_REQUEST_QUEUE_LENGTH)
         {
             if (remapping_request.address_in_fm == remapping_request.address_in_sm)    // check
             {
@@ -1335,7 +1438,10 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
         }
         else
         {
-            remapping_request_queue_congestion++;
+            if (all_warmup_complete > NUM_CPUS)
+            {
+                remapping_request_queue_congestion++;
+            }
         }
     }
     else
@@ -1346,7 +1452,7 @@ bool OS_TRANSPARENT_MANAGEMENT::enqueue_remapping_request(RemappingRequest& rema
     return true;
 }
 
-MIGRATION_GRANULARITY_WIDTH OS_TRANSPARENT_MANAGEMENT::calculate_migration_granularity(const START_ADDRESS_WIDTH start_address, const START_ADDRESS_WIDTH end_address)
+MIGRATION_GRANULARITY_WIDTH VARIABLE_GRANULARITY::calculate_migration_granularity(const START_ADDRESS_WIDTH start_address, const START_ADDRESS_WIDTH end_address)
 {
     // check
     if (start_address > end_address)
@@ -1395,7 +1501,7 @@ MIGRATION_GRANULARITY_WIDTH OS_TRANSPARENT_MANAGEMENT::calculate_migration_granu
     return migration_granularity;
 }
 
-START_ADDRESS_WIDTH OS_TRANSPARENT_MANAGEMENT::adjust_migration_granularity(const START_ADDRESS_WIDTH start_address, const START_ADDRESS_WIDTH end_address, MIGRATION_GRANULARITY_WIDTH& migration_granularity)
+START_ADDRESS_WIDTH VARIABLE_GRANULARITY::adjust_migration_granularity(const START_ADDRESS_WIDTH start_address, const START_ADDRESS_WIDTH end_address, MIGRATION_GRANULARITY_WIDTH& migration_granularity)
 {
     START_ADDRESS_WIDTH updated_end_address = end_address;
 
@@ -1449,7 +1555,7 @@ START_ADDRESS_WIDTH OS_TRANSPARENT_MANAGEMENT::adjust_migration_granularity(cons
     return updated_end_address;
 }
 
-START_ADDRESS_WIDTH OS_TRANSPARENT_MANAGEMENT::round_down_migration_granularity(const START_ADDRESS_WIDTH start_address, const START_ADDRESS_WIDTH end_address, MIGRATION_GRANULARITY_WIDTH& migration_granularity)
+START_ADDRESS_WIDTH VARIABLE_GRANULARITY::round_down_migration_granularity(const START_ADDRESS_WIDTH start_address, const START_ADDRESS_WIDTH end_address, MIGRATION_GRANULARITY_WIDTH& migration_granularity)
 {
     START_ADDRESS_WIDTH updated_end_address = end_address;
 
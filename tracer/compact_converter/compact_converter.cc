@@ -0,0 +1,180 @@
+/*
+ * Convert a ChampSim trace in the input_instr format (with routine markers, see tracer/pin/champsim_tracer.cpp)
+ * into the compact trace format described in inc/ChampSim/trace_instruction.h.
+ *
+ * The conversion needs two passes over the input trace: the first pass collects the function names into the
+ * dictionary stored in the header, and the second pass writes the instruction records and routine events.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// input_instr format (must match inc/ChampSim/trace_instruction.h)
+#define NUM_INSTR_DESTINATIONS 2
+#define NUM_INSTR_SOURCES 4
+
+struct input_instr {
+    unsigned long long ip;  // instruction pointer (program counter) value
+
+    unsigned char is_branch;    // is this branch
+    unsigned char branch_taken; // if so, is this taken
+
+    unsigned char destination_registers[NUM_INSTR_DESTINATIONS]; // output registers
+    unsigned char source_registers[NUM_INSTR_SOURCES];     // input registers
+
+    unsigned long long destination_memory[NUM_INSTR_DESTINATIONS]; // output memory
+    unsigned long long source_memory[NUM_INSTR_SOURCES];       // input memory
+
+    unsigned char is_rtn_start;
+    unsigned char is_rtn_end;
+    char function_name[256];
+};
+
+// compact trace format (must match inc/ChampSim/trace_instruction.h)
+const char COMPACT_TRACE_MAGIC[8] = {'C', 'S', 'C', 'T', 'R', 'A', 'C', 'E'};
+const uint32_t COMPACT_TRACE_VERSION = 1;
+
+struct compact_trace_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t dictionary_size;
+};
+
+enum compact_record_type : unsigned char {
+    COMPACT_RECORD_INSTRUCTION = 0,
+    COMPACT_RECORD_ROUTINE_START,
+    COMPACT_RECORD_ROUTINE_END
+};
+
+struct compact_instr {
+    unsigned long long ip;
+
+    unsigned char is_branch;
+    unsigned char branch_taken;
+
+    unsigned char destination_registers[NUM_INSTR_DESTINATIONS];
+    unsigned char source_registers[NUM_INSTR_SOURCES];
+
+    unsigned long long destination_memory[NUM_INSTR_DESTINATIONS];
+    unsigned long long source_memory[NUM_INSTR_SOURCES];
+};
+
+struct compact_routine_event {
+    uint32_t function_id;
+};
+
+FILE* open_trace(const char* trace_name)
+{
+    const char* decomp_program = NULL;
+    const char* last_dot = strrchr(trace_name, '.');
+
+    if (last_dot != NULL && last_dot[1] == 'g') // gzip format
+        decomp_program = "gzip";
+    else if (last_dot != NULL && last_dot[1] == 'x') // xz
+        decomp_program = "xz";
+    else {
+        fprintf(stderr, "Only gz or xz compressed traces are supported: %s\n", trace_name);
+        exit(1);
+    }
+
+    char command[4096];
+    snprintf(command, sizeof(command), "%s -dc %s", decomp_program, trace_name);
+    FILE* trace_file = popen(command, "r");
+    if (trace_file == NULL) {
+        fprintf(stderr, "Cannot open trace file: %s\n", trace_name);
+        exit(1);
+    }
+    return trace_file;
+}
+
+string get_function_name(const input_instr& instr)
+{
+    // the tracer does not guarantee the termination of over-long names
+    return string(instr.function_name, strnlen(instr.function_name, sizeof(instr.function_name)));
+}
+
+void write_routine_event(compact_record_type record_type, uint32_t function_id)
+{
+    compact_routine_event routine_event;
+    routine_event.function_id = function_id;
+    fwrite(&record_type, sizeof(record_type), 1, stdout);
+    fwrite(&routine_event, sizeof(routine_event), 1, stdout);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s TRACE_NAME.xz > NEW_TRACE.champsimtrace\n", argv[0]);
+        return 1;
+    }
+
+    input_instr instr;
+
+    /* first pass: build the function-name dictionary */
+    map<string, uint32_t> function_ids;
+    vector<string> function_dictionary;
+    FILE* trace_file = open_trace(argv[1]);
+    while (fread(&instr, sizeof(input_instr), 1, trace_file)) {
+        if (instr.is_rtn_start || instr.is_rtn_end) {
+            string function_name = get_function_name(instr);
+            if (function_ids.count(function_name) == 0) {
+                function_ids[function_name] = function_dictionary.size();
+                function_dictionary.push_back(function_name);
+            }
+        }
+    }
+    pclose(trace_file);
+
+    /* write the header and the dictionary */
+    compact_trace_header header;
+    memcpy(header.magic, COMPACT_TRACE_MAGIC, sizeof(header.magic));
+    header.version = COMPACT_TRACE_VERSION;
+    header.dictionary_size = function_dictionary.size();
+    fwrite(&header, sizeof(header), 1, stdout);
+    for (const string& function_name : function_dictionary) {
+        uint16_t length = function_name.size();
+        fwrite(&length, sizeof(length), 1, stdout);
+        fwrite(function_name.data(), length, 1, stdout);
+    }
+
+    /* second pass: write the records */
+    uint64_t instr_count = 0, event_count = 0;
+    trace_file = open_trace(argv[1]);
+    while (fread(&instr, sizeof(input_instr), 1, trace_file)) {
+        if (instr.is_rtn_start) {
+            write_routine_event(COMPACT_RECORD_ROUTINE_START, function_ids[get_function_name(instr)]);
+            event_count++;
+        }
+        if (instr.is_rtn_end) {
+            write_routine_event(COMPACT_RECORD_ROUTINE_END, function_ids[get_function_name(instr)]);
+            event_count++;
+        }
+
+        compact_instr record;
+        record.ip = instr.ip;
+        record.is_branch = instr.is_branch;
+        record.branch_taken = instr.branch_taken;
+        memcpy(record.destination_registers, instr.destination_registers, sizeof(record.destination_registers));
+        memcpy(record.source_registers, instr.source_registers, sizeof(record.source_registers));
+        memcpy(record.destination_memory, instr.destination_memory, sizeof(record.destination_memory));
+        memcpy(record.source_memory, instr.source_memory, sizeof(record.source_memory));
+
+        compact_record_type record_type = COMPACT_RECORD_INSTRUCTION;
+        fwrite(&record_type, sizeof(record_type), 1, stdout);
+        fwrite(&record, sizeof(record), 1, stdout);
+        instr_count++;
+    }
+    pclose(trace_file);
+
+    fprintf(stderr, "Converted %llu instructions, %llu routine events, %zu function names\n",
+            (unsigned long long)instr_count, (unsigned long long)event_count, function_dictionary.size());
+    return 0;
+}